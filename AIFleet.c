@@ -0,0 +1,470 @@
+// AIFleet.c
+#include "AIFleet.h"
+#include "RenderPacket.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AI_FLOAT_FIELDS 22      // Float arrays in AIFleet, see GetFloatFields
+
+// Shared by every batch of one update
+typedef struct AIUpdateTask {
+    AIFleet *fleet;
+    Vector3 center;             // Patrol centre
+    Vector3 target;             // What the aircraft fire at
+    float frameTime;
+} AIUpdateTask;
+
+// Visible aircraft and bullets of one culling job, in its worker's frame arena
+typedef struct AICullRange {
+    struct AICullRange *next;   // Earlier range of the same worker
+    int planeCount;
+    int bulletCount;
+    int indices[];              // planeCount aircraft, then bulletCount bullets
+} AICullRange;
+
+// Shared by every batch of one cull, each worker only links into its own list
+typedef struct AICullTask {
+    const AIFleet *fleet;
+    Vector4 planes[6];
+    AICullRange *ranges[JOB_MAX_WORKERS];
+} AICullTask;
+
+static void UpdateAircraft(void *data, int begin, int end);
+static void RebuildMatrices(void *data, int begin, int end);
+static void CullAircraft(void *data, int begin, int end);
+static bool IsAircraftNear(const AIFleet *fleet, Vector3 cameraPosition, int index);
+static void DrawAircraft(const AIFleet *fleet, Model model, int index);
+static void DrawAircraftImpostor(const AIFleet *fleet, ImpostorAtlas *impostors, int impostor, int index);
+static void DrawAIBullet(const AIFleet *fleet, int index);
+static void SetAttitude(AIFleet *fleet, int index);
+static void SpawnAircraft(AIFleet *fleet, int index, Vector3 center);
+static void PickWaypoint(AIFleet *fleet, int index, Vector3 center);
+static float GetGroundHeight(const AIFleet *fleet, float x, float z);
+static float RandomFloat(uint32_t *state);
+static void GetFloatFields(AIFleet *fleet, float ***fields);
+
+void InitAIFleet(AIFleet *fleet, JobSystem *jobs, AIGroundFunction groundHeight, const void *ground) {
+    memset(fleet, 0, sizeof(AIFleet));
+    fleet->jobs = jobs;
+    fleet->groundHeight = groundHeight;
+    fleet->ground = ground;
+}
+
+void SetAIFleetCount(AIFleet *fleet, int count, Vector3 center) {
+    if (count < 0) count = 0;
+
+    if (count > fleet->capacity) {
+        int capacity = fleet->capacity > 0 ? fleet->capacity : 256;
+        while (capacity < count) capacity *= 2;
+
+        float **fields[AI_FLOAT_FIELDS];
+        GetFloatFields(fleet, fields);
+        for (int i = 0; i < AI_FLOAT_FIELDS; i++) {
+            float *grown = (float *)realloc(*fields[i], capacity * sizeof(float));
+            if (!grown) return;
+            *fields[i] = grown;
+        }
+        uint32_t *random = (uint32_t *)realloc(fleet->random, capacity * sizeof(uint32_t));
+        if (!random) return;
+        fleet->random = random;
+        unsigned char *dirty = (unsigned char *)realloc(fleet->dirty, capacity);
+        if (!dirty) return;
+        fleet->dirty = dirty;
+        Matrix *transforms = (Matrix *)realloc(fleet->transforms, capacity * sizeof(Matrix));
+        if (!transforms) return;
+        fleet->transforms = transforms;
+        fleet->capacity = capacity;
+    }
+
+    for (int i = fleet->count; i < count; i++) SpawnAircraft(fleet, i, center);
+    fleet->count = count;
+}
+
+void UpdateAIFleet(AIFleet *fleet, Vector3 center, Vector3 target, float frameTime) {
+    double start = GetTime();
+
+    AIUpdateTask task = { fleet, center, target, frameTime };
+    fleet->activeBullets = 0;
+    ParallelFor(fleet->jobs, fleet->count, AI_FLEET_GRAIN, UpdateAircraft, &task);
+
+    // Only aircraft that turned, pitched or respawned get a new matrix
+    double matrixStart = GetTime();
+    fleet->matricesRebuilt = 0;
+    ParallelFor(fleet->jobs, fleet->count, AI_FLEET_GRAIN, RebuildMatrices, fleet);
+
+    double end = GetTime();
+    fleet->matrixTime = end - matrixStart;
+    fleet->updateTime = end - start;
+}
+
+int HitAIFleet(AIFleet *fleet, Vector3 position, float radius) {
+    float radiusSquared = radius * radius;
+
+    for (int i = 0; i < fleet->count; i++) {
+        float dx = fleet->positionX[i] - position.x;
+        float dy = fleet->positionY[i] - position.y;
+        float dz = fleet->positionZ[i] - position.z;
+        if (dx * dx + dy * dy + dz * dz > radiusSquared) continue;
+
+        // A downed aircraft comes back on the far side of its patrol area
+        Vector3 center = { position.x, 0.0f, position.z };
+        SpawnAircraft(fleet, i, center);
+        return i;
+    }
+
+    return -1;
+}
+
+void ShiftAIFleet(AIFleet *fleet, Vector3 shift) {
+    for (int i = 0; i < fleet->count; i++) {
+        fleet->positionX[i] -= shift.x;
+        fleet->positionY[i] -= shift.y;
+        fleet->positionZ[i] -= shift.z;
+        fleet->waypointX[i] -= shift.x;
+        fleet->waypointZ[i] -= shift.z;
+        fleet->bulletX[i] -= shift.x;
+        fleet->bulletY[i] -= shift.y;
+        fleet->bulletZ[i] -= shift.z;
+    }
+}
+
+void DrawAIFleet(const AIFleet *fleet, Model model, ImpostorAtlas *impostors, int impostor, Camera camera) {
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, (double)GetScreenWidth() / GetScreenHeight(), RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    AICullTask task = { 0 };
+    task.fleet = fleet;
+    GetFrustumPlanes(MatrixMultiply(view, projection), task.planes);
+
+    // Near aircraft and bullets first, then every far aircraft in one impostor batch
+    if (!fleet->jobs) {
+        for (int i = 0; i < fleet->count; i++) {
+            Vector3 position = { fleet->positionX[i], fleet->positionY[i], fleet->positionZ[i] };
+            if (IsAircraftNear(fleet, camera.position, i) && IsSphereInFrustum(task.planes, position, AI_HIT_RADIUS * 2.0f)) DrawAircraft(fleet, model, i);
+
+            position = (Vector3){ fleet->bulletX[i], fleet->bulletY[i], fleet->bulletZ[i] };
+            if (fleet->bulletLife[i] > 0.0f && IsSphereInFrustum(task.planes, position, 4.0f)) DrawAIBullet(fleet, i);
+        }
+
+        BeginImpostors(impostors, camera.position, RED);
+        for (int i = 0; i < fleet->count; i++) {
+            Vector3 position = { fleet->positionX[i], fleet->positionY[i], fleet->positionZ[i] };
+            if (!IsAircraftNear(fleet, camera.position, i) && IsSphereInFrustum(task.planes, position, AI_HIT_RADIUS * 2.0f)) DrawAircraftImpostor(fleet, impostors, impostor, i);
+        }
+        EndImpostors(impostors);
+        return;
+    }
+
+    // Workers test the spheres, only the draw calls stay on the GL thread
+    ParallelFor(fleet->jobs, fleet->count, AI_CULL_GRAIN, CullAircraft, &task);
+
+    for (int w = 0; w < JOB_MAX_WORKERS; w++) {
+        for (const AICullRange *range = task.ranges[w]; range; range = range->next) {
+            for (int i = 0; i < range->planeCount; i++) {
+                if (IsAircraftNear(fleet, camera.position, range->indices[i])) DrawAircraft(fleet, model, range->indices[i]);
+            }
+            for (int i = 0; i < range->bulletCount; i++) DrawAIBullet(fleet, range->indices[range->planeCount + i]);
+        }
+    }
+
+    BeginImpostors(impostors, camera.position, RED);
+    for (int w = 0; w < JOB_MAX_WORKERS; w++) {
+        for (const AICullRange *range = task.ranges[w]; range; range = range->next) {
+            for (int i = 0; i < range->planeCount; i++) {
+                if (!IsAircraftNear(fleet, camera.position, range->indices[i])) DrawAircraftImpostor(fleet, impostors, impostor, range->indices[i]);
+            }
+        }
+    }
+    EndImpostors(impostors);
+}
+
+void UnloadAIFleet(AIFleet *fleet) {
+    float **fields[AI_FLOAT_FIELDS];
+    GetFloatFields(fleet, fields);
+    for (int i = 0; i < AI_FLOAT_FIELDS; i++) free(*fields[i]);
+    free(fleet->random);
+    free(fleet->dirty);
+    free(fleet->transforms);
+
+    memset(fleet, 0, sizeof(AIFleet));
+}
+
+// Runs on workers: touches only aircraft [begin, end), their bullets, and the counters atomically
+static void UpdateAircraft(void *data, int begin, int end) {
+    const AIUpdateTask *task = (const AIUpdateTask *)data;
+    AIFleet *fleet = task->fleet;
+    float dt = task->frameTime;
+    float waypointRadiusSquared = AI_WAYPOINT_RADIUS * AI_WAYPOINT_RADIUS;
+    float fireRangeSquared = AI_FIRE_RANGE * AI_FIRE_RANGE;
+    float hitRadiusSquared = AI_HIT_RADIUS * AI_HIT_RADIUS;
+    int hits = 0;
+    int shots = 0;
+    int activeBullets = 0;
+
+    for (int i = begin; i < end; i++) {
+        float x = fleet->positionX[i];
+        float y = fleet->positionY[i];
+        float z = fleet->positionZ[i];
+
+        // Steer towards the waypoint at a limited turn rate
+        float toWaypointX = fleet->waypointX[i] - x;
+        float toWaypointZ = fleet->waypointZ[i] - z;
+        if (toWaypointX * toWaypointX + toWaypointZ * toWaypointZ < waypointRadiusSquared) {
+            PickWaypoint(fleet, i, task->center);
+            toWaypointX = fleet->waypointX[i] - x;
+            toWaypointZ = fleet->waypointZ[i] - z;
+        }
+
+        // The half-angle yaw is the only record of the heading: forward is its double angle,
+        // and the signed angle to the waypoint comes from cross and dot products, no trig at all
+        float yawSin = fleet->yawSin[i];
+        float yawCos = fleet->yawCos[i];
+        float forwardX = 2.0f * yawSin * yawCos;
+        float forwardZ = yawCos * yawCos - yawSin * yawSin;
+        float toWaypointLength = sqrtf(toWaypointX * toWaypointX + toWaypointZ * toWaypointZ);
+        float maxTurn = AI_TURN_RATE * dt;
+        float turnSin = toWaypointLength > 0.0f ? (toWaypointX * forwardZ - toWaypointZ * forwardX) / toWaypointLength : 0.0f;
+        float turn;
+        if (toWaypointX * forwardX + toWaypointZ * forwardZ < 0.0f) turn = turnSin < 0.0f ? -maxTurn : maxTurn;   // Behind, turn as hard as possible
+        else if (fabsf(turnSin) < AI_HEADING_TOLERANCE) turn = 0.0f;
+        else turn = Clamp(turnSin, -maxTurn, maxTurn);      // Sine for angle, 30 ppm off once inside one step's turn
+
+        // Turn the half-angle yaw by turn / 2 with short series, no trig for a few thousandths of a radian
+        if (turn != 0.0f) {
+            float half = 0.5f * turn;
+            float halfSquared = half * half;
+            float s = half * (1.0f - halfSquared / 6.0f);
+            float c = 1.0f - halfSquared * (0.5f - halfSquared / 24.0f);
+            float turnedSin = yawSin * c + yawCos * s;
+            float turnedCos = yawCos * c - yawSin * s;
+            float inverseLength = 1.0f / sqrtf(turnedSin * turnedSin + turnedCos * turnedCos);
+            yawSin = turnedSin * inverseLength;
+            yawCos = turnedCos * inverseLength;
+            fleet->yawSin[i] = yawSin;
+            fleet->yawCos[i] = yawCos;
+            forwardX = 2.0f * yawSin * yawCos;
+            forwardZ = yawCos * yawCos - yawSin * yawSin;
+        }
+
+        float speed = fleet->speed[i];
+
+        // Hold cruise altitude unless the ground here or ahead needs more clearance
+        float lookahead = speed * AI_LOOKAHEAD;
+        float ground = GetGroundHeight(fleet, x, z);
+        float groundAhead = GetGroundHeight(fleet, x + forwardX * lookahead, z + forwardZ * lookahead);
+        float desiredY = fmaxf(fleet->cruiseAltitude[i], fmaxf(ground, groundAhead) + AI_CLEARANCE);
+        float climbRate = fabsf(desiredY - y) < AI_ALTITUDE_TOLERANCE ? 0.0f : Clamp((desiredY - y) * AI_CLIMB_GAIN, -AI_MAX_CLIMB, AI_MAX_CLIMB);
+        bool attitudeChanged = turn != 0.0f || climbRate != fleet->climbRate[i];
+
+        x += forwardX * speed * dt;
+        z += forwardZ * speed * dt;
+        y = fmaxf(y + climbRate * dt, ground + 2.0f);
+
+        fleet->positionX[i] = x;
+        fleet->positionY[i] = y;
+        fleet->positionZ[i] = z;
+        fleet->climbRate[i] = climbRate;
+        if (attitudeChanged) SetAttitude(fleet, i);
+
+        // Fire at the target when it is in range and roughly ahead, one bullet in flight each
+        fleet->fireCooldown[i] -= dt;
+        float toTargetX = task->target.x - x;
+        float toTargetY = task->target.y - y;
+        float toTargetZ = task->target.z - z;
+        float targetDistanceSquared = toTargetX * toTargetX + toTargetY * toTargetY + toTargetZ * toTargetZ;
+
+        if (fleet->fireCooldown[i] <= 0.0f && fleet->bulletLife[i] <= 0.0f && targetDistanceSquared < fireRangeSquared && targetDistanceSquared > 0.0f) {
+            float targetDistance = sqrtf(targetDistanceSquared);
+            if (toTargetX * forwardX + toTargetZ * forwardZ > AI_FIRE_CONE * targetDistance) {
+                float scale = AI_BULLET_SPEED / targetDistance;
+                fleet->bulletX[i] = x;
+                fleet->bulletY[i] = y;
+                fleet->bulletZ[i] = z;
+                fleet->bulletVelocityX[i] = toTargetX * scale;
+                fleet->bulletVelocityY[i] = toTargetY * scale;
+                fleet->bulletVelocityZ[i] = toTargetZ * scale;
+                fleet->bulletLife[i] = AI_FIRE_RANGE / AI_BULLET_SPEED * 1.5f;
+                fleet->fireCooldown[i] = AI_FIRE_INTERVAL;
+                shots++;
+            }
+        }
+
+        // Move the bullet, it ends on the target or the ground
+        if (fleet->bulletLife[i] > 0.0f) {
+            float bulletX = fleet->bulletX[i] + fleet->bulletVelocityX[i] * dt;
+            float bulletY = fleet->bulletY[i] + fleet->bulletVelocityY[i] * dt;
+            float bulletZ = fleet->bulletZ[i] + fleet->bulletVelocityZ[i] * dt;
+            float life = fleet->bulletLife[i] - dt;
+
+            float dx = bulletX - task->target.x;
+            float dy = bulletY - task->target.y;
+            float dz = bulletZ - task->target.z;
+            if (dx * dx + dy * dy + dz * dz < hitRadiusSquared) {
+                hits++;
+                life = 0.0f;
+            }
+            else if (life > 0.0f && bulletY < GetGroundHeight(fleet, bulletX, bulletZ)) {
+                life = 0.0f;
+            }
+
+            fleet->bulletX[i] = bulletX;
+            fleet->bulletY[i] = bulletY;
+            fleet->bulletZ[i] = bulletZ;
+            fleet->bulletLife[i] = life > 0.0f ? life : 0.0f;
+            activeBullets += life > 0.0f;
+        }
+    }
+
+    __atomic_add_fetch(&fleet->hits, hits, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&fleet->shotsFired, shots, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&fleet->activeBullets, activeBullets, __ATOMIC_RELAXED);
+}
+
+static void SpawnAircraft(AIFleet *fleet, int index, Vector3 center) {
+    uint32_t *random = &fleet->random[index];
+    *random = (uint32_t)index * 2654435761u + 0x9E3779B9u + (uint32_t)fleet->shotsFired;
+    if (*random == 0) *random = 1;
+
+    float angle = RandomFloat(random) * 2.0f * PI;
+    float distance = (0.5f + 0.5f * RandomFloat(random)) * AI_PATROL_RADIUS;
+    float x = center.x + cosf(angle) * distance;
+    float z = center.z + sinf(angle) * distance;
+
+    fleet->cruiseAltitude[index] = AI_CRUISE_MIN + RandomFloat(random) * (AI_CRUISE_MAX - AI_CRUISE_MIN);
+    fleet->positionX[index] = x;
+    fleet->positionY[index] = fmaxf(fleet->cruiseAltitude[index], GetGroundHeight(fleet, x, z) + AI_CLEARANCE);
+    fleet->positionZ[index] = z;
+    float halfHeading = (RandomFloat(random) - 0.5f) * PI;
+    fleet->yawSin[index] = sinf(halfHeading);
+    fleet->yawCos[index] = cosf(halfHeading);
+    fleet->climbRate[index] = 0.0f;
+    fleet->speed[index] = AI_SPEED_MIN + RandomFloat(random) * (AI_SPEED_MAX - AI_SPEED_MIN);
+    fleet->fireCooldown[index] = RandomFloat(random) * AI_FIRE_INTERVAL;
+    fleet->bulletLife[index] = 0.0f;
+    fleet->bulletX[index] = x;
+    fleet->bulletY[index] = fleet->positionY[index];
+    fleet->bulletZ[index] = z;
+    fleet->bulletVelocityX[index] = 0.0f;
+    fleet->bulletVelocityY[index] = 0.0f;
+    fleet->bulletVelocityZ[index] = 0.0f;
+    PickWaypoint(fleet, index, center);
+    SetAttitude(fleet, index);
+}
+
+// Rebuild the quaternion from the half-angle yaw and the flight path pitch, sqrt only
+static void SetAttitude(AIFleet *fleet, int index) {
+    float climb = fleet->climbRate[index];
+    float speed = fleet->speed[index];
+    float cosPitch = speed / sqrtf(speed * speed + climb * climb);
+    float pitchCos = sqrtf(0.5f * (1.0f + cosPitch));
+    float pitchSin = sqrtf(0.5f * (1.0f - cosPitch));
+    if (climb > 0.0f) pitchSin = -pitchSin;             // Nose up is negative about +X
+
+    // Yaw about +Y applied after pitch about +X
+    float yawSin = fleet->yawSin[index];
+    float yawCos = fleet->yawCos[index];
+    fleet->orientationX[index] = yawCos * pitchSin;
+    fleet->orientationY[index] = yawSin * pitchCos;
+    fleet->orientationZ[index] = -yawSin * pitchSin;
+    fleet->orientationW[index] = yawCos * pitchCos;
+    fleet->dirty[index] = 1;
+}
+
+static void RebuildMatrices(void *data, int begin, int end) {
+    AIFleet *fleet = (AIFleet *)data;
+    int rebuilt = 0;
+
+    for (int i = begin; i < end; i++) {
+        if (!fleet->dirty[i]) continue;
+
+        Quaternion q = { fleet->orientationX[i], fleet->orientationY[i], fleet->orientationZ[i], fleet->orientationW[i] };
+        fleet->transforms[i] = QuaternionToMatrix(q);
+        fleet->dirty[i] = 0;
+        rebuilt++;
+    }
+
+    __atomic_add_fetch(&fleet->matricesRebuilt, rebuilt, __ATOMIC_RELAXED);
+}
+
+// Runs on workers: lists the visible aircraft and bullets of [begin, end) in the worker's frame arena
+static void CullAircraft(void *data, int begin, int end) {
+    AICullTask *task = (AICullTask *)data;
+    const AIFleet *fleet = task->fleet;
+    int worker = GetJobWorkerIndex(fleet->jobs);
+
+    // Sized for everything visible, the unused tail goes back with the frame
+    AICullRange *range = (AICullRange *)AllocArena(GetJobArena(fleet->jobs), sizeof(AICullRange) + 2 * (end - begin) * sizeof(int));
+    if (!range) return;
+    range->planeCount = 0;
+    range->bulletCount = 0;
+
+    for (int i = begin; i < end; i++) {
+        Vector3 position = { fleet->positionX[i], fleet->positionY[i], fleet->positionZ[i] };
+        if (IsSphereInFrustum(task->planes, position, AI_HIT_RADIUS * 2.0f)) range->indices[range->planeCount++] = i;
+    }
+    for (int i = begin; i < end; i++) {
+        if (fleet->bulletLife[i] <= 0.0f) continue;
+
+        Vector3 position = { fleet->bulletX[i], fleet->bulletY[i], fleet->bulletZ[i] };
+        if (IsSphereInFrustum(task->planes, position, 4.0f)) range->indices[range->planeCount + range->bulletCount++] = i;
+    }
+
+    range->next = task->ranges[worker];
+    task->ranges[worker] = range;
+}
+
+// Distant aircraft are a few pixels tall, they go to the impostor batch
+static bool IsAircraftNear(const AIFleet *fleet, Vector3 cameraPosition, int index) {
+    Vector3 position = { fleet->positionX[index], fleet->positionY[index], fleet->positionZ[index] };
+    return Vector3DistanceSqr(position, cameraPosition) <= AI_MODEL_DISTANCE * AI_MODEL_DISTANCE;
+}
+
+static void DrawAircraft(const AIFleet *fleet, Model model, int index) {
+    Vector3 position = { fleet->positionX[index], fleet->positionY[index], fleet->positionZ[index] };
+    model.transform = fleet->transforms[index];
+    DrawModel(model, position, 1.0f, RED);
+}
+
+// Between BeginImpostors and EndImpostors, the heading is the double angle of the half-angle yaw
+static void DrawAircraftImpostor(const AIFleet *fleet, ImpostorAtlas *impostors, int impostor, int index) {
+    Vector3 position = { fleet->positionX[index], fleet->positionY[index], fleet->positionZ[index] };
+    DrawImpostor(impostors, impostor, position, 2.0f * atan2f(fleet->yawSin[index], fleet->yawCos[index]), 1.0f);
+}
+
+static void DrawAIBullet(const AIFleet *fleet, int index) {
+    Vector3 position = { fleet->bulletX[index], fleet->bulletY[index], fleet->bulletZ[index] };
+    DrawCube(position, 3.0f, 3.0f, 3.0f, ORANGE);
+}
+
+static void PickWaypoint(AIFleet *fleet, int index, Vector3 center) {
+    uint32_t *random = &fleet->random[index];
+    fleet->waypointX[index] = center.x + (RandomFloat(random) * 2.0f - 1.0f) * AI_PATROL_RADIUS;
+    fleet->waypointZ[index] = center.z + (RandomFloat(random) * 2.0f - 1.0f) * AI_PATROL_RADIUS;
+}
+
+static float GetGroundHeight(const AIFleet *fleet, float x, float z) {
+    return fleet->groundHeight ? fleet->groundHeight(fleet->ground, x, z) : 0.0f;
+}
+
+// xorshift32, state must not be 0
+static float RandomFloat(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+static void GetFloatFields(AIFleet *fleet, float ***fields) {
+    float **all[AI_FLOAT_FIELDS] = {
+        &fleet->positionX, &fleet->positionY, &fleet->positionZ, &fleet->yawSin, &fleet->yawCos,
+        &fleet->orientationX, &fleet->orientationY, &fleet->orientationZ, &fleet->orientationW, &fleet->climbRate,
+        &fleet->speed, &fleet->cruiseAltitude, &fleet->waypointX, &fleet->waypointZ, &fleet->fireCooldown,
+        &fleet->bulletX, &fleet->bulletY, &fleet->bulletZ,
+        &fleet->bulletVelocityX, &fleet->bulletVelocityY, &fleet->bulletVelocityZ, &fleet->bulletLife
+    };
+    memcpy(fields, all, sizeof(all));
+}
@@ -0,0 +1,86 @@
+// AIFleet.h
+#ifndef AIFLEET_H
+#define AIFLEET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "JobSystem.h"
+#include "Terrain/Impostor.h"
+
+#define AI_FLEET_GRAIN          256     // Aircraft per job, at least
+#define AI_CULL_GRAIN           1024    // Aircraft per culling job, at least
+#define AI_PATROL_RADIUS        1500.0f // Waypoints are picked this far around the patrol centre
+#define AI_WAYPOINT_RADIUS      60.0f   // Distance at which a waypoint counts as reached
+#define AI_CRUISE_MIN           60.0f   // Cruise altitude range, terrain may push aircraft higher
+#define AI_CRUISE_MAX           220.0f
+#define AI_SPEED_MIN            40.0f   // Units per second
+#define AI_SPEED_MAX            70.0f
+#define AI_TURN_RATE            0.8f    // Radians per second
+#define AI_CLIMB_GAIN           1.5f    // Climb rate per unit of altitude error
+#define AI_MAX_CLIMB            40.0f   // Units per second, up or down
+#define AI_CLEARANCE            30.0f   // Height kept above the terrain
+#define AI_LOOKAHEAD            1.5f    // Seconds of flight the terrain is probed ahead
+#define AI_FIRE_RANGE           400.0f  // Aircraft fire at the target inside this range
+#define AI_FIRE_CONE            0.9f    // Cosine of the half angle they fire within
+#define AI_FIRE_INTERVAL        2.0f    // Seconds between shots of one aircraft
+#define AI_BULLET_SPEED         200.0f
+#define AI_HIT_RADIUS           10.0f   // Bullet-to-target and bullet-to-aircraft collision radius
+#define AI_HEADING_TOLERANCE    0.001f  // Radians of heading error left alone, so straight flight keeps its matrix
+#define AI_ALTITUDE_TOLERANCE   2.0f    // Altitude error left alone, so level flight keeps its matrix
+#define AI_MODEL_DISTANCE       600.0f  // Nearer aircraft are drawn with the model, farther ones as impostors
+
+// Terrain height at a render-space position, must be safe to call from several workers at once
+typedef float (*AIGroundFunction)(const void *ground, float x, float z);
+
+// AI aircraft stored as one array per field, so batches stream through only what they use.
+// Aircraft i owns bullet i: firing needs no shared pool and batches never write outside their range.
+typedef struct AIFleet {
+    int count;                  // Aircraft simulated
+    int capacity;               // Aircraft allocated
+    float *positionX;
+    float *positionY;
+    float *positionZ;
+    float *yawSin;              // Sine and cosine of half the heading around +Y (0 faces +Z), turned
+    float *yawCos;              // incrementally, the only copy of the heading
+    float *orientationX;        // Unit quaternion of yaw then pitch, rebuilt when the attitude changes
+    float *orientationY;
+    float *orientationZ;
+    float *orientationW;
+    float *climbRate;           // Units per second, drives the drawn pitch
+    float *speed;
+    float *cruiseAltitude;
+    float *waypointX;
+    float *waypointZ;
+    float *fireCooldown;        // Seconds until the next shot
+    uint32_t *random;           // Per-aircraft random state, keeps updates independent of batching
+    unsigned char *dirty;       // Orientation changed since its matrix was built
+    Matrix *transforms;         // World rotation of each aircraft, only rebuilt when dirty
+    float *bulletX;
+    float *bulletY;
+    float *bulletZ;
+    float *bulletVelocityX;
+    float *bulletVelocityY;
+    float *bulletVelocityZ;
+    float *bulletLife;          // Seconds left, 0 when inactive
+    JobSystem *jobs;            // Runs the batches, NULL updates serially
+    AIGroundFunction groundHeight;  // NULL for flat ground at 0
+    const void *ground;
+    int hits;                   // AI bullets that hit the target so far
+    int shotsFired;
+    int activeBullets;          // After the last update
+    double updateTime;          // Seconds the last update took, matrix rebuilds included
+    int matricesRebuilt;        // Dirty matrices rebuilt by the last update
+    double matrixTime;          // Seconds the last update spent rebuilding them
+} AIFleet;
+
+// Function declarations
+void InitAIFleet(AIFleet *fleet, JobSystem *jobs, AIGroundFunction groundHeight, const void *ground);  // Empty fleet, batches run on jobs
+void SetAIFleetCount(AIFleet *fleet, int count, Vector3 center);                    // Grow or shrink the fleet, new aircraft spawn around center
+void UpdateAIFleet(AIFleet *fleet, Vector3 center, Vector3 target, float frameTime);// Fly, avoid terrain, fire at target and move bullets, in parallel batches
+int HitAIFleet(AIFleet *fleet, Vector3 position, float radius);                     // Index of an aircraft within radius (it respawns), or -1
+void ShiftAIFleet(AIFleet *fleet, Vector3 shift);                                   // Subtract an origin shift from every position
+void DrawAIFleet(const AIFleet *fleet, Model model, ImpostorAtlas *impostors, int impostor, Camera camera);  // Draw visible aircraft and bullets, far aircraft as impostor row impostor, inside BeginMode3D
+void UnloadAIFleet(AIFleet *fleet);                                                 // Free the arrays
+
+#endif // AIFLEET_H
@@ -0,0 +1,191 @@
+// Arena.c
+#include "Arena.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void *BumpArena(Arena *arena, size_t size);
+static char *GetArenaTail(const Arena *arena, size_t *space);
+static bool AddArenaBlock(Arena *arena, size_t size);
+static void PoisonArenaBlock(ArenaBlock *block, size_t from);
+
+static inline unsigned char *GetBlockData(ArenaBlock *block) {
+    return (unsigned char *)(block + 1);
+}
+
+// Offset of the next aligned allocation in block
+static inline size_t AlignBlockOffset(ArenaBlock *block) {
+    uintptr_t address = (uintptr_t)(GetBlockData(block) + block->used);
+    uintptr_t aligned = (address + ARENA_ALIGNMENT - 1) & ~(uintptr_t)(ARENA_ALIGNMENT - 1);
+    return block->used + (size_t)(aligned - address);
+}
+
+void InitArena(Arena *arena, size_t blockSize) {
+    memset(arena, 0, sizeof(Arena));
+    arena->blockSize = blockSize;
+}
+
+void *AllocArena(Arena *arena, size_t size) {
+    void *memory;
+
+    // Blocks after the current one are left over from before a ResetArenaToMark, reuse them first
+    while (!(memory = BumpArena(arena, size))) {
+        if (arena->current && arena->current->next) {
+            arena->current = arena->current->next;
+            arena->current->used = 0;
+        } else if (!AddArenaBlock(arena, size)) {
+            return NULL;
+        }
+    }
+
+#if ARENA_POISON
+    memset(memory, ARENA_POISON_ALLOCATED, size);
+#endif
+    return memory;
+}
+
+void *AllocArenaZeroed(Arena *arena, size_t size) {
+    void *memory = AllocArena(arena, size);
+    if (memory) memset(memory, 0, size);
+    return memory;
+}
+
+char *FormatArenaText(Arena *arena, const char *format, ...) {
+    va_list args;
+    size_t space;
+    char *tail = GetArenaTail(arena, &space);
+
+    // The free tail of the block is the buffer, claimed only once the text turned out to fit
+    va_start(args, format);
+    int length = vsnprintf(tail, space, format, args);
+    va_end(args);
+    if (length < 0) return NULL;
+    if ((size_t)length < space) return (char *)BumpArena(arena, length + 1);
+
+    char *text = (char *)AllocArena(arena, length + 1);
+    if (!text) return NULL;
+    va_start(args, format);
+    vsnprintf(text, length + 1, format, args);
+    va_end(args);
+    return text;
+}
+
+ArenaMark GetArenaMark(const Arena *arena) {
+    ArenaMark mark = { arena->current, arena->current ? arena->current->used : 0, arena->used };
+    return mark;
+}
+
+void ResetArenaToMark(Arena *arena, ArenaMark mark) {
+    if (!arena->current) return;
+
+    // A mark taken before the first block was allocated rewinds to its start
+    if (!mark.block) {
+        mark.block = arena->first;
+        mark.used = 0;
+    }
+
+    for (ArenaBlock *block = mark.block; block; block = block->next) {
+        size_t from = block == mark.block ? mark.used : 0;
+        if (ARENA_POISON && block->used > from) PoisonArenaBlock(block, from);
+        if (block == arena->current) break;
+    }
+
+    mark.block->used = mark.used;
+    arena->current = mark.block;
+    arena->used = mark.total;
+}
+
+void ResetArena(Arena *arena) {
+    arena->lastUsed = arena->used;
+    arena->used = 0;
+    arena->allocations = 0;
+    if (!arena->first) return;
+
+    // A frame that spilled into more blocks gets one block holding all of them next time
+    if (arena->first->next) {
+        size_t capacity = 0;
+        for (ArenaBlock *block = arena->first; block;) {
+            ArenaBlock *next = block->next;
+            capacity += block->capacity;
+            free(block);
+            block = next;
+        }
+        arena->first = NULL;
+        arena->current = NULL;
+        if (capacity > arena->blockSize) arena->blockSize = capacity;
+        AddArenaBlock(arena, 0);
+        return;
+    }
+
+    if (ARENA_POISON) PoisonArenaBlock(arena->first, 0);
+    arena->first->used = 0;
+    arena->current = arena->first;
+}
+
+void UnloadArena(Arena *arena) {
+    for (ArenaBlock *block = arena->first; block;) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    size_t blockSize = arena->blockSize;
+    memset(arena, 0, sizeof(Arena));
+    arena->blockSize = blockSize;
+}
+
+// Aligned memory from the current block, NULL when it does not fit
+static void *BumpArena(Arena *arena, size_t size) {
+    ArenaBlock *block = arena->current;
+    if (!block) return NULL;
+
+    size_t offset = AlignBlockOffset(block);
+    if (offset > block->capacity || size > block->capacity - offset) return NULL;
+
+    arena->used += offset + size - block->used;
+    arena->allocations++;
+    if (arena->used > arena->highWater) arena->highWater = arena->used;
+    block->used = offset + size;
+
+    return GetBlockData(block) + offset;
+}
+
+static char *GetArenaTail(const Arena *arena, size_t *space) {
+    ArenaBlock *block = arena->current;
+    size_t offset = block ? AlignBlockOffset(block) : 0;
+
+    if (!block || offset >= block->capacity) {
+        *space = 0;
+        return NULL;
+    }
+    *space = block->capacity - offset;
+    return (char *)GetBlockData(block) + offset;
+}
+
+// Chains a block after the current one, big enough for size
+static bool AddArenaBlock(Arena *arena, size_t size) {
+    size_t capacity = arena->blockSize;
+    if (capacity < size + ARENA_ALIGNMENT) capacity = size + ARENA_ALIGNMENT;
+
+    ArenaBlock *block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + capacity);
+    if (!block) return false;
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+
+    if (arena->current) {
+        block->next = arena->current->next;
+        arena->current->next = block;
+        arena->blocksAdded++;
+    } else {
+        arena->first = block;
+    }
+    arena->current = block;
+    return true;
+}
+
+static void PoisonArenaBlock(ArenaBlock *block, size_t from) {
+    memset(GetBlockData(block) + from, ARENA_POISON_FREED, block->used - from);
+}
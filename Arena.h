@@ -0,0 +1,60 @@
+// Arena.h
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ARENA_ALIGNMENT         16          // Every allocation starts on this boundary, enough for SIMD loads
+#define ARENA_POISON_ALLOCATED  0xCD        // Fill of fresh allocations, so reads of unwritten memory stand out
+#define ARENA_POISON_FREED      0xDD        // Fill of memory handed back by a reset, so stale pointers stand out
+
+// Poisoning costs a memset per allocation and reset, debug builds only unless set explicitly
+#ifndef ARENA_POISON
+#ifdef NDEBUG
+#define ARENA_POISON 0
+#else
+#define ARENA_POISON 1
+#endif
+#endif
+
+// One malloc'd block, its bytes follow the header
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t capacity;            // Bytes after the header
+    size_t used;                // Bytes handed out, alignment padding included
+} ArenaBlock;
+
+// Position to rewind to, for scratch memory that ends before the arena is reset
+typedef struct ArenaMark {
+    ArenaBlock *block;
+    size_t used;
+    size_t total;
+} ArenaMark;
+
+// Linear allocator for memory that lives until the end of a frame: allocation bumps a pointer,
+// nothing is freed on its own and ResetArena hands everything back at once. Running out of the
+// block chains another one, and the next reset folds the chain into a single block big enough
+// for the whole frame, so a steady frame allocates from one block with no malloc at all.
+typedef struct Arena {
+    ArenaBlock *first;          // Blocks in allocation order
+    ArenaBlock *current;        // Block allocations come from
+    size_t blockSize;           // Capacity of the next block, grown to fit whole frames
+    size_t used;                // Bytes handed out since the last reset, padding included
+    size_t lastUsed;            // Of the frame before the last reset
+    size_t highWater;           // Most bytes any frame used
+    int allocations;            // Since the last reset
+    int blocksAdded;            // Blocks chained because a frame did not fit, since init
+} Arena;
+
+// Function declarations
+void InitArena(Arena *arena, size_t blockSize);                         // Empty arena, the first block is allocated on first use
+void *AllocArena(Arena *arena, size_t size);                            // Aligned memory until the next reset, NULL only if malloc fails
+void *AllocArenaZeroed(Arena *arena, size_t size);                      // Same, cleared
+char *FormatArenaText(Arena *arena, const char *format, ...);           // printf into the arena, formatted once when it fits the current block
+ArenaMark GetArenaMark(const Arena *arena);                             // Current position, for ResetArenaToMark
+void ResetArenaToMark(Arena *arena, ArenaMark mark);                    // Hand back everything allocated since mark
+void ResetArena(Arena *arena);                                          // Hand back everything and record the frame's usage
+void UnloadArena(Arena *arena);                                         // Free every block
+
+#endif // ARENA_H
@@ -0,0 +1,222 @@
+// AssetLoader.c
+#include "AssetLoader.h"
+#include "AssetPack.h"
+#include <string.h>
+
+static int RequestAsset(AssetLoader *loader, AssetType type, const char *bakedPath, const char *fallbackPath);
+static void DecodeJob(void *data);
+static void DecodeAsset(Asset *asset);
+static void UploadAsset(Asset *asset);
+static void ReleaseDecodedAsset(Asset *asset);
+
+void InitAssetLoader(AssetLoader *loader, JobSystem *jobs) {
+    memset(loader, 0, sizeof(AssetLoader));
+    loader->jobs = jobs;
+
+    // Placeholders are obvious on purpose, a missing asset should not look finished
+    loader->placeholderModel = LoadModelFromMesh(GenMeshCube(4.0f, 1.0f, 4.0f));
+    Image checked = GenImageChecked(64, 64, 8, 8, MAGENTA, BLACK);
+    loader->placeholderTexture = LoadTextureFromImage(checked);
+    UnloadImage(checked);
+
+    loader->startTime = GetTime();
+    pthread_mutex_init(&loader->lock, NULL);
+}
+
+int RequestModel(AssetLoader *loader, const char *bakedPath, const char *fallbackPath) {
+    return RequestAsset(loader, ASSET_MODEL, bakedPath, fallbackPath);
+}
+
+int RequestTexture(AssetLoader *loader, const char *bakedPath, const char *fallbackPath) {
+    return RequestAsset(loader, ASSET_TEXTURE, bakedPath, fallbackPath);
+}
+
+void UpdateAssetLoader(AssetLoader *loader) {
+    double now = GetTime();
+    if (loader->firstFrameTime == 0.0) loader->firstFrameTime = now - loader->startTime;
+
+    pthread_mutex_lock(&loader->lock);
+    int assetCount = loader->assetCount;
+    bool decoded[ASSET_LOADER_MAX_ASSETS];
+    for (int i = 0; i < assetCount; i++) decoded[i] = loader->assets[i].decoded;
+    pthread_mutex_unlock(&loader->lock);
+
+    // Uploads go in request order, a decoded asset is no longer touched by its job
+    int uploads = 0;
+    for (int i = 0; i < assetCount; i++) {
+        Asset *asset = &loader->assets[i];
+        if (asset->state != ASSET_PENDING || !decoded[i]) continue;
+        if (uploads > 0 && GetTime() - now >= ASSET_UPLOAD_BUDGET) break;
+
+        UploadAsset(asset);
+        loader->pendingCount--;
+        uploads++;
+    }
+
+    if (loader->loadedTime == 0.0 && assetCount > 0 && loader->pendingCount == 0) {
+        loader->loadedTime = GetTime() - loader->startTime;
+    }
+}
+
+Model GetAssetModel(const AssetLoader *loader, int handle) {
+    if (handle <= 0 || handle > loader->assetCount) return loader->placeholderModel;
+
+    const Asset *asset = &loader->assets[handle - 1];
+    return asset->state == ASSET_READY ? asset->model : loader->placeholderModel;
+}
+
+Texture2D GetAssetTexture(const AssetLoader *loader, int handle) {
+    if (handle <= 0 || handle > loader->assetCount) return loader->placeholderTexture;
+
+    const Asset *asset = &loader->assets[handle - 1];
+    return asset->state == ASSET_READY ? asset->texture : loader->placeholderTexture;
+}
+
+void ResolveModelInstance(const AssetLoader *loader, ModelInstance *instance) {
+    if (instance->modelAsset != 0) {
+        Model model = GetAssetModel(loader, instance->modelAsset);
+        if (model.meshes != instance->model.meshes) {
+            Matrix transform = instance->model.transform;
+            instance->model = model;
+            instance->model.transform = transform;
+        }
+    }
+
+    if (instance->textureAsset != 0) {
+        instance->texture = GetAssetTexture(loader, instance->textureAsset);
+    }
+
+    instance->model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = instance->texture;
+}
+
+bool IsAssetLoaderDone(const AssetLoader *loader) {
+    return loader->pendingCount == 0;
+}
+
+void UnloadAssetLoader(AssetLoader *loader) {
+    WaitForCounter(loader->jobs, &loader->decodes);
+
+    for (int i = 0; i < loader->assetCount; i++) {
+        Asset *asset = &loader->assets[i];
+        if (asset->state == ASSET_READY) {
+            if (asset->type == ASSET_MODEL) UnloadModel(asset->model);
+            else UnloadTexture(asset->texture);
+        }
+        else if (asset->decoded) {
+            ReleaseDecodedAsset(asset);
+        }
+    }
+
+    UnloadModel(loader->placeholderModel);
+    UnloadTexture(loader->placeholderTexture);
+    pthread_mutex_destroy(&loader->lock);
+}
+
+static int RequestAsset(AssetLoader *loader, AssetType type, const char *bakedPath, const char *fallbackPath) {
+    if (loader->assetCount >= ASSET_LOADER_MAX_ASSETS) {
+        TraceLog(LOG_WARNING, "ASSETS: Queue full, [%s] not requested", fallbackPath);
+        return 0;
+    }
+
+    Asset *asset = &loader->assets[loader->assetCount];
+    memset(asset, 0, sizeof(Asset));
+    asset->owner = loader;
+    asset->type = type;
+    asset->state = ASSET_PENDING;
+    if (bakedPath) strncpy(asset->path, bakedPath, ASSET_PATH_SIZE - 1);
+    if (fallbackPath) strncpy(asset->fallbackPath, fallbackPath, ASSET_PATH_SIZE - 1);
+
+    // The slot is filled before the job exists, and requests only ever append
+    int handle = ++loader->assetCount;
+    loader->pendingCount++;
+    RunJob(loader->jobs, DecodeJob, asset, &loader->decodes);
+
+    return handle;
+}
+
+static void DecodeJob(void *data) {
+    Asset *asset = (Asset *)data;
+    DecodeAsset(asset);
+
+    // The lock is the handoff to the GL thread, it publishes everything DecodeAsset wrote
+    pthread_mutex_lock(&asset->owner->lock);
+    asset->decoded = true;
+    pthread_mutex_unlock(&asset->owner->lock);
+}
+
+// Everything here runs on a worker and must stay clear of GL
+static void DecodeAsset(Asset *asset) {
+    asset->source = ASSET_SOURCE_NONE;
+
+    if (asset->type == ASSET_MODEL) {
+        if (asset->path[0] != '\0' && MapBakedModel(asset->path, &asset->modelFile)) {
+            // Fault the pages in here so UploadMesh reads from memory, not disk
+            PrefetchFileMap(&asset->modelFile.map);
+            asset->source = ASSET_SOURCE_BAKED;
+        }
+        else if (asset->fallbackPath[0] != '\0' && FileExists(asset->fallbackPath)) {
+            // raylib's LoadModel uploads while it parses, so OBJ files wait for the GL thread
+            // and are always read loose, raylib has no way to parse them from memory
+            asset->source = ASSET_SOURCE_FILE;
+        }
+    }
+    else {
+        if (asset->path[0] != '\0' && MapBakedTexture(asset->path, &asset->textureFile)) {
+            PrefetchFileMap(&asset->textureFile.map);
+            asset->source = ASSET_SOURCE_BAKED;
+        }
+        else if (asset->fallbackPath[0] != '\0' && AssetExists(asset->fallbackPath)) {
+            asset->image = LoadAssetImage(asset->fallbackPath);
+            if (asset->image.data) asset->source = ASSET_SOURCE_IMAGE;
+        }
+    }
+}
+
+static void UploadAsset(Asset *asset) {
+    bool loaded = false;
+
+    if (asset->type == ASSET_MODEL) {
+        if (asset->source == ASSET_SOURCE_BAKED) {
+            asset->model = UploadBakedModel(&asset->modelFile, asset->path);
+            UnmapBakedModel(&asset->modelFile);
+        }
+        else if (asset->source == ASSET_SOURCE_FILE) {
+            asset->model = LoadModel(asset->fallbackPath);
+        }
+        loaded = asset->model.meshCount > 0;
+    }
+    else {
+        if (asset->source == ASSET_SOURCE_BAKED) {
+            BakedTexture baked = UploadBakedTexture(&asset->textureFile);
+            UnmapBakedTexture(&asset->textureFile);
+            RL_FREE(baked.regions);
+            asset->texture = baked.texture;
+
+            // Drivers without S3TC reject block formats, the source image still works
+            if (asset->texture.id == 0 && asset->fallbackPath[0] != '\0' && AssetExists(asset->fallbackPath)) {
+                Image image = LoadAssetImage(asset->fallbackPath);
+                asset->texture = LoadTextureFromImage(image);
+                UnloadImage(image);
+            }
+        }
+        else if (asset->source == ASSET_SOURCE_IMAGE) {
+            asset->texture = LoadTextureFromImage(asset->image);
+            UnloadImage(asset->image);
+            asset->image.data = NULL;
+        }
+        loaded = asset->texture.id != 0;
+    }
+
+    asset->state = loaded ? ASSET_READY : ASSET_FAILED;
+    if (!loaded) TraceLog(LOG_WARNING, "ASSETS: [%s] Failed to load, keeping the placeholder", asset->fallbackPath);
+}
+
+static void ReleaseDecodedAsset(Asset *asset) {
+    if (asset->source == ASSET_SOURCE_BAKED) {
+        if (asset->type == ASSET_MODEL) UnmapBakedModel(&asset->modelFile);
+        else UnmapBakedTexture(&asset->textureFile);
+    }
+    else if (asset->source == ASSET_SOURCE_IMAGE) {
+        UnloadImage(asset->image);
+    }
+}
@@ -0,0 +1,80 @@
+// AssetLoader.h
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "raylib.h"
+#include "BakedModel.h"
+#include "BakedTexture.h"
+#include "ModelArray.h"
+#include "JobSystem.h"
+
+#define ASSET_LOADER_MAX_ASSETS     64      // Requests per loader
+#define ASSET_PATH_SIZE             256     // Longest asset path, including the terminator
+#define ASSET_UPLOAD_BUDGET         0.004   // Seconds of GL uploads per frame, at least one upload always happens
+
+typedef enum AssetType {
+    ASSET_MODEL,
+    ASSET_TEXTURE
+} AssetType;
+
+// Owned by the GL thread
+typedef enum AssetState {
+    ASSET_PENDING,      // Waiting for its decode job or for upload budget
+    ASSET_READY,        // Uploaded, the placeholder is no longer used
+    ASSET_FAILED        // Neither path could be loaded, the placeholder stays
+} AssetState;
+
+// What the decode job left for the GL thread to upload
+typedef enum AssetSource {
+    ASSET_SOURCE_NONE,      // Nothing usable was found
+    ASSET_SOURCE_BAKED,     // Mapped and prefetched .fmesh/.ftex
+    ASSET_SOURCE_IMAGE,     // Decoded fallback image
+    ASSET_SOURCE_FILE       // Fallback that has to be loaded on the GL thread (OBJ)
+} AssetSource;
+
+struct AssetLoader;
+
+typedef struct Asset {
+    struct AssetLoader *owner;          // Loader the request was made to
+    AssetType type;
+    AssetState state;
+    char path[ASSET_PATH_SIZE];         // Baked file, tried first
+    char fallbackPath[ASSET_PATH_SIZE]; // Source file, used when the baked one is missing or invalid
+    bool decoded;                       // Set by the decode job under the lock
+    AssetSource source;                 // Valid once decoded
+    BakedModelFile modelFile;           // ASSET_SOURCE_BAKED models
+    BakedTextureFile textureFile;       // ASSET_SOURCE_BAKED textures
+    Image image;                        // ASSET_SOURCE_IMAGE textures
+    Model model;                        // Valid once ready
+    Texture2D texture;                  // Valid once ready
+} Asset;
+
+// Background loader: jobs map and decode files, the GL thread uploads them under a per-frame budget
+typedef struct AssetLoader {
+    Asset assets[ASSET_LOADER_MAX_ASSETS];
+    int assetCount;             // Requests so far, only changed on the GL thread
+    int pendingCount;           // Requests not yet ready or failed, GL thread only
+    JobSystem *jobs;            // Runs the decode jobs
+    JobCounter decodes;         // Decode jobs still running
+    pthread_mutex_t lock;       // Guards the decoded flags
+    Model placeholderModel;     // Drawn while a model is pending
+    Texture2D placeholderTexture;   // Bound while a texture is pending
+    double startTime;           // GetTime() when the loader started
+    double firstFrameTime;      // Seconds from start to the first update, 0 until then
+    double loadedTime;          // Seconds from start until nothing was pending, 0 until then
+} AssetLoader;
+
+// Function declarations
+void InitAssetLoader(AssetLoader *loader, JobSystem *jobs);                                 // Create placeholders, decodes run as jobs, needs a GL context
+int RequestModel(AssetLoader *loader, const char *bakedPath, const char *fallbackPath);     // Queue a model, returns a handle (0 when the queue is full)
+int RequestTexture(AssetLoader *loader, const char *bakedPath, const char *fallbackPath);   // Queue a texture, returns a handle (0 when the queue is full)
+void UpdateAssetLoader(AssetLoader *loader);                                                // Upload decoded assets until the frame budget is spent, once per frame
+Model GetAssetModel(const AssetLoader *loader, int handle);                                 // Loaded model, or the placeholder
+Texture2D GetAssetTexture(const AssetLoader *loader, int handle);                           // Loaded texture, or the placeholder
+void ResolveModelInstance(const AssetLoader *loader, ModelInstance *instance);              // Swap placeholders for loaded assets, keeping the transform
+bool IsAssetLoaderDone(const AssetLoader *loader);                                          // True when nothing is pending
+void UnloadAssetLoader(AssetLoader *loader);                                                // Wait for decode jobs and unload every asset and placeholder
+
+#endif // ASSETLOADER_H
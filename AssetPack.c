@@ -0,0 +1,133 @@
+// AssetPack.c
+#include "AssetPack.h"
+#include <pthread.h>
+
+static FileMap pack = { 0 };
+static const PackFileEntry *entries = NULL;
+static uint32_t entryCount = 0;
+
+static pthread_mutex_t openLock = PTHREAD_MUTEX_INITIALIZER;
+static int fileOpens = 0;
+
+static const PackFileEntry *FindEntry(const char *fileName);
+static void CountFileOpen(void);
+
+bool MountAssetPack(const char *fileName) {
+    UnmountAssetPack();
+
+    FileMap map = MapFile(fileName);
+    if (!map.data) return false;
+    CountFileOpen();
+
+    const PackFileHeader *header = (const PackFileHeader *)map.data;
+    bool valid = map.size >= sizeof(PackFileHeader) && header->magic == PACK_FILE_MAGIC && header->version == PACK_FILE_VERSION
+                 && header->entryCount <= (map.size - sizeof(PackFileHeader)) / sizeof(PackFileEntry);
+
+    // Lookups binary search the table, so it has to be sorted and every entry has to fit
+    const PackFileEntry *table = (const PackFileEntry *)(map.data + sizeof(PackFileHeader));
+    for (uint32_t i = 0; valid && i < header->entryCount; i++) {
+        const PackFileEntry *entry = &table[i];
+        valid = entry->offset <= map.size && entry->size <= map.size - entry->offset
+                && entry->compression <= PACK_COMPRESSION_DEFLATE
+                && (i == 0 || table[i - 1].hash < entry->hash);
+    }
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "PACK: [%s] Not a version %d asset pack", fileName, PACK_FILE_VERSION);
+        UnmapFile(&map);
+        return false;
+    }
+
+    pack = map;
+    entries = table;
+    entryCount = header->entryCount;
+    TraceLog(LOG_INFO, "PACK: [%s] Mounted, %u entries", fileName, entryCount);
+    return true;
+}
+
+void UnmountAssetPack(void) {
+    UnmapFile(&pack);
+    entries = NULL;
+    entryCount = 0;
+}
+
+bool IsAssetPacked(const char *fileName) {
+    return FindEntry(fileName) != NULL;
+}
+
+bool AssetExists(const char *fileName) {
+    return FindEntry(fileName) != NULL || FileExists(fileName);
+}
+
+FileMap MapAsset(const char *fileName) {
+    FileMap map = { NULL, 0, NULL, false };
+
+    const PackFileEntry *entry = FindEntry(fileName);
+    if (entry) {
+        // Baked files are meant to be mapped, the packer never compresses them
+        if (entry->compression != PACK_COMPRESSION_NONE) {
+            TraceLog(LOG_WARNING, "PACK: [%s] Compressed entries cannot be mapped", fileName);
+            return map;
+        }
+
+        map.data = pack.data + entry->offset;
+        map.size = entry->size;
+        map.borrowed = true;
+        return map;
+    }
+
+    map = MapFile(fileName);
+    if (map.data) CountFileOpen();
+    return map;
+}
+
+Image LoadAssetImage(const char *fileName) {
+    const PackFileEntry *entry = FindEntry(fileName);
+    if (!entry) {
+        Image image = LoadImage(fileName);
+        if (image.data) CountFileOpen();
+        return image;
+    }
+
+    const unsigned char *data = pack.data + entry->offset;
+    if (entry->compression == PACK_COMPRESSION_NONE) {
+        return LoadImageFromMemory(GetFileExtension(fileName), data, (int)entry->size);
+    }
+
+    Image image = { 0 };
+    int rawSize = 0;
+    unsigned char *raw = DecompressData(data, (int)entry->size, &rawSize);
+    if (raw && rawSize == (int)entry->rawSize) {
+        image = LoadImageFromMemory(GetFileExtension(fileName), raw, rawSize);
+    }
+    RL_FREE(raw);
+    return image;
+}
+
+int GetAssetFileOpens(void) {
+    pthread_mutex_lock(&openLock);
+    int opens = fileOpens;
+    pthread_mutex_unlock(&openLock);
+    return opens;
+}
+
+static const PackFileEntry *FindEntry(const char *fileName) {
+    if (entryCount == 0) return NULL;
+
+    uint64_t hash = HashPackPath(fileName);
+    uint32_t low = 0;
+    uint32_t high = entryCount;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (entries[middle].hash < hash) low = middle + 1;
+        else high = middle;
+    }
+
+    return (low < entryCount && entries[low].hash == hash) ? &entries[low] : NULL;
+}
+
+static void CountFileOpen(void) {
+    pthread_mutex_lock(&openLock);
+    fileOpens++;
+    pthread_mutex_unlock(&openLock);
+}
@@ -0,0 +1,22 @@
+// AssetPack.h
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "FileMap.h"
+#include "PackFormat.h"
+
+// One pack can be mounted at a time. Mount before any asset is requested and unmount
+// after the last read, lookups themselves are safe from any thread.
+
+// Function declarations
+bool MountAssetPack(const char *fileName);          // Map a .fpak file, later reads of its paths come from it
+void UnmountAssetPack(void);                        // Release the mounted pack
+bool IsAssetPacked(const char *fileName);           // True when the mounted pack has the path
+bool AssetExists(const char *fileName);             // In the mounted pack or on disk
+FileMap MapAsset(const char *fileName);             // Zero-copy slice of the pack, or a mapping of the loose file
+Image LoadAssetImage(const char *fileName);         // Decode an image from the pack, or from disk
+int GetAssetFileOpens(void);                        // Files opened for asset reads so far, a mounted pack counts once
+
+#endif // ASSETPACK_H
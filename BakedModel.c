@@ -0,0 +1,142 @@
+// BakedModel.c
+#include "BakedModel.h"
+#include "MeshFormat.h"
+#include "FileMap.h"
+#include "AssetPack.h"
+#include "raymath.h"
+#include <string.h>
+
+static bool IsStreamInFile(const FileMap *map, uint32_t offset, size_t size);
+
+Model LoadBakedModel(const char *fileName) {
+    Model model = { 0 };
+    BakedModelFile file;
+
+    if (MapBakedModel(fileName, &file)) {
+        model = UploadBakedModel(&file, fileName);
+        UnmapBakedModel(&file);
+    }
+
+    return model;
+}
+
+bool MapBakedModel(const char *fileName, BakedModelFile *file) {
+    file->map = MapAsset(fileName);
+    file->header = NULL;
+    if (!file->map.data) return false;
+
+    const FileMap *map = &file->map;
+    const MeshFileHeader *header = (const MeshFileHeader *)map->data;
+    if (map->size < sizeof(MeshFileHeader) || header->magic != MESH_FILE_MAGIC || header->version != MESH_FILE_VERSION
+        || header->meshCount == 0
+        || !IsStreamInFile(map, sizeof(MeshFileHeader), header->materialCount * sizeof(MeshFileMaterial) + header->meshCount * sizeof(MeshFileMesh))) {
+        TraceLog(LOG_WARNING, "MODEL: [%s] Not a version %d baked mesh", fileName, MESH_FILE_VERSION);
+        UnmapFile(&file->map);
+        return false;
+    }
+
+    const MeshFileMaterial *materials = (const MeshFileMaterial *)(map->data + sizeof(MeshFileHeader));
+    const MeshFileMesh *meshes = (const MeshFileMesh *)(materials + header->materialCount);
+
+    uint32_t materialLimit = header->materialCount > 0 ? header->materialCount : 1;
+    for (uint32_t i = 0; i < header->meshCount; i++) {
+        const MeshFileMesh *entry = &meshes[i];
+        if (!IsStreamInFile(map, entry->positionsOffset, entry->vertexCount * 3 * sizeof(float))
+            || !IsStreamInFile(map, entry->texcoordsOffset, entry->vertexCount * 2 * sizeof(float))
+            || !IsStreamInFile(map, entry->normalsOffset, entry->vertexCount * 3 * sizeof(float))
+            || !IsStreamInFile(map, entry->indicesOffset, entry->indexCount * sizeof(uint16_t))
+            || entry->vertexCount > MESH_FILE_MAX_VERTICES || entry->material >= materialLimit) {
+            TraceLog(LOG_WARNING, "MODEL: [%s] Mesh %u lies outside the file", fileName, i);
+            UnmapFile(&file->map);
+            return false;
+        }
+    }
+
+    file->header = header;
+    file->materials = materials;
+    file->meshes = meshes;
+    return true;
+}
+
+Model UploadBakedModel(const BakedModelFile *file, const char *fileName) {
+    Model model = { 0 };
+    const MeshFileHeader *header = file->header;
+    const unsigned char *data = file->map.data;
+
+    model.transform = MatrixIdentity();
+
+    // Material 0 is raylib's default when the file has none
+    model.materialCount = header->materialCount > 0 ? (int)header->materialCount : 1;
+    model.materials = (Material *)RL_CALLOC(model.materialCount, sizeof(Material));
+    for (int i = 0; i < model.materialCount; i++) {
+        model.materials[i] = LoadMaterialDefault();
+        if (header->materialCount == 0) continue;
+
+        const MeshFileMaterial *material = &file->materials[i];
+        model.materials[i].maps[MATERIAL_MAP_DIFFUSE].color = (Color){ material->diffuse[0], material->diffuse[1], material->diffuse[2], material->diffuse[3] };
+
+        char diffuseMap[MESH_FILE_PATH_SIZE];
+        memcpy(diffuseMap, material->diffuseMap, MESH_FILE_PATH_SIZE);
+        diffuseMap[MESH_FILE_PATH_SIZE - 1] = '\0';
+        if (diffuseMap[0] != '\0') {
+            const char *path = TextFormat("%s/%s", GetDirectoryPath(fileName), diffuseMap);
+            if (AssetExists(path)) {
+                Image image = LoadAssetImage(path);
+                model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture = LoadTextureFromImage(image);
+                UnloadImage(image);
+            }
+        }
+    }
+
+    // Streams already have raylib's layout, so they go to the GPU straight from the mapping
+    model.meshCount = (int)header->meshCount;
+    model.meshes = (Mesh *)RL_CALLOC(model.meshCount, sizeof(Mesh));
+    model.meshMaterial = (int *)RL_CALLOC(model.meshCount, sizeof(int));
+    for (int i = 0; i < model.meshCount; i++) {
+        const MeshFileMesh *entry = &file->meshes[i];
+        Mesh *mesh = &model.meshes[i];
+
+        mesh->vertexCount = (int)entry->vertexCount;
+        mesh->triangleCount = (int)entry->indexCount / 3;
+        mesh->vertices = (float *)(data + entry->positionsOffset);
+        mesh->texcoords = (float *)(data + entry->texcoordsOffset);
+        mesh->normals = (float *)(data + entry->normalsOffset);
+        mesh->indices = (unsigned short *)(data + entry->indicesOffset);
+        UploadMesh(mesh, false);
+
+        // The mapping goes away after upload and UnloadModel must not free it, so no CPU copy is kept
+        mesh->vertices = NULL;
+        mesh->texcoords = NULL;
+        mesh->normals = NULL;
+        mesh->indices = NULL;
+
+        model.meshMaterial[i] = (int)entry->material;
+    }
+
+    return model;
+}
+
+void UnmapBakedModel(BakedModelFile *file) {
+    UnmapFile(&file->map);
+    file->header = NULL;
+}
+
+BoundingBox GetBakedModelBounds(const char *fileName) {
+    BoundingBox bounds = { 0 };
+
+    FileMap map = MapAsset(fileName);
+    if (!map.data) return bounds;
+
+    const MeshFileHeader *header = (const MeshFileHeader *)map.data;
+    if (map.size >= sizeof(MeshFileHeader) && header->magic == MESH_FILE_MAGIC && header->version == MESH_FILE_VERSION) {
+        bounds.min = (Vector3){ header->boundsMin[0], header->boundsMin[1], header->boundsMin[2] };
+        bounds.max = (Vector3){ header->boundsMax[0], header->boundsMax[1], header->boundsMax[2] };
+    }
+
+    UnmapFile(&map);
+    return bounds;
+}
+
+static bool IsStreamInFile(const FileMap *map, uint32_t offset, size_t size) {
+    return offset <= map->size && size <= map->size - offset;
+}
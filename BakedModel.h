@@ -0,0 +1,24 @@
+// BakedModel.h
+#ifndef BAKEDMODEL_H
+#define BAKEDMODEL_H
+
+#include "raylib.h"
+#include "MeshFormat.h"
+#include "FileMap.h"
+
+// Validated .fmesh mapping, ready to upload on the GL thread
+typedef struct BakedModelFile {
+    FileMap map;                        // Whole file
+    const MeshFileHeader *header;       // Points into map
+    const MeshFileMaterial *materials;  // header->materialCount entries
+    const MeshFileMesh *meshes;         // header->meshCount entries
+} BakedModelFile;
+
+// Function declarations
+Model LoadBakedModel(const char *fileName);  // Map a .fmesh file and upload it, meshCount is 0 on failure
+bool MapBakedModel(const char *fileName, BakedModelFile *file);     // Map and validate, no GL calls (safe on any thread)
+Model UploadBakedModel(const BakedModelFile *file, const char *fileName);  // Upload a mapped file, GL thread only
+void UnmapBakedModel(BakedModelFile *file);                         // Release the mapping
+BoundingBox GetBakedModelBounds(const char *fileName);  // Bounds stored in a .fmesh header, without loading the meshes
+
+#endif // BAKEDMODEL_H
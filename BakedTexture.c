@@ -0,0 +1,106 @@
+// BakedTexture.c
+#include "BakedTexture.h"
+#include "FileMap.h"
+#include "AssetPack.h"
+#include <string.h>
+
+BakedTexture LoadBakedTexture(const char *fileName) {
+    BakedTexture result = { 0 };
+    BakedTextureFile file;
+
+    if (MapBakedTexture(fileName, &file)) {
+        result = UploadBakedTexture(&file);
+        UnmapBakedTexture(&file);
+    }
+
+    return result;
+}
+
+bool MapBakedTexture(const char *fileName, BakedTextureFile *file) {
+    file->map = MapAsset(fileName);
+    file->header = NULL;
+    if (!file->map.data) return false;
+
+    const FileMap *map = &file->map;
+    const TextureFileHeader *header = (const TextureFileHeader *)map->data;
+    bool valid = map->size >= sizeof(TextureFileHeader) && header->magic == TEXTURE_FILE_MAGIC && header->version == TEXTURE_FILE_VERSION
+                 && header->width > 0 && header->height > 0 && header->mipmaps > 0 && header->format <= TEXTURE_FILE_BC3
+                 && sizeof(TextureFileHeader) + (size_t)header->regionCount * sizeof(TextureFileRegion) <= map->size
+                 && header->dataOffset <= map->size && header->dataSize <= map->size - header->dataOffset;
+
+    // The level sizes must add up to exactly what the file claims
+    if (valid) {
+        size_t expected = 0;
+        uint32_t width = header->width;
+        uint32_t height = header->height;
+        for (uint32_t level = 0; level < header->mipmaps; level++) {
+            // raylib sizes block levels as width * height * bpp, which only matches whole blocks
+            if (header->format != TEXTURE_FILE_RGBA8 && (width % 4 != 0 || height % 4 != 0)) valid = false;
+            expected += GetTextureFileLevelSize(width, height, header->format);
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        valid = valid && expected == header->dataSize;
+    }
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "TEXTURE: [%s] Not a version %d baked texture", fileName, TEXTURE_FILE_VERSION);
+        UnmapFile(&file->map);
+        return false;
+    }
+
+    file->header = header;
+    return true;
+}
+
+BakedTexture UploadBakedTexture(const BakedTextureFile *file) {
+    BakedTexture result = { 0 };
+    const TextureFileHeader *header = file->header;
+
+    static const int formats[] = { PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, PIXELFORMAT_COMPRESSED_DXT1_RGB, PIXELFORMAT_COMPRESSED_DXT5_RGBA };
+
+    // The image only borrows the mapping, uploading copies it to the GPU as is
+    Image image = { 0 };
+    image.data = (void *)(file->map.data + header->dataOffset);
+    image.width = (int)header->width;
+    image.height = (int)header->height;
+    image.mipmaps = (int)header->mipmaps;
+    image.format = formats[header->format];
+    result.texture = LoadTextureFromImage(image);
+
+    // Drivers without S3TC leave id at 0, callers fall back to the source image
+    if (result.texture.id != 0 && header->mipmaps > 1) {
+        SetTextureFilter(result.texture, TEXTURE_FILTER_TRILINEAR);
+    }
+
+    if (result.texture.id != 0 && header->regionCount > 0) {
+        const TextureFileRegion *regions = (const TextureFileRegion *)(file->map.data + sizeof(TextureFileHeader));
+        result.regionCount = (int)header->regionCount;
+        result.regions = (TextureRegion *)RL_CALLOC(result.regionCount, sizeof(TextureRegion));
+
+        for (int i = 0; i < result.regionCount; i++) {
+            memcpy(result.regions[i].name, regions[i].name, TEXTURE_FILE_NAME_SIZE);
+            result.regions[i].name[TEXTURE_FILE_NAME_SIZE - 1] = '\0';
+            result.regions[i].source = (Rectangle){ (float)regions[i].x, (float)regions[i].y, (float)regions[i].width, (float)regions[i].height };
+        }
+    }
+
+    return result;
+}
+
+void UnmapBakedTexture(BakedTextureFile *file) {
+    UnmapFile(&file->map);
+    file->header = NULL;
+}
+
+Rectangle GetBakedTextureRegion(const BakedTexture *texture, const char *name) {
+    for (int i = 0; i < texture->regionCount; i++) {
+        if (strcmp(texture->regions[i].name, name) == 0) return texture->regions[i].source;
+    }
+    return (Rectangle){ 0.0f, 0.0f, (float)texture->texture.width, (float)texture->texture.height };
+}
+
+void UnloadBakedTexture(BakedTexture texture) {
+    if (texture.texture.id != 0) UnloadTexture(texture.texture);
+    RL_FREE(texture.regions);
+}
@@ -0,0 +1,36 @@
+// BakedTexture.h
+#ifndef BAKEDTEXTURE_H
+#define BAKEDTEXTURE_H
+
+#include "raylib.h"
+#include "TextureFormat.h"
+#include "FileMap.h"
+
+// Named source rectangle inside an atlas
+typedef struct TextureRegion {
+    char name[TEXTURE_FILE_NAME_SIZE];
+    Rectangle source;
+} TextureRegion;
+
+// Texture loaded from a .ftex file, with its atlas regions if it has any
+typedef struct BakedTexture {
+    Texture2D texture;          // id is 0 when loading failed
+    TextureRegion *regions;     // Atlas regions, NULL for a plain texture
+    int regionCount;
+} BakedTexture;
+
+// Validated .ftex mapping, ready to upload on the GL thread
+typedef struct BakedTextureFile {
+    FileMap map;                        // Whole file
+    const TextureFileHeader *header;    // Points into map
+} BakedTextureFile;
+
+// Function declarations
+BakedTexture LoadBakedTexture(const char *fileName);                              // Map a .ftex file and upload every mip level without decoding
+bool MapBakedTexture(const char *fileName, BakedTextureFile *file);               // Map and validate, no GL calls (safe on any thread)
+BakedTexture UploadBakedTexture(const BakedTextureFile *file);                     // Upload a mapped file, GL thread only
+void UnmapBakedTexture(BakedTextureFile *file);                                    // Release the mapping
+Rectangle GetBakedTextureRegion(const BakedTexture *texture, const char *name);   // Source rectangle of a region, the whole texture when not found
+void UnloadBakedTexture(BakedTexture texture);                                     // Unload the texture and its regions
+
+#endif // BAKEDTEXTURE_H
@@ -0,0 +1,93 @@
+// FileMap.c
+// Kept apart from raylib.h, windows.h redefines several raylib names
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L   // mmap under -std=c99
+#endif
+
+#include "FileMap.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+FileMap MapFile(const char *fileName) {
+    FileMap map = { NULL, 0, NULL, false };
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return map;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return map;
+    }
+
+    // The mapping object keeps the file open, so the file handle can go now
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return map;
+
+    map.data = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!map.data) {
+        CloseHandle(mapping);
+        return map;
+    }
+    map.size = (size_t)size.QuadPart;
+    map.handle = mapping;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return map;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return map;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return map;
+
+    map.data = (const unsigned char *)data;
+    map.size = (size_t)info.st_size;
+#endif
+
+    return map;
+}
+
+void PrefetchFileMap(const FileMap *map) {
+    volatile unsigned char sink = 0;
+    for (size_t offset = 0; offset < map->size; offset += 4096) {
+        sink ^= map->data[offset];
+    }
+    (void)sink;
+}
+
+void UnmapFile(FileMap *map) {
+    if (!map->data) return;
+    if (map->borrowed) {
+        map->data = NULL;
+        map->size = 0;
+        map->borrowed = false;
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(map->data);
+    CloseHandle((HANDLE)map->handle);
+#else
+    munmap((void *)map->data, map->size);
+#endif
+
+    map->data = NULL;
+    map->size = 0;
+    map->handle = NULL;
+}
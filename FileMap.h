@@ -0,0 +1,21 @@
+// FileMap.h
+#ifndef FILEMAP_H
+#define FILEMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Read-only view of a whole file, backed by mmap (or a file mapping on Windows)
+typedef struct FileMap {
+    const unsigned char *data;  // Mapped bytes, NULL when the file could not be mapped
+    size_t size;                // File size in bytes
+    void *handle;               // Platform mapping handle
+    bool borrowed;              // Slice of another mapping, UnmapFile only clears it
+} FileMap;
+
+// Function declarations
+FileMap MapFile(const char *fileName);      // Map a file read-only, data is NULL on failure
+void UnmapFile(FileMap *map);               // Release the mapping, or forget a borrowed slice
+void PrefetchFileMap(const FileMap *map);   // Touch every page so later reads do not fault
+
+#endif // FILEMAP_H
@@ -0,0 +1,300 @@
+// FlightModel.c
+#include "FlightModel.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FLIGHT_FLOAT_FIELDS     17          // Float arrays in FlightBodies, see GetFloatFields
+#define FLIGHT_STATE_FIELDS     13          // Leading fields a step writes, the controls follow
+#define FLIGHT_INITIAL_CAPACITY 64
+#define FLIGHT_MIN_SPEED        0.001f      // Guards the airflow direction of a body at rest
+
+#define AUTOPILOT_MAX_BANK      1.0f        // Radians
+#define AUTOPILOT_MAX_CLIMB     20.0f       // Units per second, up or down
+
+// Shared by every batch of one step
+typedef struct FlightStepTask {
+    FlightBodies *bodies;
+    float dt;
+} FlightStepTask;
+
+static void StepBatches(void *data, int begin, int end);
+static void StepBatch(FlightBodies *bodies, int first, float dt);
+static float ClampSymmetric(float value, float limit);
+static void GetFloatFields(FlightBodies *bodies, float ***fields);
+
+FlightParams GetDefaultFlightParams(void) {
+    FlightParams params = { 0 };
+    params.mass = 1000.0f;
+    params.wingArea = 16.0f;
+    params.maxThrust = 4000.0f;
+    params.liftZero = 0.3f;
+    params.liftSlope = 5.0f;
+    params.maxLift = 1.4f;
+    params.dragZero = 0.03f;
+    params.inducedDrag = 0.05f;
+    params.sideForce = 2.0f;
+    params.pitchRate = 1.0f;
+    params.yawRate = 0.4f;
+    params.rollRate = 2.0f;
+    params.rateResponse = 6.0f;
+    params.stability = 2.0f;
+    return params;
+}
+
+void InitFlightBodies(FlightBodies *bodies, FlightParams params, JobSystem *jobs) {
+    memset(bodies, 0, sizeof(FlightBodies));
+    bodies->params = params;
+    bodies->jobs = jobs;
+}
+
+int AddFlightBody(FlightBodies *bodies, Vector3 position, Quaternion orientation, float speed) {
+    if (bodies->count == bodies->capacity) {
+        int capacity = bodies->capacity > 0 ? bodies->capacity * 2 : FLIGHT_INITIAL_CAPACITY;
+
+        float **fields[FLIGHT_FLOAT_FIELDS];
+        GetFloatFields(bodies, fields);
+        for (int i = 0; i < FLIGHT_FLOAT_FIELDS; i++) {
+            float *grown = (float *)realloc(*fields[i], capacity * sizeof(float));
+            if (!grown) return -1;
+
+            // Padding lanes are stepped with their batch, zeroes keep them at rest
+            memset(grown + bodies->capacity, 0, (capacity - bodies->capacity) * sizeof(float));
+            *fields[i] = grown;
+        }
+        for (int i = bodies->capacity; i < capacity; i++) bodies->orientationW[i] = 1.0f;
+        bodies->capacity = capacity;
+    }
+
+    int index = bodies->count++;
+    float length = sqrtf(orientation.x * orientation.x + orientation.y * orientation.y + orientation.z * orientation.z + orientation.w * orientation.w);
+    if (length <= 0.0f) orientation = (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f };
+    else orientation = (Quaternion){ orientation.x / length, orientation.y / length, orientation.z / length, orientation.w / length };
+
+    // Forward is the third column of the rotation
+    float x = orientation.x, y = orientation.y, z = orientation.z, w = orientation.w;
+    bodies->positionX[index] = position.x;
+    bodies->positionY[index] = position.y;
+    bodies->positionZ[index] = position.z;
+    bodies->velocityX[index] = 2.0f * (x * z + w * y) * speed;
+    bodies->velocityY[index] = 2.0f * (y * z - w * x) * speed;
+    bodies->velocityZ[index] = (1.0f - 2.0f * (x * x + y * y)) * speed;
+    bodies->orientationX[index] = x;
+    bodies->orientationY[index] = y;
+    bodies->orientationZ[index] = z;
+    bodies->orientationW[index] = w;
+    bodies->pitchRate[index] = 0.0f;
+    bodies->yawRate[index] = 0.0f;
+    bodies->rollRate[index] = 0.0f;
+    SetFlightControls(bodies, index, 0.0f, 0.0f, 0.0f, 0.4f);
+
+    return index;
+}
+
+void SetFlightControls(FlightBodies *bodies, int index, float pitch, float yaw, float roll, float throttle) {
+    bodies->controlPitch[index] = Clamp(pitch, -1.0f, 1.0f);
+    bodies->controlYaw[index] = Clamp(yaw, -1.0f, 1.0f);
+    bodies->controlRoll[index] = Clamp(roll, -1.0f, 1.0f);
+    bodies->throttle[index] = Clamp(throttle, 0.0f, 1.0f);
+}
+
+void SteerFlightBody(FlightBodies *bodies, int index, Vector3 target, float cruiseSpeed) {
+    Vector3 position = GetFlightPosition(bodies, index);
+    Vector3 velocity = GetFlightVelocity(bodies, index);
+    Quaternion q = GetFlightOrientation(bodies, index);
+    Vector3 toTarget = { target.x - position.x, target.y - position.y, target.z - position.z };
+    float speed = sqrtf(velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z);
+
+    // Bank towards the target, lift then turns the flight path. Heading grows towards +X, which is left.
+    float turn = atan2f(toTarget.x, toTarget.z) - atan2f(velocity.x, velocity.z);
+    if (turn > PI) turn -= 2.0f * PI;
+    else if (turn < -PI) turn += 2.0f * PI;
+    float desiredBank = Clamp(turn * 2.0f, -AUTOPILOT_MAX_BANK, AUTOPILOT_MAX_BANK);
+    float rightY = -2.0f * (q.x * q.y + q.w * q.z);
+    float bank = asinf(Clamp(rightY, -1.0f, 1.0f));     // Positive with the right wing up
+    float roll = (bank - desiredBank) * 2.0f;
+
+    // Hold the climb rate the height difference asks for
+    float desiredClimb = Clamp(toTarget.y * 0.5f, -AUTOPILOT_MAX_CLIMB, AUTOPILOT_MAX_CLIMB);
+    float pitch = (desiredClimb - velocity.y) * 0.1f;
+
+    // Speed up when the target is ahead, ease off when it is close or behind
+    float ahead = speed > FLIGHT_MIN_SPEED ? (toTarget.x * velocity.x + toTarget.y * velocity.y + toTarget.z * velocity.z) / speed : 0.0f;
+    float desiredSpeed = cruiseSpeed + Clamp(ahead * 0.1f, -0.25f * cruiseSpeed, 0.5f * cruiseSpeed);
+    float throttle = 0.4f + (desiredSpeed - speed) * 0.1f;
+
+    SetFlightControls(bodies, index, pitch, 0.0f, roll, throttle);
+}
+
+int AdvanceFlightBodies(FlightBodies *bodies, float frameTime) {
+    double start = GetTime();
+
+    bodies->accumulator += frameTime;
+    int steps = 0;
+    while (bodies->accumulator >= FLIGHT_FIXED_STEP && steps < FLIGHT_MAX_STEPS) {
+        StepFlightBodies(bodies, FLIGHT_FIXED_STEP);
+        bodies->accumulator -= FLIGHT_FIXED_STEP;
+        steps++;
+    }
+
+    // Falling further behind only makes the next frame longer, slow the simulation down instead
+    if (bodies->accumulator >= FLIGHT_FIXED_STEP) bodies->accumulator = 0.0f;
+
+    bodies->steps = steps;
+    bodies->stepTime = GetTime() - start;
+    return steps;
+}
+
+void StepFlightBodies(FlightBodies *bodies, float dt) {
+    FlightStepTask task = { bodies, dt };
+    int batches = (bodies->count + FLIGHT_BATCH - 1) / FLIGHT_BATCH;
+    ParallelFor(bodies->jobs, batches, FLIGHT_GRAIN / FLIGHT_BATCH, StepBatches, &task);
+}
+
+Vector3 GetFlightPosition(const FlightBodies *bodies, int index) {
+    return (Vector3){ bodies->positionX[index], bodies->positionY[index], bodies->positionZ[index] };
+}
+
+Vector3 GetFlightVelocity(const FlightBodies *bodies, int index) {
+    return (Vector3){ bodies->velocityX[index], bodies->velocityY[index], bodies->velocityZ[index] };
+}
+
+Quaternion GetFlightOrientation(const FlightBodies *bodies, int index) {
+    return (Quaternion){ bodies->orientationX[index], bodies->orientationY[index], bodies->orientationZ[index], bodies->orientationW[index] };
+}
+
+float GetFlightEnergy(const FlightBodies *bodies, int index) {
+    Vector3 velocity = GetFlightVelocity(bodies, index);
+    return 0.5f * (velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z) + FLIGHT_GRAVITY * bodies->positionY[index];
+}
+
+void UnloadFlightBodies(FlightBodies *bodies) {
+    float **fields[FLIGHT_FLOAT_FIELDS];
+    GetFloatFields(bodies, fields);
+    for (int i = 0; i < FLIGHT_FLOAT_FIELDS; i++) free(*fields[i]);
+
+    memset(bodies, 0, sizeof(FlightBodies));
+}
+
+static void StepBatches(void *data, int begin, int end) {
+    const FlightStepTask *task = (const FlightStepTask *)data;
+    for (int batch = begin; batch < end; batch++) StepBatch(task->bodies, batch * FLIGHT_BATCH, task->dt);
+}
+
+// The batch is copied into local lanes: locals cannot alias, so every fixed-length lane loop
+// below compiles to SIMD (with -fno-math-errno for sqrtf). Padding lanes past count are stepped too.
+static void StepBatch(FlightBodies *bodies, int first, float dt) {
+    const FlightParams params = bodies->params;
+    float **fields[FLIGHT_FLOAT_FIELDS];
+    float lanes[FLIGHT_FLOAT_FIELDS][FLIGHT_BATCH];
+    GetFloatFields(bodies, fields);
+    for (int i = 0; i < FLIGHT_FLOAT_FIELDS; i++) memcpy(lanes[i], *fields[i] + first, sizeof(lanes[i]));
+
+    float *px = lanes[0], *py = lanes[1], *pz = lanes[2];
+    float *vx = lanes[3], *vy = lanes[4], *vz = lanes[5];
+    float *qx = lanes[6], *qy = lanes[7], *qz = lanes[8], *qw = lanes[9];
+    float *pitchRate = lanes[10], *yawRate = lanes[11], *rollRate = lanes[12];
+    const float *controlPitch = lanes[13], *controlYaw = lanes[14], *controlRoll = lanes[15], *throttle = lanes[16];
+
+    float inverseMass = 1.0f / params.mass;
+    float dynamicScale = 0.5f * FLIGHT_AIR_DENSITY * params.wingArea;
+    float response = fminf(params.rateResponse * dt, 1.0f);
+
+    // Body axes from the quaternion: forward +Z, up +Y, right -X
+    float fx[FLIGHT_BATCH], fy[FLIGHT_BATCH], fz[FLIGHT_BATCH];
+    float ux[FLIGHT_BATCH], uy[FLIGHT_BATCH], uz[FLIGHT_BATCH];
+    float rx[FLIGHT_BATCH], ry[FLIGHT_BATCH], rz[FLIGHT_BATCH];
+    for (int k = 0; k < FLIGHT_BATCH; k++) {
+        float x = qx[k], y = qy[k], z = qz[k], w = qw[k];
+        fx[k] = 2.0f * (x * z + w * y);
+        fy[k] = 2.0f * (y * z - w * x);
+        fz[k] = 1.0f - 2.0f * (x * x + y * y);
+        ux[k] = 2.0f * (x * y - w * z);
+        uy[k] = 1.0f - 2.0f * (x * x + z * z);
+        uz[k] = 2.0f * (y * z + w * x);
+        rx[k] = 2.0f * (y * y + z * z) - 1.0f;
+        ry[k] = -2.0f * (x * y + w * z);
+        rz[k] = -2.0f * (x * z - w * y);
+    }
+
+    // Forces, then semi-implicit Euler: the new velocity moves the body
+    float inverseSpeed[FLIGHT_BATCH];
+    for (int k = 0; k < FLIGHT_BATCH; k++) {
+        float velocityX = vx[k], velocityY = vy[k], velocityZ = vz[k];
+        float speedSquared = velocityX * velocityX + velocityY * velocityY + velocityZ * velocityZ;
+        float invSpeed = 1.0f / sqrtf(speedSquared + FLIGHT_MIN_SPEED * FLIGHT_MIN_SPEED);
+
+        // Small-angle attack and sideslip from the airflow in body axes
+        float alpha = -(velocityX * ux[k] + velocityY * uy[k] + velocityZ * uz[k]) * invSpeed;
+        float beta = (velocityX * rx[k] + velocityY * ry[k] + velocityZ * rz[k]) * invSpeed;
+        float dynamic = dynamicScale * speedSquared;
+        float lift = ClampSymmetric(params.liftZero + params.liftSlope * alpha, params.maxLift);
+        float drag = params.dragZero + params.inducedDrag * lift * lift;
+
+        float liftForce = dynamic * lift;
+        float sideForce = -dynamic * params.sideForce * beta;
+        float dragForce = dynamic * drag * invSpeed;
+        float thrust = throttle[k] * params.maxThrust;
+
+        float ax = (thrust * fx[k] + liftForce * ux[k] + sideForce * rx[k] - dragForce * velocityX) * inverseMass;
+        float ay = (thrust * fy[k] + liftForce * uy[k] + sideForce * ry[k] - dragForce * velocityY) * inverseMass - FLIGHT_GRAVITY;
+        float az = (thrust * fz[k] + liftForce * uz[k] + sideForce * rz[k] - dragForce * velocityZ) * inverseMass;
+
+        float newVx = velocityX + ax * dt;
+        float newVy = velocityY + ay * dt;
+        float newVz = velocityZ + az * dt;
+        px[k] += newVx * dt;
+        py[k] += newVy * dt;
+        pz[k] += newVz * dt;
+        vx[k] = newVx;
+        vy[k] = newVy;
+        vz[k] = newVz;
+        inverseSpeed[k] = invSpeed;
+    }
+
+    // Body rates chase the controls, the nose also turns into the airflow
+    for (int k = 0; k < FLIGHT_BATCH; k++) {
+        pitchRate[k] += (controlPitch[k] * params.pitchRate - pitchRate[k]) * response;
+        yawRate[k] += (controlYaw[k] * params.yawRate - yawRate[k]) * response;
+        rollRate[k] += (controlRoll[k] * params.rollRate - rollRate[k]) * response;
+
+        float vane = params.stability * inverseSpeed[k];
+        float wx = rx[k] * pitchRate[k] + ux[k] * yawRate[k] + fx[k] * rollRate[k] + vane * (fy[k] * vz[k] - fz[k] * vy[k]);
+        float wy = ry[k] * pitchRate[k] + uy[k] * yawRate[k] + fy[k] * rollRate[k] + vane * (fz[k] * vx[k] - fx[k] * vz[k]);
+        float wz = rz[k] * pitchRate[k] + uz[k] * yawRate[k] + fz[k] * rollRate[k] + vane * (fx[k] * vy[k] - fy[k] * vx[k]);
+
+        // q += dt/2 * (w, 0) * q, with w in world space, then renormalise
+        float x = qx[k], y = qy[k], z = qz[k], w = qw[k];
+        float h = 0.5f * dt;
+        float nx = x + h * (w * wx + wy * z - wz * y);
+        float ny = y + h * (w * wy + wz * x - wx * z);
+        float nz = z + h * (w * wz + wx * y - wy * x);
+        float nw = w - h * (wx * x + wy * y + wz * z);
+        float inverseLength = 1.0f / sqrtf(nx * nx + ny * ny + nz * nz + nw * nw);
+
+        qx[k] = nx * inverseLength;
+        qy[k] = ny * inverseLength;
+        qz[k] = nz * inverseLength;
+        qw[k] = nw * inverseLength;
+    }
+
+    // Controls are only read, the state goes back
+    for (int i = 0; i < FLIGHT_STATE_FIELDS; i++) memcpy(*fields[i] + first, lanes[i], sizeof(lanes[i]));
+}
+
+// Clamp to [-limit, limit] without branches or fminf/fmaxf, neither of which vectorises
+static float ClampSymmetric(float value, float limit) {
+    return 0.5f * (fabsf(value + limit) - fabsf(value - limit));
+}
+
+static void GetFloatFields(FlightBodies *bodies, float ***fields) {
+    float **all[FLIGHT_FLOAT_FIELDS] = {
+        &bodies->positionX, &bodies->positionY, &bodies->positionZ,
+        &bodies->velocityX, &bodies->velocityY, &bodies->velocityZ,
+        &bodies->orientationX, &bodies->orientationY, &bodies->orientationZ, &bodies->orientationW,
+        &bodies->pitchRate, &bodies->yawRate, &bodies->rollRate,
+        &bodies->controlPitch, &bodies->controlYaw, &bodies->controlRoll, &bodies->throttle
+    };
+    memcpy(fields, all, sizeof(all));
+}
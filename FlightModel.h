@@ -0,0 +1,75 @@
+// FlightModel.h
+#ifndef FLIGHTMODEL_H
+#define FLIGHTMODEL_H
+
+#include "raylib.h"
+#include "JobSystem.h"
+
+#define FLIGHT_FIXED_STEP       (1.0f / 120.0f) // Seconds per integration step
+#define FLIGHT_MAX_STEPS        8               // Steps per frame at most, a long frame drops the rest
+#define FLIGHT_BATCH            8               // Lanes per batch, the fixed-length loops over a batch vectorise
+#define FLIGHT_GRAIN            64              // Bodies per job, at least
+#define FLIGHT_GRAVITY          9.81f
+#define FLIGHT_AIR_DENSITY      1.225f
+
+// Airframe shared by every body of a set, so a batch works from broadcast constants
+typedef struct FlightParams {
+    float mass;
+    float wingArea;
+    float maxThrust;            // At full throttle
+    float liftZero;             // Lift coefficient at zero angle of attack
+    float liftSlope;            // Lift coefficient per radian of angle of attack
+    float maxLift;              // Lift coefficient where the wing stalls
+    float dragZero;             // Parasitic drag coefficient
+    float inducedDrag;          // Drag per squared lift coefficient
+    float sideForce;            // Side force coefficient per radian of sideslip
+    float pitchRate;            // Radians per second at full control deflection
+    float yawRate;
+    float rollRate;
+    float rateResponse;         // How fast body rates follow the controls, per second
+    float stability;            // How fast the nose turns into the airflow, per second
+} FlightParams;
+
+// Rigid bodies stored as one array per field, padded to whole batches
+typedef struct FlightBodies {
+    int count;                  // Bodies in use
+    int capacity;               // Allocated, a multiple of FLIGHT_BATCH
+    float *positionX;
+    float *positionY;
+    float *positionZ;
+    float *velocityX;
+    float *velocityY;
+    float *velocityZ;
+    float *orientationX;        // Unit quaternion, body +Z forward and +Y up
+    float *orientationY;
+    float *orientationZ;
+    float *orientationW;
+    float *pitchRate;           // Body rates in radians per second, positive is nose up
+    float *yawRate;             // Positive is nose left
+    float *rollRate;            // Positive is right wing down
+    float *controlPitch;        // Controls in [-1, 1], held between steps
+    float *controlYaw;
+    float *controlRoll;
+    float *throttle;            // [0, 1]
+    FlightParams params;
+    JobSystem *jobs;            // Runs the batches, NULL steps serially
+    float accumulator;          // Frame time not yet integrated
+    int steps;                  // Steps taken by the last AdvanceFlightBodies
+    double stepTime;            // Seconds the last AdvanceFlightBodies spent integrating
+} FlightBodies;
+
+// Function declarations
+FlightParams GetDefaultFlightParams(void);                                      // Light aircraft, cruises near 60 units/s at 40% throttle
+void InitFlightBodies(FlightBodies *bodies, FlightParams params, JobSystem *jobs);  // Empty set, batches run on jobs
+int AddFlightBody(FlightBodies *bodies, Vector3 position, Quaternion orientation, float speed);  // Flying forward at speed, returns its index
+void SetFlightControls(FlightBodies *bodies, int index, float pitch, float yaw, float roll, float throttle);  // Clamped, held until changed
+void SteerFlightBody(FlightBodies *bodies, int index, Vector3 target, float cruiseSpeed);  // Autopilot: bank to turn, climb and throttle towards target
+int AdvanceFlightBodies(FlightBodies *bodies, float frameTime);                // Integrate whole fixed steps of the accumulated time, returns how many
+void StepFlightBodies(FlightBodies *bodies, float dt);                          // One semi-implicit Euler step of every body
+Vector3 GetFlightPosition(const FlightBodies *bodies, int index);
+Vector3 GetFlightVelocity(const FlightBodies *bodies, int index);
+Quaternion GetFlightOrientation(const FlightBodies *bodies, int index);
+float GetFlightEnergy(const FlightBodies *bodies, int index);                   // Kinetic plus potential energy per unit mass
+void UnloadFlightBodies(FlightBodies *bodies);                                  // Free the arrays
+
+#endif // FLIGHTMODEL_H
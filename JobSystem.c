@@ -0,0 +1,365 @@
+// JobSystem.c
+#include "JobSystem.h"
+#include <sched.h>
+#include <stdlib.h>
+
+// Slice of a ParallelFor
+typedef struct JobRange {
+    JobRangeFunction function;
+    void *data;
+    int begin;
+    int end;
+} JobRange;
+
+static void *WorkerMain(void *arg);
+static void Submit(JobSystem *system, Job job);
+static void Execute(JobSystem *system, Job job);
+static bool FindJob(JobSystem *system, JobWorker *self, Job *job);
+static void WakeWorkers(JobSystem *system, int count);
+static void RunRange(void *data);
+static bool PushDeque(JobDeque *deque, Job job);
+static bool PopDeque(JobDeque *deque, Job *job);
+static bool StealDeque(JobDeque *deque, Job *job);
+static void InitJobQueue(JobQueue *queue);
+static void PushQueue(JobQueue *queue, Job job);
+static bool TakeQueue(JobQueue *queue, Job *job);
+static void UnloadJobQueue(JobQueue *queue);
+
+void InitJobSystem(JobSystem *system, int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > JOB_MAX_WORKERS) threadCount = JOB_MAX_WORKERS;
+
+    system->workerCount = threadCount;
+    system->queuedJobs = 0;
+    system->sleepingWorkers = 0;
+    system->quit = false;
+    InitJobQueue(&system->mainQueue);
+    InitJobQueue(&system->injectQueue);
+    pthread_mutex_init(&system->sleepLock, NULL);
+    pthread_cond_init(&system->wake, NULL);
+    pthread_key_create(&system->workerKey, NULL);
+
+    for (int i = 0; i < threadCount; i++) {
+        JobWorker *worker = &system->workers[i];
+        worker->system = system;
+        worker->index = i;
+        worker->deque.top = 0;
+        worker->deque.bottom = 0;
+        worker->random = 2654435761u * (unsigned int)(i + 1);
+        InitArena(&worker->arena, JOB_ARENA_SIZE);
+    }
+
+    // Worker 0 is the thread that owns the GL context
+    pthread_setspecific(system->workerKey, &system->workers[0]);
+    for (int i = 1; i < threadCount; i++) {
+        pthread_create(&system->workers[i].thread, NULL, WorkerMain, &system->workers[i]);
+    }
+}
+
+void RunJob(JobSystem *system, JobFunction function, void *data, JobCounter *counter) {
+    Job job = { function, data, counter, JOB_ANY_THREAD };
+    RunJobs(system, &job, 1, counter);
+}
+
+void RunJobOnMainThread(JobSystem *system, JobFunction function, void *data, JobCounter *counter) {
+    Job job = { function, data, counter, JOB_MAIN_THREAD };
+    RunJobs(system, &job, 1, counter);
+}
+
+void RunJobs(JobSystem *system, const Job *jobs, int count, JobCounter *counter) {
+    // Count the whole group first, so an early finisher cannot drop the counter to zero
+    if (counter) __atomic_add_fetch(&counter->value, count, __ATOMIC_SEQ_CST);
+
+    for (int i = 0; i < count; i++) {
+        Job job = jobs[i];
+        job.counter = counter;
+        Submit(system, job);
+    }
+    WakeWorkers(system, count);
+}
+
+void SetJobContinuation(JobCounter *counter, Job continuation) {
+    // The continuation holds its own counter open until it has run
+    if (continuation.counter) __atomic_add_fetch(&continuation.counter->value, 1, __ATOMIC_SEQ_CST);
+    counter->continuation = continuation;
+}
+
+void WaitForCounter(JobSystem *system, JobCounter *counter) {
+    JobWorker *self = (JobWorker *)pthread_getspecific(system->workerKey);
+
+    while (__atomic_load_n(&counter->value, __ATOMIC_ACQUIRE) > 0) {
+        Job job;
+
+        // Waiting on the main thread must not starve jobs only it may run
+        if (self && self->index == 0 && TakeQueue(&system->mainQueue, &job)) {
+            Execute(system, job);
+        }
+        else if (self ? FindJob(system, self, &job) : TakeQueue(&system->injectQueue, &job)) {
+            if (!self) __atomic_sub_fetch(&system->queuedJobs, 1, __ATOMIC_SEQ_CST);
+            Execute(system, job);
+        }
+        else {
+            sched_yield();
+        }
+    }
+}
+
+bool IsCounterDone(const JobCounter *counter) {
+    return __atomic_load_n(&counter->value, __ATOMIC_ACQUIRE) <= 0;
+}
+
+void RunMainThreadJobs(JobSystem *system) {
+    // Jobs queued by the ones run here wait for the next call
+    pthread_mutex_lock(&system->mainQueue.lock);
+    int count = system->mainQueue.count;
+    pthread_mutex_unlock(&system->mainQueue.lock);
+
+    Job job;
+    for (int i = 0; i < count && TakeQueue(&system->mainQueue, &job); i++) {
+        Execute(system, job);
+    }
+}
+
+void ParallelFor(JobSystem *system, int count, int grain, JobRangeFunction function, void *data) {
+    if (grain < 1) grain = 1;
+    if (!system || system->workerCount == 1 || count <= grain) {
+        function(data, 0, count);
+        return;
+    }
+
+    // A few slices per thread, enough for stealing to even out uneven rows
+    int sliceCount = (count + grain - 1) / grain;
+    if (sliceCount > system->workerCount * JOB_RANGES_PER_WORKER) sliceCount = system->workerCount * JOB_RANGES_PER_WORKER;
+
+    JobRange ranges[JOB_MAX_WORKERS * JOB_RANGES_PER_WORKER];
+    Job jobs[JOB_MAX_WORKERS * JOB_RANGES_PER_WORKER];
+    for (int i = 0; i < sliceCount; i++) {
+        ranges[i] = (JobRange){ function, data, (int)((long long)count * i / sliceCount), (int)((long long)count * (i + 1) / sliceCount) };
+        jobs[i] = (Job){ RunRange, &ranges[i], NULL, JOB_ANY_THREAD };
+    }
+
+    JobCounter counter = { 0 };
+    RunJobs(system, jobs, sliceCount, &counter);
+    WaitForCounter(system, &counter);
+}
+
+int GetJobWorkerIndex(JobSystem *system) {
+    JobWorker *self = (JobWorker *)pthread_getspecific(system->workerKey);
+    return self ? self->index : -1;
+}
+
+Arena *GetJobArena(JobSystem *system) {
+    JobWorker *self = (JobWorker *)pthread_getspecific(system->workerKey);
+    return self ? &self->arena : NULL;
+}
+
+void ResetJobArenas(JobSystem *system) {
+    for (int i = 0; i < system->workerCount; i++) ResetArena(&system->workers[i].arena);
+}
+
+size_t GetJobArenaHighWater(JobSystem *system) {
+    size_t highWater = 0;
+    for (int i = 0; i < system->workerCount; i++) {
+        if (system->workers[i].arena.highWater > highWater) highWater = system->workers[i].arena.highWater;
+    }
+    return highWater;
+}
+
+void UnloadJobSystem(JobSystem *system) {
+    pthread_mutex_lock(&system->sleepLock);
+    system->quit = true;
+    pthread_cond_broadcast(&system->wake);
+    pthread_mutex_unlock(&system->sleepLock);
+
+    for (int i = 1; i < system->workerCount; i++) {
+        pthread_join(system->workers[i].thread, NULL);
+    }
+
+    pthread_setspecific(system->workerKey, NULL);
+    pthread_key_delete(system->workerKey);
+    pthread_mutex_destroy(&system->sleepLock);
+    pthread_cond_destroy(&system->wake);
+    UnloadJobQueue(&system->mainQueue);
+    UnloadJobQueue(&system->injectQueue);
+    for (int i = 0; i < system->workerCount; i++) UnloadArena(&system->workers[i].arena);
+}
+
+static void *WorkerMain(void *arg) {
+    JobWorker *self = (JobWorker *)arg;
+    JobSystem *system = self->system;
+    pthread_setspecific(system->workerKey, self);
+
+    int idle = 0;
+    for (;;) {
+        Job job;
+        if (FindJob(system, self, &job)) {
+            Execute(system, job);
+            idle = 0;
+            continue;
+        }
+        if (++idle < JOB_SPIN_COUNT) {
+            sched_yield();
+            continue;
+        }
+        idle = 0;
+
+        // Announce the sleep before checking for work, submitters check in the opposite
+        // order (queuedJobs then sleepingWorkers), so one of the two always sees the other
+        pthread_mutex_lock(&system->sleepLock);
+        __atomic_add_fetch(&system->sleepingWorkers, 1, __ATOMIC_SEQ_CST);
+        while (!system->quit && __atomic_load_n(&system->queuedJobs, __ATOMIC_SEQ_CST) <= 0) {
+            pthread_cond_wait(&system->wake, &system->sleepLock);
+        }
+        __atomic_sub_fetch(&system->sleepingWorkers, 1, __ATOMIC_SEQ_CST);
+        bool quit = system->quit;
+        pthread_mutex_unlock(&system->sleepLock);
+
+        if (quit) break;
+    }
+
+    return NULL;
+}
+
+static void Submit(JobSystem *system, Job job) {
+    if (job.affinity == JOB_MAIN_THREAD) {
+        PushQueue(&system->mainQueue, job);
+        return;
+    }
+
+    // Pool threads keep their jobs local, everyone else (and a full deque) goes through the shared queue
+    JobWorker *self = (JobWorker *)pthread_getspecific(system->workerKey);
+    if (!self || !PushDeque(&self->deque, job)) PushQueue(&system->injectQueue, job);
+    __atomic_add_fetch(&system->queuedJobs, 1, __ATOMIC_SEQ_CST);
+}
+
+static void Execute(JobSystem *system, Job job) {
+    job.function(job.data);
+
+    JobCounter *counter = job.counter;
+    if (!counter) return;
+
+    // A waiter may free the counter as soon as it reaches zero, read the continuation first
+    Job continuation = counter->continuation;
+    if (__atomic_sub_fetch(&counter->value, 1, __ATOMIC_ACQ_REL) == 0 && continuation.function) {
+        Submit(system, continuation);
+        WakeWorkers(system, 1);
+    }
+}
+
+static bool FindJob(JobSystem *system, JobWorker *self, Job *job) {
+    bool found = PopDeque(&self->deque, job) || TakeQueue(&system->injectQueue, job);
+
+    // Start from a random victim so thieves do not all hit the same deque
+    int count = system->workerCount;
+    if (!found && count > 1) {
+        self->random = self->random * 1664525u + 1013904223u;
+        int first = (int)((self->random >> 16) % (unsigned int)count);
+        for (int i = 0; i < count && !found; i++) {
+            int victim = (first + i) % count;
+            if (victim != self->index) found = StealDeque(&system->workers[victim].deque, job);
+        }
+    }
+
+    if (found) __atomic_sub_fetch(&system->queuedJobs, 1, __ATOMIC_SEQ_CST);
+    return found;
+}
+
+static void WakeWorkers(JobSystem *system, int count) {
+    if (__atomic_load_n(&system->sleepingWorkers, __ATOMIC_SEQ_CST) == 0) return;
+
+    pthread_mutex_lock(&system->sleepLock);
+    if (count > 1) pthread_cond_broadcast(&system->wake);
+    else pthread_cond_signal(&system->wake);
+    pthread_mutex_unlock(&system->sleepLock);
+}
+
+static void RunRange(void *data) {
+    const JobRange *range = (const JobRange *)data;
+    range->function(range->data, range->begin, range->end);
+}
+
+static bool PushDeque(JobDeque *deque, Job job) {
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    if (bottom - top >= JOB_DEQUE_SIZE) return false;
+
+    deque->jobs[bottom & (JOB_DEQUE_SIZE - 1)] = job;
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool PopDeque(JobDeque *deque, Job *job) {
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+    if (top > bottom) {
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    *job = deque->jobs[bottom & (JOB_DEQUE_SIZE - 1)];
+    if (top < bottom) return true;
+
+    // Last job, race the thieves for it
+    bool won = __atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    return won;
+}
+
+static bool StealDeque(JobDeque *deque, Job *job) {
+    int64_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int64_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+    if (top >= bottom) return false;
+
+    Job stolen = deque->jobs[top & (JOB_DEQUE_SIZE - 1)];
+    if (!__atomic_compare_exchange_n(&deque->top, &top, top + 1, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) return false;
+
+    *job = stolen;
+    return true;
+}
+
+static void InitJobQueue(JobQueue *queue) {
+    pthread_mutex_init(&queue->lock, NULL);
+    queue->capacity = 64;
+    queue->jobs = (Job *)malloc(queue->capacity * sizeof(Job));
+    queue->head = 0;
+    queue->count = 0;
+}
+
+static void PushQueue(JobQueue *queue, Job job) {
+    pthread_mutex_lock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        // Unroll the ring into a buffer twice the size
+        Job *jobs = (Job *)malloc(queue->capacity * 2 * sizeof(Job));
+        for (int i = 0; i < queue->count; i++) jobs[i] = queue->jobs[(queue->head + i) % queue->capacity];
+        free(queue->jobs);
+        queue->jobs = jobs;
+        queue->head = 0;
+        queue->capacity *= 2;
+    }
+    queue->jobs[(queue->head + queue->count) % queue->capacity] = job;
+    queue->count++;
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static bool TakeQueue(JobQueue *queue, Job *job) {
+    pthread_mutex_lock(&queue->lock);
+    bool found = queue->count > 0;
+    if (found) {
+        *job = queue->jobs[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->count--;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return found;
+}
+
+static void UnloadJobQueue(JobQueue *queue) {
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->jobs);
+    queue->jobs = NULL;
+    queue->count = 0;
+}
@@ -0,0 +1,97 @@
+// JobSystem.h
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "Arena.h"
+
+#define JOB_MAX_WORKERS     16      // Upper bound on threads, including the main thread
+#define JOB_DEQUE_SIZE      4096    // Jobs per worker deque, a power of two
+#define JOB_SPIN_COUNT      64      // Empty polls before a worker goes to sleep
+#define JOB_RANGES_PER_WORKER 4     // ParallelFor slices per thread, stealing balances them
+#define JOB_ARENA_SIZE (256 * 1024) // First block of each worker's frame arena, grows to the busiest frame
+
+typedef void (*JobFunction)(void *data);
+typedef void (*JobRangeFunction)(void *data, int begin, int end);
+
+// Threads a job may run on
+typedef enum JobAffinity {
+    JOB_ANY_THREAD,         // Any worker, including the main thread
+    JOB_MAIN_THREAD         // Only the main thread, for GL calls
+} JobAffinity;
+
+struct JobCounter;
+
+typedef struct Job {
+    JobFunction function;
+    void *data;
+    struct JobCounter *counter;     // Decremented when the job finishes, may be NULL
+    JobAffinity affinity;
+} Job;
+
+// Counts unfinished jobs. When it drops to zero the continuation, if any, is submitted.
+typedef struct JobCounter {
+    int value;                      // Unfinished jobs, only touched atomically
+    Job continuation;               // Runs once every counted job finished, function NULL for none
+} JobCounter;
+
+// Chase-Lev work-stealing deque: the owner pushes and pops at the bottom, thieves take the top
+typedef struct JobDeque {
+    Job jobs[JOB_DEQUE_SIZE];
+    int64_t top;                    // Next job to steal
+    int64_t bottom;                 // Next free slot
+} JobDeque;
+
+// Mutex-guarded FIFO for jobs that cannot go on a deque
+typedef struct JobQueue {
+    pthread_mutex_t lock;
+    Job *jobs;
+    int head;                       // Next job to take
+    int count;                      // Queued jobs
+    int capacity;                   // Allocated slots
+} JobQueue;
+
+struct JobSystem;
+
+typedef struct JobWorker {
+    struct JobSystem *system;
+    int index;                      // 0 is the main thread
+    pthread_t thread;               // Unused for worker 0
+    JobDeque deque;
+    unsigned int random;            // Victim selection state
+    Arena arena;                    // Frame scratch of jobs running on this thread, see GetJobArena
+} JobWorker;
+
+// One pool of threads shared by every subsystem
+typedef struct JobSystem {
+    JobWorker workers[JOB_MAX_WORKERS];
+    int workerCount;                // Threads including the main thread
+    JobQueue mainQueue;             // JOB_MAIN_THREAD jobs
+    JobQueue injectQueue;           // Jobs submitted from threads outside the pool
+    int queuedJobs;                 // Jobs waiting in deques and injectQueue, only touched atomically
+    int sleepingWorkers;            // Workers blocked on wake, only touched atomically
+    pthread_mutex_t sleepLock;
+    pthread_cond_t wake;            // Signalled when jobs arrive while workers sleep
+    pthread_key_t workerKey;        // JobWorker of the calling thread
+    bool quit;                      // Ask workers to exit, guarded by sleepLock
+} JobSystem;
+
+// Function declarations
+void InitJobSystem(JobSystem *system, int threadCount);                                 // Start threadCount - 1 workers, the caller becomes worker 0
+void RunJob(JobSystem *system, JobFunction function, void *data, JobCounter *counter);  // Submit a job that may run on any thread
+void RunJobOnMainThread(JobSystem *system, JobFunction function, void *data, JobCounter *counter);  // Submit a job for the main thread
+void RunJobs(JobSystem *system, const Job *jobs, int count, JobCounter *counter);       // Submit a group, the counter covers all of it before any job starts
+void SetJobContinuation(JobCounter *counter, Job continuation);                         // Submit continuation once counter drops to zero, set before the counted jobs
+void WaitForCounter(JobSystem *system, JobCounter *counter);                            // Run other jobs until counter reaches zero
+bool IsCounterDone(const JobCounter *counter);                                          // True when every counted job finished
+void RunMainThreadJobs(JobSystem *system);                                              // Run queued JOB_MAIN_THREAD jobs, once per frame
+void ParallelFor(JobSystem *system, int count, int grain, JobRangeFunction function, void *data);  // Split [0, count) into ranges of at least grain, returns when done
+int GetJobWorkerIndex(JobSystem *system);                                               // Worker index of the caller, -1 outside the pool
+Arena *GetJobArena(JobSystem *system);                                                  // Frame arena of the calling worker, NULL outside the pool
+void ResetJobArenas(JobSystem *system);                                                 // End of frame, only while no job is using its arena
+size_t GetJobArenaHighWater(JobSystem *system);                                         // Most bytes any worker arena used in one frame
+void UnloadJobSystem(JobSystem *system);                                                // Stop and join the workers
+
+#endif // JOBSYSTEM_H
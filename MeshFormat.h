@@ -0,0 +1,45 @@
+// MeshFormat.h
+#ifndef MESHFORMAT_H
+#define MESHFORMAT_H
+
+#include <stdint.h>
+
+// Baked mesh file (.fmesh), written by tools/meshbaker and mapped by LoadBakedModel.
+// Layout: MeshFileHeader, materialCount MeshFileMaterial, meshCount MeshFileMesh, then
+// the vertex streams. Streams are stored exactly like raylib's Mesh arrays (positions,
+// texcoords, normals, 16-bit indices), each aligned to MESH_FILE_ALIGNMENT, so they can
+// be uploaded straight from the mapping. All values are little-endian.
+
+#define MESH_FILE_MAGIC 0x48534D46u   // "FMSH"
+#define MESH_FILE_VERSION 1           // Bump on any layout change
+#define MESH_FILE_ALIGNMENT 16        // Alignment of every stream
+#define MESH_FILE_PATH_SIZE 64        // Texture path length including the terminator
+#define MESH_FILE_MAX_VERTICES 65535  // Per mesh, raylib meshes use 16-bit indices
+
+typedef struct MeshFileHeader {
+    uint32_t magic;             // MESH_FILE_MAGIC
+    uint32_t version;           // MESH_FILE_VERSION
+    uint32_t meshCount;         // Entries in the mesh table
+    uint32_t materialCount;     // Entries in the material table
+    float boundsMin[3];         // Bounds of the whole model
+    float boundsMax[3];
+} MeshFileHeader;
+
+typedef struct MeshFileMaterial {
+    unsigned char diffuse[4];                   // Diffuse colour, RGBA
+    char diffuseMap[MESH_FILE_PATH_SIZE];       // Texture relative to the mesh file, empty when none
+} MeshFileMaterial;
+
+typedef struct MeshFileMesh {
+    uint32_t vertexCount;       // Vertices in every stream
+    uint32_t indexCount;        // 16-bit indices, three per triangle
+    uint32_t material;          // Index into the material table
+    uint32_t positionsOffset;   // float[3] per vertex, from the start of the file
+    uint32_t texcoordsOffset;   // float[2] per vertex
+    uint32_t normalsOffset;     // float[3] per vertex
+    uint32_t indicesOffset;     // uint16_t per index
+    float boundsMin[3];         // Bounds of this mesh
+    float boundsMax[3];
+} MeshFileMesh;
+
+#endif // MESHFORMAT_H
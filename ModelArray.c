@@ -1,5 +1,6 @@
 // ModelArray.c
 #include "ModelArray.h"
+#include "raymath.h"
 #include <stdlib.h>
 
 ModelArray *CreateModelArray(size_t initial_capacity) {
@@ -34,8 +35,9 @@ void AppendModel(ModelArray *array, ModelInstance instance) {
 void UnloadModelArray(ModelArray *array) {
     if (array) {
         for (size_t i = 0; i < array->size; ++i) {
-            UnloadModel(array->models[i].model);
-            UnloadTexture(array->models[i].texture);
+            // Loader-owned assets are unloaded with the loader
+            if (array->models[i].modelAsset == 0) UnloadModel(array->models[i].model);
+            if (array->models[i].textureAsset == 0) UnloadTexture(array->models[i].texture);
         }
     }
 }
@@ -46,3 +48,26 @@ void FreeModelArray(ModelArray *array) {
         free(array);
     }
 }
+
+void SetModelOrientation(ModelInstance *instance, Quaternion orientation) {
+    Quaternion current = instance->orientation;
+    if (current.x == orientation.x && current.y == orientation.y && current.z == orientation.z && current.w == orientation.w) return;
+
+    instance->orientation = orientation;
+    instance->transformDirty = true;
+}
+
+int UpdateModelTransforms(ModelArray *array) {
+    int rebuilt = 0;
+
+    for (size_t i = 0; i < array->size; ++i) {
+        ModelInstance *instance = &array->models[i];
+        if (!instance->transformDirty) continue;
+
+        instance->model.transform = QuaternionToMatrix(instance->orientation);
+        instance->transformDirty = false;
+        rebuilt++;
+    }
+
+    return rebuilt;
+}
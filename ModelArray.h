@@ -2,6 +2,7 @@
 #ifndef MODELARRAY_H
 #define MODELARRAY_H
 
+#include <stdbool.h>
 #include <stddef.h>
 #include "raylib.h"
 
@@ -11,6 +12,10 @@ typedef struct {
     Vector3 position;
     float scale;
     Color color;
+    int modelAsset;     // AssetLoader handle, 0 when the instance owns its model
+    int textureAsset;   // AssetLoader handle, 0 when the instance owns its texture
+    Quaternion orientation; // Rotation, model.transform is rebuilt from it by UpdateModelTransforms
+    bool transformDirty;    // Orientation changed since model.transform was built
 } ModelInstance;
 
 typedef struct {
@@ -24,5 +29,7 @@ ModelArray *CreateModelArray(size_t initial_capacity);
 void AppendModel(ModelArray *array, ModelInstance instance);
 void UnloadModelArray(ModelArray *array);
 void FreeModelArray(ModelArray *array);
+void SetModelOrientation(ModelInstance *instance, Quaternion orientation);  // Marks the transform dirty only if the orientation changed
+int UpdateModelTransforms(ModelArray *array);                               // Rebuild dirty transforms, returns how many were rebuilt
 
 #endif // MODELARRAY_H
@@ -0,0 +1,180 @@
+// NetClient.c
+#include "NetClient.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "RenderPacket.h"
+#include <math.h>
+#include <string.h>
+
+#define NET_MODEL_DISTANCE  600.0f  // Nearer planes are drawn with the model, farther ones as impostors
+#define NET_KEEPALIVE       1.0f    // Seconds between acks while no snapshot arrives
+
+static void SendNetClientPacket(NetClient *client, NetPacketType type, Vector3 position);
+
+void InitNetClient(NetClient *client) {
+    memset(client, 0, sizeof(NetClient));
+    client->socket.handle = -1;
+    for (int h = 0; h < NET_SNAPSHOT_HISTORY; h++) InitNetSnapshot(&client->received[h]);
+}
+
+bool ConnectNetClient(NetClient *client, uint16_t port, double time) {
+    DisconnectNetClient(client);
+    InitNetClient(client);
+
+    if (!OpenNetSocket(&client->socket, 0)) return false;
+
+    client->server = GetLoopbackAddress(port);
+    client->state = NET_CLIENT_CONNECTING;
+    client->startTime = time;
+    client->lastHeard = time;
+    SendNetClientPacket(client, NET_PACKET_CONNECT, (Vector3){ 0.0f, 0.0f, 0.0f });
+    client->lastSent = time;
+
+    return true;
+}
+
+void PollNetClient(NetClient *client, Vector3 position, double time) {
+    if (client->state == NET_CLIENT_DISCONNECTED) return;
+
+    uint8_t packet[NET_MAX_PACKET];
+    NetAddress from;
+    int size;
+    bool decoded = false;
+
+    while ((size = ReceiveNetPacket(&client->socket, &from, packet, sizeof(packet))) > 0) {
+        if (!IsSameNetAddress(from, client->server)) continue;
+        client->bytesReceived += size;
+
+        NetBitReader reader;
+        InitNetBitReader(&reader, packet, size);
+        uint32_t magic = ReadNetBits(&reader, 32);
+        uint32_t version = ReadNetBits(&reader, 16);
+        uint32_t type = ReadNetBits(&reader, 16);
+        if (reader.overflow || magic != NET_PROTOCOL_MAGIC || version != NET_PROTOCOL_VERSION) continue;
+        client->lastHeard = time;
+
+        if (type == NET_PACKET_ACCEPT) {
+            int slot = (int)ReadNetBits(&reader, 32);
+            int worldSize = (int)ReadNetBits(&reader, 32);
+            if (reader.overflow || worldSize > NET_MAX_WORLD) continue;
+            for (int i = 0; i < worldSize; i++) client->world[i] = (uint8_t)ReadNetBits(&reader, 8);
+            if (reader.overflow) continue;
+
+            client->slot = slot;
+            client->worldSize = worldSize;
+            client->state = NET_CLIENT_CONNECTED;
+        } else if (type == NET_PACKET_DISCONNECT) {
+            client->state = NET_CLIENT_DISCONNECTED;
+            return;
+        } else if (type == NET_PACKET_SNAPSHOT && client->state == NET_CLIENT_CONNECTED) {
+            uint32_t sequence = ReadNetBits(&reader, 32);
+            uint32_t baselineSequence = ReadNetBits(&reader, 32);
+            if (reader.overflow || sequence <= client->latestSequence) continue;
+
+            // The baseline must still be held exactly as decoded, or the delta means nothing
+            const NetSnapshot *baseline = NULL;
+            if (baselineSequence != 0) {
+                baseline = &client->received[baselineSequence % NET_SNAPSHOT_HISTORY];
+                if (baseline->sequence != baselineSequence || sequence - baselineSequence >= NET_SNAPSHOT_HISTORY) {
+                    client->snapshotsDropped++;
+                    continue;
+                }
+            }
+
+            NetSnapshot *result = &client->received[sequence % NET_SNAPSHOT_HISTORY];
+            if (!ReadNetSnapshotDelta(&reader, baseline, result)) {
+                ClearNetSnapshot(result);
+                client->snapshotsDropped++;
+                continue;
+            }
+            result->sequence = sequence;
+            client->latestSequence = sequence;
+            client->snapshotsReceived++;
+            decoded = true;
+        }
+    }
+
+    // One ack per poll covers every snapshot decoded in it, the server only needs the newest
+    if (client->state == NET_CLIENT_CONNECTING && time - client->lastSent > NET_CONNECT_RETRY) {
+        SendNetClientPacket(client, NET_PACKET_CONNECT, position);
+        client->lastSent = time;
+    } else if (client->state == NET_CLIENT_CONNECTED && (decoded || time - client->lastSent > NET_KEEPALIVE)) {
+        SendNetClientPacket(client, NET_PACKET_ACK, position);
+        client->lastSent = time;
+    }
+
+    if (time - client->lastHeard > NET_TIMEOUT) client->state = NET_CLIENT_DISCONNECTED;
+}
+
+const NetSnapshot *GetNetClientSnapshot(const NetClient *client) {
+    if (client->latestSequence == 0) return NULL;
+    return &client->received[client->latestSequence % NET_SNAPSHOT_HISTORY];
+}
+
+void DrawNetSnapshot(const NetSnapshot *snapshot, Model model, ImpostorAtlas *impostors, int impostor, Camera camera, Vector3 origin) {
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, (double)GetScreenWidth() / GetScreenHeight(), RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    Vector4 planes[6];
+    GetFrustumPlanes(MatrixMultiply(view, projection), planes);
+
+    float modelDistanceSquared = NET_MODEL_DISTANCE * NET_MODEL_DISTANCE;
+
+    for (int i = 0; i < snapshot->count; i++) {
+        const NetEntity *entity = &snapshot->entities[i];
+        Vector3 position = Vector3Subtract(GetNetEntityPosition(entity), origin);
+
+        if (entity->id & NET_BULLET_ID) {
+            if (IsSphereInFrustum(planes, position, 4.0f)) DrawCube(position, 3.0f, 3.0f, 3.0f, ORANGE);
+            continue;
+        }
+        if (Vector3DistanceSqr(position, camera.position) > modelDistanceSquared || !IsSphereInFrustum(planes, position, 20.0f)) continue;
+
+        model.transform = QuaternionToMatrix(GetNetEntityOrientation(entity));
+        DrawModel(model, position, 1.0f, PURPLE);
+    }
+
+    // Distant planes are a few pixels tall, all of them go in one impostor batch
+    BeginImpostors(impostors, camera.position, PURPLE);
+    for (int i = 0; i < snapshot->count; i++) {
+        const NetEntity *entity = &snapshot->entities[i];
+        if (entity->id & NET_BULLET_ID) continue;
+
+        Vector3 position = Vector3Subtract(GetNetEntityPosition(entity), origin);
+        if (Vector3DistanceSqr(position, camera.position) <= modelDistanceSquared || !IsSphereInFrustum(planes, position, 20.0f)) continue;
+
+        // Heading of the rotated +Z axis, pitch does not change the baked view
+        Quaternion q = GetNetEntityOrientation(entity);
+        float yaw = atan2f(2.0f * (q.x * q.z + q.w * q.y), 1.0f - 2.0f * (q.x * q.x + q.y * q.y));
+        DrawImpostor(impostors, impostor, position, yaw, 1.0f);
+    }
+    EndImpostors(impostors);
+}
+
+void DisconnectNetClient(NetClient *client) {
+    if (client->state != NET_CLIENT_DISCONNECTED) SendNetClientPacket(client, NET_PACKET_DISCONNECT, (Vector3){ 0.0f, 0.0f, 0.0f });
+    client->state = NET_CLIENT_DISCONNECTED;
+
+    CloseNetSocket(&client->socket);
+    for (int h = 0; h < NET_SNAPSHOT_HISTORY; h++) UnloadNetSnapshot(&client->received[h]);
+    client->latestSequence = 0;
+}
+
+static void SendNetClientPacket(NetClient *client, NetPacketType type, Vector3 position) {
+    uint8_t packet[32];
+    NetBitWriter writer;
+    InitNetBitWriter(&writer, packet, sizeof(packet));
+    WriteNetBits(&writer, NET_PROTOCOL_MAGIC, 32);
+    WriteNetBits(&writer, NET_PROTOCOL_VERSION, 16);
+    WriteNetBits(&writer, type, 16);
+
+    if (type == NET_PACKET_ACK) {
+        uint32_t bits[3];
+        memcpy(&bits[0], &position.x, sizeof(float));
+        memcpy(&bits[1], &position.y, sizeof(float));
+        memcpy(&bits[2], &position.z, sizeof(float));
+        WriteNetBits(&writer, client->latestSequence, 32);
+        for (int i = 0; i < 3; i++) WriteNetBits(&writer, bits[i], 32);
+    }
+
+    SendNetPacket(&client->socket, client->server, packet, GetNetBitWriterBytes(&writer));
+}
@@ -0,0 +1,45 @@
+// NetClient.h
+#ifndef NETCLIENT_H
+#define NETCLIENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "NetProtocol.h"
+#include "NetSnapshot.h"
+#include "NetSocket.h"
+#include "Terrain/Impostor.h"
+
+typedef enum NetClientState {
+    NET_CLIENT_DISCONNECTED = 0,
+    NET_CLIENT_CONNECTING,      // Sending connects until the server accepts
+    NET_CLIENT_CONNECTED
+} NetClientState;
+
+// Receiving end: decodes snapshots against the ones it already holds and acknowledges them
+typedef struct NetClient {
+    NetSocket socket;
+    NetAddress server;
+    NetClientState state;
+    int slot;                   // Index the server gave this client
+    uint8_t world[NET_MAX_WORLD];   // World description sent with the accept
+    int worldSize;              // Its bytes, 0 until accepted
+    double startTime;           // Time ConnectNetClient was called, in the caller's clock
+    double lastSent;            // Time of the last connect or ack
+    double lastHeard;           // And of the last packet from the server
+    NetSnapshot received[NET_SNAPSHOT_HISTORY];     // Decoded snapshots by sequence, baselines for the next ones
+    uint32_t latestSequence;    // Newest decoded snapshot, 0 for none
+    long long bytesReceived;
+    int snapshotsReceived;
+    int snapshotsDropped;       // Baseline no longer held, or corrupt
+} NetClient;
+
+// Function declarations
+void InitNetClient(NetClient *client);                                    // Disconnected client, safe to connect or disconnect
+bool ConnectNetClient(NetClient *client, uint16_t port, double time);     // Start connecting to a server on localhost, dropping any earlier connection
+void PollNetClient(NetClient *client, Vector3 position, double time);     // Decode waiting snapshots, acknowledge the newest and report position
+const NetSnapshot *GetNetClientSnapshot(const NetClient *client);          // Newest decoded snapshot, NULL before the first
+void DrawNetSnapshot(const NetSnapshot *snapshot, Model model, ImpostorAtlas *impostors, int impostor, Camera camera, Vector3 origin);  // Draw visible planes and bullets, world positions minus origin, far planes as impostor row impostor, inside BeginMode3D
+void DisconnectNetClient(NetClient *client);                               // Tell the server, close the socket and free the snapshots
+
+#endif // NETCLIENT_H
@@ -0,0 +1,172 @@
+// NetInterest.c
+#include "NetInterest.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool GrowNetInterestGrid(NetInterestGrid *grid, int count);
+static int FindCell(const NetInterestGrid *grid, int x, int z);
+static int CompareIndices(const void *a, const void *b);
+
+static inline unsigned int HashCell(int x, int z) {
+    return ((unsigned int)x * 73856093u) ^ ((unsigned int)z * 19349663u);
+}
+
+void InitNetInterestGrid(NetInterestGrid *grid, float cellSize) {
+    memset(grid, 0, sizeof(NetInterestGrid));
+    grid->cellSize = cellSize;
+}
+
+void BuildNetInterestGrid(NetInterestGrid *grid, const NetSnapshot *world) {
+    if ((world->count > grid->capacity || grid->tableSize == 0) && !GrowNetInterestGrid(grid, world->count)) return;
+
+    memset(grid->cellCount, 0, grid->tableSize * sizeof(int));
+    grid->cellsUsed = 0;
+
+    unsigned int mask = (unsigned int)grid->tableSize - 1u;
+    float stepsPerCell = NET_POSITION_SCALE * grid->cellSize;
+
+    for (int i = 0; i < world->count; i++) {
+        const NetEntity *entity = &world->entities[i];
+        int x = (int)floorf((float)entity->x / stepsPerCell);
+        int z = (int)floorf((float)entity->z / stepsPerCell);
+
+        // Linear probing, an empty slot is one with no entities
+        unsigned int slot = HashCell(x, z) & mask;
+        while (grid->cellCount[slot] > 0 && (grid->cellX[slot] != x || grid->cellZ[slot] != z)) slot = (slot + 1u) & mask;
+        if (grid->cellCount[slot] == 0) {
+            grid->cellX[slot] = x;
+            grid->cellZ[slot] = z;
+            grid->cellsUsed++;
+        }
+        grid->cellCount[slot]++;
+        grid->entitySlot[i] = (int)slot;
+    }
+
+    int start = 0;
+    for (int slot = 0; slot < grid->tableSize; slot++) {
+        grid->cellStart[slot] = start;
+        start += grid->cellCount[slot];
+    }
+
+    // Filled in world order, so every cell lists its entities by ascending id
+    for (int i = 0; i < world->count; i++) grid->order[grid->cellStart[grid->entitySlot[i]]++] = i;
+    for (int slot = 0; slot < grid->tableSize; slot++) grid->cellStart[slot] -= grid->cellCount[slot];
+}
+
+int SelectNetInterest(NetInterestGrid *grid, const NetSnapshot *world, const NetSnapshot *baseline, Vector3 position, float distance, uint32_t sequence, NetSnapshot *result) {
+    ClearNetSnapshot(result);
+    result->sequence = sequence;
+    if (grid->tableSize == 0) return 0;
+
+    // The window is every chunk the square around position touches, as terrain streaming rounds it
+    int minX = (int)floorf((position.x - distance) / grid->cellSize);
+    int maxX = (int)floorf((position.x + distance) / grid->cellSize);
+    int minZ = (int)floorf((position.z - distance) / grid->cellSize);
+    int maxZ = (int)floorf((position.z + distance) / grid->cellSize);
+
+    int gathered = 0;
+    if ((long long)(maxX - minX + 1) * (maxZ - minZ + 1) <= grid->cellsUsed) {
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int x = minX; x <= maxX; x++) {
+                int slot = FindCell(grid, x, z);
+                if (slot < 0) continue;
+                memcpy(&grid->gathered[gathered], &grid->order[grid->cellStart[slot]], grid->cellCount[slot] * sizeof(int));
+                gathered += grid->cellCount[slot];
+            }
+        }
+    } else {
+        // A window wider than the occupied cells is cheaper to test cell by cell
+        for (int slot = 0; slot < grid->tableSize; slot++) {
+            if (grid->cellCount[slot] == 0) continue;
+            if (grid->cellX[slot] < minX || grid->cellX[slot] > maxX || grid->cellZ[slot] < minZ || grid->cellZ[slot] > maxZ) continue;
+            memcpy(&grid->gathered[gathered], &grid->order[grid->cellStart[slot]], grid->cellCount[slot] * sizeof(int));
+            gathered += grid->cellCount[slot];
+        }
+    }
+
+    // World order is id order, which the delta encoder merges on
+    qsort(grid->gathered, gathered, sizeof(int), CompareIndices);
+
+    float nearSquared = NET_INTEREST_NEAR * NET_INTEREST_NEAR;
+    float midSquared = NET_INTEREST_MID * NET_INTEREST_MID;
+    int due = 0;
+    int b = 0;
+
+    for (int k = 0; k < gathered; k++) {
+        const NetEntity *entity = &world->entities[grid->gathered[k]];
+        float dx = entity->x / NET_POSITION_SCALE - position.x;
+        float dy = entity->y / NET_POSITION_SCALE - position.y;
+        float dz = entity->z / NET_POSITION_SCALE - position.z;
+        float distanceSquared = dx * dx + dy * dy + dz * dz;
+
+        // Farther entities refresh less often, staggered by id so each tick carries a share of them
+        uint32_t interval = distanceSquared < nearSquared ? 1 : (distanceSquared < midSquared ? NET_INTEREST_MID_INTERVAL : NET_INTEREST_FAR_INTERVAL);
+        if (interval > 1 && baseline && (sequence + entity->id) % interval != 0) {
+            while (b < baseline->count && baseline->entities[b].id < entity->id) b++;
+            if (b < baseline->count && baseline->entities[b].id == entity->id) {
+                PushNetEntity(result, baseline->entities[b]);
+                continue;
+            }
+        }
+
+        PushNetEntity(result, *entity);
+        due++;
+    }
+
+    return due;
+}
+
+void UnloadNetInterestGrid(NetInterestGrid *grid) {
+    free(grid->cellX);
+    free(grid->cellZ);
+    free(grid->cellStart);
+    free(grid->cellCount);
+    free(grid->entitySlot);
+    free(grid->order);
+    free(grid->gathered);
+
+    float cellSize = grid->cellSize;
+    memset(grid, 0, sizeof(NetInterestGrid));
+    grid->cellSize = cellSize;
+}
+
+static bool GrowNetInterestGrid(NetInterestGrid *grid, int count) {
+    int capacity = grid->capacity > 0 ? grid->capacity : 256;
+    while (capacity < count) capacity *= 2;
+    int tableSize = 1;
+    while (tableSize < capacity * 2) tableSize *= 2;
+
+    // Nothing survives a rebuild, so the old arrays are simply replaced
+    UnloadNetInterestGrid(grid);
+    grid->cellX = (int *)malloc(tableSize * sizeof(int));
+    grid->cellZ = (int *)malloc(tableSize * sizeof(int));
+    grid->cellStart = (int *)malloc(tableSize * sizeof(int));
+    grid->cellCount = (int *)malloc(tableSize * sizeof(int));
+    grid->entitySlot = (int *)malloc(capacity * sizeof(int));
+    grid->order = (int *)malloc(capacity * sizeof(int));
+    grid->gathered = (int *)malloc(capacity * sizeof(int));
+    if (!grid->cellX || !grid->cellZ || !grid->cellStart || !grid->cellCount || !grid->entitySlot || !grid->order || !grid->gathered) {
+        UnloadNetInterestGrid(grid);
+        return false;
+    }
+
+    grid->capacity = capacity;
+    grid->tableSize = tableSize;
+    return true;
+}
+
+static int FindCell(const NetInterestGrid *grid, int x, int z) {
+    unsigned int mask = (unsigned int)grid->tableSize - 1u;
+    unsigned int slot = HashCell(x, z) & mask;
+
+    while (grid->cellCount[slot] > 0) {
+        if (grid->cellX[slot] == x && grid->cellZ[slot] == z) return (int)slot;
+        slot = (slot + 1u) & mask;
+    }
+    return -1;
+}
+
+static int CompareIndices(const void *a, const void *b) {
+    return *(const int *)a - *(const int *)b;
+}
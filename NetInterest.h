@@ -0,0 +1,37 @@
+// NetInterest.h
+#ifndef NETINTEREST_H
+#define NETINTEREST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "NetSnapshot.h"
+
+#define NET_INTEREST_NEAR           250.0f  // Entities this close are sent every tick
+#define NET_INTEREST_MID            500.0f  // Up to here every NET_INTEREST_MID_INTERVAL ticks
+#define NET_INTEREST_MID_INTERVAL   2
+#define NET_INTEREST_FAR_INTERVAL   4       // The rest of the window
+
+// Snapshot entities bucketed by terrain chunk, in the absolute chunk coordinates UpdateTerrain
+// streams. Cells live in an open-addressed table rebuilt every tick, so the world needs no bounds.
+typedef struct NetInterestGrid {
+    float cellSize;             // World units per cell, one terrain chunk
+    int capacity;               // Entities the arrays hold
+    int tableSize;              // Slots, a power of two at least twice capacity
+    int *cellX;                 // Chunk coordinate of each slot
+    int *cellZ;
+    int *cellStart;             // First entry of each slot in order
+    int *cellCount;             // Entities in each slot, 0 for an empty slot
+    int *entitySlot;            // Slot of each world entity
+    int *order;                 // World entity indices grouped by cell
+    int *gathered;              // Scratch for one client's window
+    int cellsUsed;              // Occupied slots after the last build
+} NetInterestGrid;
+
+// Function declarations
+void InitNetInterestGrid(NetInterestGrid *grid, float cellSize);                   // Empty grid of cellSize chunks
+void BuildNetInterestGrid(NetInterestGrid *grid, const NetSnapshot *world);         // Bucket every world entity by chunk
+int SelectNetInterest(NetInterestGrid *grid, const NetSnapshot *world, const NetSnapshot *baseline, Vector3 position, float distance, uint32_t sequence, NetSnapshot *result);  // Entities in the chunks within distance of position, the ones not due this tick as baseline holds them, returns how many are due
+void UnloadNetInterestGrid(NetInterestGrid *grid);
+
+#endif // NETINTEREST_H
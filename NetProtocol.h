@@ -0,0 +1,53 @@
+// NetProtocol.h
+#ifndef NETPROTOCOL_H
+#define NETPROTOCOL_H
+
+#include <stdint.h>
+
+// UDP protocol between tools/server and its clients. Every packet starts with
+// NetPacketHeader, values are little-endian.
+//
+//  client -> server  NET_PACKET_CONNECT     header only, repeated until accepted
+//  server -> client  NET_PACKET_ACCEPT      header, uint32 client slot, uint32 world size, world bytes
+//  client -> server  NET_PACKET_ACK         header, uint32 newest decoded snapshot, float x/y/z world position
+//  server -> client  NET_PACKET_SNAPSHOT    header, uint32 sequence, uint32 baseline, bit-packed delta (NetSnapshot.c)
+//  either way        NET_PACKET_DISCONNECT  header only
+//
+// A snapshot is delta-encoded against the newest one the client acknowledged, baseline 0
+// means against an empty world. Lost snapshots need no resend, the next one is simply
+// encoded against an older baseline.
+//
+// The world bytes are opaque to the protocol. The terrain demo and tools/server put a
+// serialized WorldDescriptor there (Terrain/WorldDescriptor.h), so clients generate the
+// server's terrain from its seed instead of receiving it.
+
+#define NET_PROTOCOL_MAGIC      0x504E4D46u // "FMNP"
+#define NET_PROTOCOL_VERSION    2           // Bump on any change to the packets or the encoding
+#define NET_DEFAULT_PORT        27960
+#define NET_MAX_CLIENTS         64
+#define NET_TICK_RATE           30          // Snapshots per second
+#define NET_SNAPSHOT_HISTORY    32          // Snapshots kept per client, older acks fall back to a full snapshot
+#define NET_MAX_PACKET          8192        // Bytes per datagram, entities that do not fit wait for the next snapshot
+#define NET_TIMEOUT             5.0         // Seconds of silence after which a client is dropped
+#define NET_CONNECT_RETRY       0.5         // Seconds between connect attempts
+#define NET_MAX_WORLD           256         // Bytes of world description sent with the accept
+
+#define NET_POSITION_SCALE      8.0f        // Quantisation steps per world unit
+#define NET_ORIENTATION_BITS    10          // Bits per smallest-three quaternion component
+#define NET_BULLET_ID           0x80000000u // Set in the id of bullets, bullet i belongs to aircraft i
+
+typedef enum NetPacketType {
+    NET_PACKET_CONNECT = 1,
+    NET_PACKET_ACCEPT,
+    NET_PACKET_ACK,
+    NET_PACKET_SNAPSHOT,
+    NET_PACKET_DISCONNECT
+} NetPacketType;
+
+typedef struct NetPacketHeader {
+    uint32_t magic;             // NET_PROTOCOL_MAGIC
+    uint16_t version;           // NET_PROTOCOL_VERSION
+    uint16_t type;              // NetPacketType
+} NetPacketHeader;
+
+#endif // NETPROTOCOL_H
@@ -0,0 +1,205 @@
+// NetServer.c
+#include "NetServer.h"
+#include <string.h>
+
+static void SendNetHeader(NetServer *server, NetAddress to, NetPacketType type);
+static void SendNetAccept(NetServer *server, NetServerClient *client);
+static NetServerClient *FindNetClient(NetServer *server, NetAddress address);
+static void DropNetClient(NetServer *server, NetServerClient *client);
+
+bool InitNetServer(NetServer *server, uint16_t port) {
+    memset(server, 0, sizeof(NetServer));
+    InitNetInterestGrid(&server->interest, 1.0f);
+    InitNetSnapshot(&server->selected);
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        for (int h = 0; h < NET_SNAPSHOT_HISTORY; h++) InitNetSnapshot(&server->clients[i].history[h]);
+    }
+
+    if (!OpenNetSocket(&server->socket, port)) {
+        TraceLog(LOG_WARNING, "NET: Could not listen on port %d", port);
+        return false;
+    }
+    return true;
+}
+
+void SetNetServerInterest(NetServer *server, float chunkSize, float distance) {
+    UnloadNetInterestGrid(&server->interest);
+    InitNetInterestGrid(&server->interest, chunkSize);
+    server->interestDistance = distance;
+}
+
+void SetNetServerWorld(NetServer *server, const void *world, int size) {
+    if (size > NET_MAX_WORLD) size = NET_MAX_WORLD;
+    memcpy(server->world, world, size);
+    server->worldSize = size;
+}
+
+void PollNetServer(NetServer *server, double time) {
+    uint8_t packet[NET_MAX_PACKET];
+    NetAddress from;
+    int size;
+
+    while ((size = ReceiveNetPacket(&server->socket, &from, packet, sizeof(packet))) > 0) {
+        server->bytesReceived += size;
+
+        NetBitReader reader;
+        InitNetBitReader(&reader, packet, size);
+        uint32_t magic = ReadNetBits(&reader, 32);
+        uint32_t version = ReadNetBits(&reader, 16);
+        uint32_t type = ReadNetBits(&reader, 16);
+        if (reader.overflow || magic != NET_PROTOCOL_MAGIC || version != NET_PROTOCOL_VERSION) continue;
+
+        NetServerClient *client = FindNetClient(server, from);
+
+        if (type == NET_PACKET_CONNECT) {
+            // Repeated connects just repeat the accept, it may have been lost
+            if (!client) {
+                for (int i = 0; i < NET_MAX_CLIENTS && !client; i++) {
+                    if (!server->clients[i].connected) client = &server->clients[i];
+                }
+                if (!client) continue;
+
+                client->connected = true;
+                client->address = from;
+                client->ackedSequence = 0;
+                client->position = (Vector3){ 0.0f, 0.0f, 0.0f };
+                client->bytesSent = 0;
+                client->snapshotsSent = 0;
+                client->fullSnapshots = 0;
+                for (int h = 0; h < NET_SNAPSHOT_HISTORY; h++) ClearNetSnapshot(&client->history[h]);
+                server->clientCount++;
+            }
+            client->lastHeard = time;
+            SendNetAccept(server, client);
+            continue;
+        }
+        if (!client) continue;
+        client->lastHeard = time;
+
+        if (type == NET_PACKET_ACK) {
+            uint32_t sequence = ReadNetBits(&reader, 32);
+            Vector3 position;
+            uint32_t bits[3] = { ReadNetBits(&reader, 32), ReadNetBits(&reader, 32), ReadNetBits(&reader, 32) };
+            memcpy(&position.x, &bits[0], sizeof(float));
+            memcpy(&position.y, &bits[1], sizeof(float));
+            memcpy(&position.z, &bits[2], sizeof(float));
+            if (reader.overflow) continue;
+
+            // Acks can arrive out of order, only a newer one moves the baseline forward
+            const NetSnapshot *acked = &client->history[sequence % NET_SNAPSHOT_HISTORY];
+            if (sequence > client->ackedSequence && sequence <= server->sequence && acked->sequence == sequence) {
+                client->ackedSequence = sequence;
+            }
+            client->position = position;
+        } else if (type == NET_PACKET_DISCONNECT) {
+            DropNetClient(server, client);
+        }
+    }
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        NetServerClient *client = &server->clients[i];
+        if (client->connected && time - client->lastHeard > NET_TIMEOUT) DropNetClient(server, client);
+    }
+}
+
+void SendNetSnapshots(NetServer *server, const NetSnapshot *world) {
+    double start = GetNetClock();
+    uint8_t packet[NET_MAX_PACKET];
+    uint32_t sequence = ++server->sequence;
+    if (server->interestDistance > 0.0f) BuildNetInterestGrid(&server->interest, world);
+
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        NetServerClient *client = &server->clients[i];
+        if (!client->connected) continue;
+
+        // The acknowledged snapshot is the baseline, unless it has already left the history
+        const NetSnapshot *baseline = NULL;
+        const NetSnapshot *acked = &client->history[client->ackedSequence % NET_SNAPSHOT_HISTORY];
+        if (client->ackedSequence != 0 && sequence - client->ackedSequence < NET_SNAPSHOT_HISTORY && acked->sequence == client->ackedSequence) {
+            baseline = acked;
+        }
+
+        NetBitWriter writer;
+        InitNetBitWriter(&writer, packet, sizeof(packet));
+        WriteNetBits(&writer, NET_PROTOCOL_MAGIC, 32);
+        WriteNetBits(&writer, NET_PROTOCOL_VERSION, 16);
+        WriteNetBits(&writer, NET_PACKET_SNAPSHOT, 16);
+        WriteNetBits(&writer, sequence, 32);
+        WriteNetBits(&writer, baseline ? baseline->sequence : 0, 32);
+
+        // Only the client's chunk window, with far entities not due this tick left as it holds them
+        NetSnapshot *sent = &client->history[sequence % NET_SNAPSHOT_HISTORY];
+        NetSnapshot current = *world;
+        current.sequence = sequence;
+        client->interestCount = world->count;
+        client->entitiesDue = world->count;
+        if (server->interestDistance > 0.0f) {
+            client->entitiesDue = SelectNetInterest(&server->interest, world, baseline, client->position, server->interestDistance, sequence, &server->selected);
+            client->interestCount = server->selected.count;
+            current = server->selected;
+        }
+        WriteNetSnapshotDelta(&writer, baseline, &current, sent);
+
+        int size = GetNetBitWriterBytes(&writer);
+        SendNetPacket(&server->socket, client->address, packet, size);
+        client->bytesSent += size;
+        client->snapshotsSent++;
+        if (!baseline) client->fullSnapshots++;
+        server->bytesSent += size;
+    }
+
+    server->sendTime = GetNetClock() - start;
+}
+
+void UnloadNetServer(NetServer *server) {
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        NetServerClient *client = &server->clients[i];
+        if (client->connected) SendNetHeader(server, client->address, NET_PACKET_DISCONNECT);
+        for (int h = 0; h < NET_SNAPSHOT_HISTORY; h++) UnloadNetSnapshot(&client->history[h]);
+    }
+    UnloadNetInterestGrid(&server->interest);
+    UnloadNetSnapshot(&server->selected);
+    CloseNetSocket(&server->socket);
+}
+
+static void SendNetHeader(NetServer *server, NetAddress to, NetPacketType type) {
+    uint8_t packet[16];
+    NetBitWriter writer;
+    InitNetBitWriter(&writer, packet, sizeof(packet));
+    WriteNetBits(&writer, NET_PROTOCOL_MAGIC, 32);
+    WriteNetBits(&writer, NET_PROTOCOL_VERSION, 16);
+    WriteNetBits(&writer, type, 16);
+
+    int size = GetNetBitWriterBytes(&writer);
+    SendNetPacket(&server->socket, to, packet, size);
+    server->bytesSent += size;
+}
+
+static void SendNetAccept(NetServer *server, NetServerClient *client) {
+    uint8_t packet[16 + NET_MAX_WORLD];
+    NetBitWriter writer;
+    InitNetBitWriter(&writer, packet, sizeof(packet));
+    WriteNetBits(&writer, NET_PROTOCOL_MAGIC, 32);
+    WriteNetBits(&writer, NET_PROTOCOL_VERSION, 16);
+    WriteNetBits(&writer, NET_PACKET_ACCEPT, 16);
+    WriteNetBits(&writer, (uint32_t)(client - server->clients), 32);
+    WriteNetBits(&writer, (uint32_t)server->worldSize, 32);
+    for (int i = 0; i < server->worldSize; i++) WriteNetBits(&writer, server->world[i], 8);
+
+    int size = GetNetBitWriterBytes(&writer);
+    SendNetPacket(&server->socket, client->address, packet, size);
+    server->bytesSent += size;
+}
+
+static NetServerClient *FindNetClient(NetServer *server, NetAddress address) {
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+        NetServerClient *client = &server->clients[i];
+        if (client->connected && IsSameNetAddress(client->address, address)) return client;
+    }
+    return NULL;
+}
+
+static void DropNetClient(NetServer *server, NetServerClient *client) {
+    client->connected = false;
+    server->clientCount--;
+}
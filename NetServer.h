@@ -0,0 +1,51 @@
+// NetServer.h
+#ifndef NETSERVER_H
+#define NETSERVER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "NetInterest.h"
+#include "NetProtocol.h"
+#include "NetSnapshot.h"
+#include "NetSocket.h"
+
+typedef struct NetServerClient {
+    bool connected;
+    NetAddress address;
+    uint32_t ackedSequence;     // Newest snapshot the client decoded, 0 for none yet
+    double lastHeard;           // GetNetClock time of its last packet
+    Vector3 position;           // World position it reported with its last ack
+    NetSnapshot history[NET_SNAPSHOT_HISTORY];  // What the client holds once it decodes each snapshot, by sequence
+    long long bytesSent;
+    int snapshotsSent;
+    int fullSnapshots;          // Sent against an empty baseline, first contact or too many losses
+    int interestCount;          // Entities in its window last tick
+    int entitiesDue;            // Of those, entities whose update was due
+} NetServerClient;
+
+// Authoritative end: owns the socket and one delta baseline history per client
+typedef struct NetServer {
+    NetSocket socket;
+    NetServerClient clients[NET_MAX_CLIENTS];
+    int clientCount;            // Connected clients
+    uint32_t sequence;          // Of the last snapshot sent
+    long long bytesSent;
+    long long bytesReceived;
+    double sendTime;            // Seconds the last SendNetSnapshots took, encoding included
+    float interestDistance;     // Clients get entities in the chunks this close, 0 sends everything
+    NetInterestGrid interest;   // World entities by chunk, rebuilt every snapshot
+    NetSnapshot selected;       // One client's share of the world, reused
+    uint8_t world[NET_MAX_WORLD];  // Sent to every client with its accept
+    int worldSize;
+} NetServer;
+
+// Function declarations
+bool InitNetServer(NetServer *server, uint16_t port);                      // Listen on localhost, false if the port is taken
+void SetNetServerInterest(NetServer *server, float chunkSize, float distance);  // Send each client only the chunks within distance of it, 0 sends everything
+void SetNetServerWorld(NetServer *server, const void *world, int size);    // Describe the world to clients as they connect, at most NET_MAX_WORLD bytes
+void PollNetServer(NetServer *server, double time);                        // Handle connects, acks and disconnects, drop silent clients
+void SendNetSnapshots(NetServer *server, const NetSnapshot *world);        // Encode world for every client against what it acknowledged
+void UnloadNetServer(NetServer *server);                                   // Tell clients, close the socket and free the histories
+
+#endif // NETSERVER_H
@@ -0,0 +1,299 @@
+// NetSnapshot.c
+#include "NetSnapshot.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bits after each 2-bit size class, zigzag deltas and id gaps both use the same scheme
+static const int deltaBits[4] = { 0, 7, 15, 32 };   // Unchanged, under 8 units, under 2048 units, anything
+static const int gapBits[4] = { 0, 4, 12, 32 };     // Next id, a few skipped, many skipped, anything
+
+static void RewindNetBits(NetBitWriter *writer, int bitCount);
+static void WriteSizeClass(NetBitWriter *writer, uint32_t value, const int *bits);
+static uint32_t ReadSizeClass(NetBitReader *reader, const int *bits);
+static void WriteEntityRecord(NetBitWriter *writer, uint32_t nextId, const NetEntity *old, const NetEntity *now);
+static uint32_t PackOrientation(Quaternion q);
+
+// Deltas are zigzagged, so small negative steps are small numbers too
+static inline uint32_t ZigZag(uint32_t delta) { return (delta << 1) ^ (0u - (delta >> 31)); }
+static inline uint32_t UnZigZag(uint32_t value) { return (value >> 1) ^ (0u - (value & 1u)); }
+
+void InitNetBitWriter(NetBitWriter *writer, void *data, int capacity) {
+    memset(data, 0, capacity);
+    writer->data = (uint8_t *)data;
+    writer->capacity = capacity;
+    writer->bitCount = 0;
+    writer->overflow = false;
+}
+
+void WriteNetBits(NetBitWriter *writer, uint32_t value, int bits) {
+    if (writer->overflow || writer->bitCount + bits > writer->capacity * 8) {
+        writer->overflow = true;
+        return;
+    }
+
+    // The bytes ahead are still zero, so the value can be ORed in a byte at a time
+    int offset = writer->bitCount & 7;
+    uint64_t shifted = (uint64_t)(bits < 32 ? value & ((1u << bits) - 1u) : value) << offset;
+    uint8_t *byte = &writer->data[writer->bitCount >> 3];
+    for (int i = 0; i < offset + bits; i += 8) *byte++ |= (uint8_t)(shifted >> i);
+
+    writer->bitCount += bits;
+}
+
+int GetNetBitWriterBytes(const NetBitWriter *writer) {
+    return (writer->bitCount + 7) / 8;
+}
+
+void InitNetBitReader(NetBitReader *reader, const void *data, int size) {
+    reader->data = (const uint8_t *)data;
+    reader->size = size;
+    reader->bitCount = 0;
+    reader->overflow = false;
+}
+
+uint32_t ReadNetBits(NetBitReader *reader, int bits) {
+    if (reader->overflow || reader->bitCount + bits > reader->size * 8) {
+        reader->overflow = true;
+        return 0;
+    }
+
+    int offset = reader->bitCount & 7;
+    const uint8_t *byte = &reader->data[reader->bitCount >> 3];
+    uint64_t value = 0;
+    for (int i = 0; i < offset + bits; i += 8) value |= (uint64_t)*byte++ << i;
+
+    reader->bitCount += bits;
+    value >>= offset;
+    return bits < 32 ? (uint32_t)value & ((1u << bits) - 1u) : (uint32_t)value;
+}
+
+void InitNetSnapshot(NetSnapshot *snapshot) {
+    memset(snapshot, 0, sizeof(NetSnapshot));
+}
+
+void ClearNetSnapshot(NetSnapshot *snapshot) {
+    snapshot->sequence = 0;
+    snapshot->count = 0;
+}
+
+void PushNetEntity(NetSnapshot *snapshot, NetEntity entity) {
+    if (snapshot->count == snapshot->capacity) {
+        int capacity = snapshot->capacity > 0 ? snapshot->capacity * 2 : NET_SNAPSHOT_INITIAL_CAPACITY;
+        NetEntity *entities = (NetEntity *)realloc(snapshot->entities, capacity * sizeof(NetEntity));
+        if (!entities) return;
+        snapshot->entities = entities;
+        snapshot->capacity = capacity;
+    }
+    snapshot->entities[snapshot->count++] = entity;
+}
+
+void CopyNetSnapshot(NetSnapshot *destination, const NetSnapshot *source) {
+    ClearNetSnapshot(destination);
+    for (int i = 0; i < source->count; i++) PushNetEntity(destination, source->entities[i]);
+    destination->sequence = source->sequence;
+}
+
+void UnloadNetSnapshot(NetSnapshot *snapshot) {
+    free(snapshot->entities);
+    memset(snapshot, 0, sizeof(NetSnapshot));
+}
+
+NetEntity QuantiseNetEntity(uint32_t id, Vector3 position, Quaternion orientation) {
+    NetEntity entity;
+    entity.id = id;
+    entity.x = (int32_t)floorf(position.x * NET_POSITION_SCALE + 0.5f);
+    entity.y = (int32_t)floorf(position.y * NET_POSITION_SCALE + 0.5f);
+    entity.z = (int32_t)floorf(position.z * NET_POSITION_SCALE + 0.5f);
+    entity.orientation = (id & NET_BULLET_ID) ? 0 : PackOrientation(orientation);
+    return entity;
+}
+
+Vector3 GetNetEntityPosition(const NetEntity *entity) {
+    return (Vector3){ entity->x / NET_POSITION_SCALE, entity->y / NET_POSITION_SCALE, entity->z / NET_POSITION_SCALE };
+}
+
+Quaternion GetNetEntityOrientation(const NetEntity *entity) {
+    if (entity->id & NET_BULLET_ID) return (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f };
+
+    // The three smallest components lie within +-1/sqrt(2), the largest is rebuilt from unit length
+    const float range = (float)((1 << NET_ORIENTATION_BITS) - 1);
+    int largest = (int)(entity->orientation & 3u);
+    float c[4];
+    float sum = 0.0f;
+    int shift = 2;
+    for (int i = 0; i < 4; i++) {
+        if (i == largest) continue;
+        uint32_t step = (entity->orientation >> shift) & ((1u << NET_ORIENTATION_BITS) - 1u);
+        c[i] = ((float)step / range - 0.5f) * 1.41421356f;
+        sum += c[i] * c[i];
+        shift += NET_ORIENTATION_BITS;
+    }
+    c[largest] = sqrtf(sum < 1.0f ? 1.0f - sum : 0.0f);
+
+    return (Quaternion){ c[0], c[1], c[2], c[3] };
+}
+
+int WriteNetSnapshotDelta(NetBitWriter *writer, const NetSnapshot *baseline, const NetSnapshot *current, NetSnapshot *sent) {
+    static const NetSnapshot empty = { 0 };
+    if (!baseline) baseline = &empty;
+
+    ClearNetSnapshot(sent);
+    sent->sequence = current->sequence;
+
+    int written = 0;
+    bool full = false;
+    uint32_t nextId = 0;        // Id the next record's gap is counted from
+    int b = 0, c = 0;
+
+    // Both lists are sorted by id, so one merge finds the changed, new and removed entities
+    while (b < baseline->count || c < current->count) {
+        const NetEntity *old = b < baseline->count ? &baseline->entities[b] : NULL;
+        const NetEntity *now = c < current->count ? &current->entities[c] : NULL;
+        if (now && (!old || now->id <= old->id)) {
+            c++;
+            if (old && old->id == now->id) b++;
+            else old = NULL;
+        } else {
+            b++;
+            now = NULL;
+        }
+
+        if (old && now && old->x == now->x && old->y == now->y && old->z == now->z && old->orientation == now->orientation) {
+            PushNetEntity(sent, *now);
+            continue;
+        }
+
+        // A record that does not fit is taken back, one bit always stays free for the end marker
+        if (!full) {
+            int mark = writer->bitCount;
+            WriteEntityRecord(writer, nextId, old, now);
+            if (!writer->overflow && writer->bitCount < writer->capacity * 8) {
+                nextId = (now ? now->id : old->id) + 1;
+                written++;
+                if (now) PushNetEntity(sent, *now);
+                continue;
+            }
+            RewindNetBits(writer, mark);
+            full = true;
+        }
+
+        // Left out, the receiver keeps what the baseline had and a later snapshot catches up
+        if (old) PushNetEntity(sent, *old);
+    }
+
+    WriteNetBits(writer, 0, 1);
+    return written;
+}
+
+bool ReadNetSnapshotDelta(NetBitReader *reader, const NetSnapshot *baseline, NetSnapshot *result) {
+    static const NetSnapshot empty = { 0 };
+    if (!baseline) baseline = &empty;
+
+    ClearNetSnapshot(result);
+
+    uint32_t nextId = 0;
+    int b = 0;
+    while (ReadNetBits(reader, 1)) {
+        uint32_t id = nextId + ReadSizeClass(reader, gapBits);
+        bool removed = ReadNetBits(reader, 1) != 0;
+        if (reader->overflow || id < nextId) return false;
+
+        // Entities the record skipped over did not change
+        while (b < baseline->count && baseline->entities[b].id < id) PushNetEntity(result, baseline->entities[b++]);
+
+        NetEntity entity = { id, 0, 0, 0, 0 };
+        if (b < baseline->count && baseline->entities[b].id == id) entity = baseline->entities[b++];
+        nextId = id + 1;
+        if (removed) continue;
+
+        entity.x = (int32_t)((uint32_t)entity.x + UnZigZag(ReadSizeClass(reader, deltaBits)));
+        entity.y = (int32_t)((uint32_t)entity.y + UnZigZag(ReadSizeClass(reader, deltaBits)));
+        entity.z = (int32_t)((uint32_t)entity.z + UnZigZag(ReadSizeClass(reader, deltaBits)));
+        if (!(id & NET_BULLET_ID) && ReadNetBits(reader, 1)) entity.orientation = ReadNetBits(reader, 32);
+        if (reader->overflow) return false;
+
+        PushNetEntity(result, entity);
+    }
+    while (b < baseline->count) PushNetEntity(result, baseline->entities[b++]);
+
+    return !reader->overflow;
+}
+
+// Clear everything written after bitCount, so later writes can OR into zeroed bytes again
+static void RewindNetBits(NetBitWriter *writer, int bitCount) {
+    int end = GetNetBitWriterBytes(writer);
+    int byte = bitCount >> 3;
+
+    if (byte < end) {
+        writer->data[byte] &= (uint8_t)((1u << (bitCount & 7)) - 1u);
+        memset(&writer->data[byte + 1], 0, end - byte - 1);
+    }
+    writer->bitCount = bitCount;
+    writer->overflow = false;
+}
+
+// The smallest of the four sizes that holds value
+static void WriteSizeClass(NetBitWriter *writer, uint32_t value, const int *bits) {
+    int size = 3;
+    for (int i = 0; i < 3; i++) {
+        if ((value >> bits[i]) == 0) {
+            size = i;
+            break;
+        }
+    }
+    WriteNetBits(writer, (uint32_t)size, 2);
+    if (bits[size] > 0) WriteNetBits(writer, value, bits[size]);
+}
+
+static uint32_t ReadSizeClass(NetBitReader *reader, const int *bits) {
+    int size = (int)ReadNetBits(reader, 2);
+    return bits[size] > 0 ? ReadNetBits(reader, bits[size]) : 0;
+}
+
+static void WriteEntityRecord(NetBitWriter *writer, uint32_t nextId, const NetEntity *old, const NetEntity *now) {
+    uint32_t id = now ? now->id : old->id;
+
+    WriteNetBits(writer, 1, 1);
+    WriteSizeClass(writer, id - nextId, gapBits);
+    WriteNetBits(writer, now ? 0 : 1, 1);
+    if (!now) return;
+
+    // New entities are encoded against zero, the first snapshot of them is the expensive one
+    NetEntity base = old ? *old : (NetEntity){ id, 0, 0, 0, 0 };
+    uint32_t deltas[3] = {
+        (uint32_t)now->x - (uint32_t)base.x,
+        (uint32_t)now->y - (uint32_t)base.y,
+        (uint32_t)now->z - (uint32_t)base.z
+    };
+    for (int i = 0; i < 3; i++) WriteSizeClass(writer, ZigZag(deltas[i]), deltaBits);
+
+    if (!(id & NET_BULLET_ID)) {
+        bool turned = now->orientation != base.orientation;
+        WriteNetBits(writer, turned ? 1 : 0, 1);
+        if (turned) WriteNetBits(writer, now->orientation, 32);
+    }
+}
+
+static uint32_t PackOrientation(Quaternion q) {
+    float c[4] = { q.x, q.y, q.z, q.w };
+    int largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(c[i]) > fabsf(c[largest])) largest = i;
+    }
+
+    // q and -q are the same rotation, flipping keeps the dropped component positive
+    float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+    const float range = (float)((1 << NET_ORIENTATION_BITS) - 1);
+    uint32_t packed = (uint32_t)largest;
+    int shift = 2;
+    for (int i = 0; i < 4; i++) {
+        if (i == largest) continue;
+        float unit = c[i] * sign * 0.70710678f + 0.5f;
+        unit = unit < 0.0f ? 0.0f : (unit > 1.0f ? 1.0f : unit);
+        packed |= (uint32_t)(unit * range + 0.5f) << shift;
+        shift += NET_ORIENTATION_BITS;
+    }
+
+    return packed;
+}
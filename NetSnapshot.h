@@ -0,0 +1,64 @@
+// NetSnapshot.h
+#ifndef NETSNAPSHOT_H
+#define NETSNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "raylib.h"
+#include "NetProtocol.h"
+
+#define NET_SNAPSHOT_INITIAL_CAPACITY 256
+
+// Quantised state of one plane or bullet, exactly what a client can reconstruct
+typedef struct NetEntity {
+    uint32_t id;                // Aircraft index, NET_BULLET_ID set for its bullet
+    int32_t x;                  // World position in 1/NET_POSITION_SCALE steps
+    int32_t y;
+    int32_t z;
+    uint32_t orientation;       // Smallest-three quaternion, 0 for bullets
+} NetEntity;
+
+// World state at one tick, entities sorted by id so two snapshots merge in one pass
+typedef struct NetSnapshot {
+    uint32_t sequence;          // Tick it was taken, 0 for none
+    int count;
+    int capacity;
+    NetEntity *entities;
+} NetSnapshot;
+
+// Packs values least significant bit first, whole bytes end up little-endian
+typedef struct NetBitWriter {
+    uint8_t *data;
+    int capacity;               // Bytes
+    int bitCount;               // Bits written
+    bool overflow;              // A write did not fit and was dropped
+} NetBitWriter;
+
+typedef struct NetBitReader {
+    const uint8_t *data;
+    int size;                   // Bytes
+    int bitCount;               // Bits read
+    bool overflow;              // A read ran past the end and returned 0
+} NetBitReader;
+
+// Function declarations
+void InitNetBitWriter(NetBitWriter *writer, void *data, int capacity);         // Clear data and start writing at its first bit
+void WriteNetBits(NetBitWriter *writer, uint32_t value, int bits);              // Append the low bits of value, up to 32
+int GetNetBitWriterBytes(const NetBitWriter *writer);                           // Bytes touched so far
+void InitNetBitReader(NetBitReader *reader, const void *data, int size);
+uint32_t ReadNetBits(NetBitReader *reader, int bits);                           // Next bits, up to 32
+
+void InitNetSnapshot(NetSnapshot *snapshot);                                    // Empty snapshot
+void ClearNetSnapshot(NetSnapshot *snapshot);                                   // Forget the entities, keeping the allocation
+void PushNetEntity(NetSnapshot *snapshot, NetEntity entity);                    // Append an entity, ids must increase
+void CopyNetSnapshot(NetSnapshot *destination, const NetSnapshot *source);
+void UnloadNetSnapshot(NetSnapshot *snapshot);
+
+NetEntity QuantiseNetEntity(uint32_t id, Vector3 position, Quaternion orientation);  // Orientation is ignored for bullets
+Vector3 GetNetEntityPosition(const NetEntity *entity);
+Quaternion GetNetEntityOrientation(const NetEntity *entity);
+
+int WriteNetSnapshotDelta(NetBitWriter *writer, const NetSnapshot *baseline, const NetSnapshot *current, NetSnapshot *sent);  // Encode what changed since baseline (NULL for none) until the writer is full, sent gets what the receiver will hold, returns entities written
+bool ReadNetSnapshotDelta(NetBitReader *reader, const NetSnapshot *baseline, NetSnapshot *result);  // Apply an encoded delta to baseline (NULL for none), false if the data is corrupt
+
+#endif // NETSNAPSHOT_H
@@ -0,0 +1,155 @@
+// NetSocket.c
+// Kept apart from raylib.h, windows.h redefines several raylib names
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200809L   // clock_gettime and nanosleep under -std=c99
+#endif
+
+#include "NetSocket.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    #include <windows.h>
+    typedef int socklen_t;
+#else
+    #include <arpa/inet.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <time.h>
+    #include <unistd.h>
+#endif
+
+#include <string.h>
+
+#if defined(_WIN32)
+static int openSockets = 0;     // WSAStartup is reference counted, so is this
+#endif
+
+bool OpenNetSocket(NetSocket *netSocket, uint16_t port) {
+    netSocket->handle = -1;
+    netSocket->port = 0;
+
+#if defined(_WIN32)
+    WSADATA data;
+    if (openSockets++ == 0 && WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        openSockets = 0;
+        return false;
+    }
+    SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == INVALID_SOCKET) {
+        if (--openSockets == 0) WSACleanup();
+        return false;
+    }
+#else
+    int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle < 0) return false;
+#endif
+    netSocket->handle = (intptr_t)handle;
+
+    // Snapshots for many clients go out in one burst, a small send buffer would drop them
+    int bufferSize = 1 << 20;
+    setsockopt(handle, SOL_SOCKET, SO_SNDBUF, (const char *)&bufferSize, sizeof(bufferSize));
+    setsockopt(handle, SOL_SOCKET, SO_RCVBUF, (const char *)&bufferSize, sizeof(bufferSize));
+
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (bind(handle, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        CloseNetSocket(netSocket);
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(handle, (struct sockaddr *)&address, &length);
+    netSocket->port = ntohs(address.sin_port);
+
+#if defined(_WIN32)
+    u_long nonBlocking = 1;
+    bool ok = ioctlsocket(handle, FIONBIO, &nonBlocking) == 0;
+#else
+    bool ok = fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    if (!ok) CloseNetSocket(netSocket);
+
+    return ok;
+}
+
+bool SendNetPacket(NetSocket *netSocket, NetAddress to, const void *data, int size) {
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(to.host);
+    address.sin_port = htons(to.port);
+
+    int sent = (int)sendto(netSocket->handle, (const char *)data, size, 0, (struct sockaddr *)&address, sizeof(address));
+    return sent == size;
+}
+
+int ReceiveNetPacket(NetSocket *netSocket, NetAddress *from, void *data, int capacity) {
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+
+    // Errors, including ICMP port unreachable from a client that went away, read as no packet
+    for (;;) {
+        int received = (int)recvfrom(netSocket->handle, (char *)data, capacity, 0, (struct sockaddr *)&address, &length);
+        if (received > 0) {
+            from->host = ntohl(address.sin_addr.s_addr);
+            from->port = ntohs(address.sin_port);
+            return received;
+        }
+#if defined(_WIN32)
+        if (received < 0 && WSAGetLastError() == WSAECONNRESET) continue;
+#else
+        if (received < 0 && (errno == EINTR || errno == ECONNREFUSED)) continue;
+#endif
+        return 0;
+    }
+}
+
+void CloseNetSocket(NetSocket *netSocket) {
+    if (netSocket->handle == -1) return;
+
+#if defined(_WIN32)
+    closesocket((SOCKET)netSocket->handle);
+    if (--openSockets == 0) WSACleanup();
+#else
+    close((int)netSocket->handle);
+#endif
+    netSocket->handle = -1;
+}
+
+NetAddress GetLoopbackAddress(uint16_t port) {
+    return (NetAddress){ INADDR_LOOPBACK, port };
+}
+
+bool IsSameNetAddress(NetAddress a, NetAddress b) {
+    return a.host == b.host && a.port == b.port;
+}
+
+double GetNetClock(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+void WaitNetClock(double seconds) {
+    if (seconds <= 0.0) return;
+
+#if defined(_WIN32)
+    Sleep((DWORD)(seconds * 1000.0));
+#else
+    struct timespec wait = { (time_t)seconds, (long)((seconds - (double)(time_t)seconds) * 1e9) };
+    nanosleep(&wait, NULL);
+#endif
+}
@@ -0,0 +1,30 @@
+// NetSocket.h
+#ifndef NETSOCKET_H
+#define NETSOCKET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// IPv4 address and port, both in host byte order
+typedef struct NetAddress {
+    uint32_t host;
+    uint16_t port;
+} NetAddress;
+
+// Non-blocking UDP socket
+typedef struct NetSocket {
+    intptr_t handle;            // Platform socket, -1 when closed
+    uint16_t port;              // Bound local port
+} NetSocket;
+
+// Function declarations
+bool OpenNetSocket(NetSocket *socket, uint16_t port);                               // Bind to port on localhost, 0 picks a free one
+bool SendNetPacket(NetSocket *socket, NetAddress to, const void *data, int size);   // Send one datagram, false if it was dropped locally
+int ReceiveNetPacket(NetSocket *socket, NetAddress *from, void *data, int capacity);// Bytes of the next waiting datagram, 0 when none
+void CloseNetSocket(NetSocket *socket);                                             // Close the socket
+NetAddress GetLoopbackAddress(uint16_t port);                                       // 127.0.0.1:port
+bool IsSameNetAddress(NetAddress a, NetAddress b);
+double GetNetClock(void);                                                           // Monotonic seconds, works without a window
+void WaitNetClock(double seconds);                                                  // Sleep the calling thread
+
+#endif // NETSOCKET_H
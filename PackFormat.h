@@ -0,0 +1,48 @@
+// PackFormat.h
+#ifndef PACKFORMAT_H
+#define PACKFORMAT_H
+
+#include <stdint.h>
+
+// Asset pack file (.fpak), written by tools/packer and mapped once by MountAssetPack.
+// Layout: PackFileHeader, entryCount PackFileEntry sorted by hash, then the file
+// contents, each aligned to PACK_FILE_ALIGNMENT so baked files keep the stream
+// alignment they were written with. All values are little-endian.
+
+#define PACK_FILE_MAGIC 0x4B415046u   // "FPAK"
+#define PACK_FILE_VERSION 1           // Bump on any layout change
+#define PACK_FILE_ALIGNMENT 16        // Alignment of every entry, at least MESH_FILE_ALIGNMENT
+
+// How an entry is stored, only uncompressed entries can be served zero-copy
+typedef enum PackCompression {
+    PACK_COMPRESSION_NONE = 0,  // Stored as is
+    PACK_COMPRESSION_DEFLATE    // raylib CompressData (DEFLATE)
+} PackCompression;
+
+typedef struct PackFileHeader {
+    uint32_t magic;             // PACK_FILE_MAGIC
+    uint32_t version;           // PACK_FILE_VERSION
+    uint32_t entryCount;        // Entries in the table of contents
+    uint32_t reserved;
+} PackFileHeader;
+
+typedef struct PackFileEntry {
+    uint64_t hash;              // HashPackPath of the original path
+    uint64_t offset;            // Start of the stored bytes from the start of the pack
+    uint32_t size;              // Stored bytes
+    uint32_t rawSize;           // Bytes after decompression, equal to size when uncompressed
+    uint32_t compression;       // PackCompression
+    uint32_t reserved;
+} PackFileEntry;
+
+// FNV-1a over the path, with '\' read as '/' so packs work with either separator
+static inline uint64_t HashPackPath(const char *path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char *c = path; *c != '\0'; c++) {
+        hash ^= (unsigned char)(*c == '\\' ? '/' : *c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+#endif // PACKFORMAT_H
@@ -0,0 +1,78 @@
+// RenderPacket.c
+#include "RenderPacket.h"
+#include <math.h>
+#include <string.h>
+
+void InitRenderPacket(RenderPacket *packet) {
+    RenderPacket empty = { 0 };
+    *packet = empty;
+    InitArena(&packet->arena, RENDER_PACKET_ARENA_SIZE);
+    packet->itemCapacity = RENDER_PACKET_INITIAL_ITEMS;
+    packet->items = (RenderItem *)AllocArena(&packet->arena, packet->itemCapacity * sizeof(RenderItem));
+}
+
+void ClearRenderPacket(RenderPacket *packet) {
+    ResetArena(&packet->arena);
+    packet->items = (RenderItem *)AllocArena(&packet->arena, packet->itemCapacity * sizeof(RenderItem));
+    packet->itemCount = 0;
+    packet->entityCount = 0;
+}
+
+void PushRenderItem(RenderPacket *packet, const ModelInstance *instance) {
+    if (!packet->items) return;
+
+    // The old list stays in the arena until the next clear, which folds it into one block
+    if (packet->itemCount == packet->itemCapacity) {
+        RenderItem *items = (RenderItem *)AllocArena(&packet->arena, packet->itemCapacity * 2 * sizeof(RenderItem));
+        if (!items) return;
+        memcpy(items, packet->items, packet->itemCount * sizeof(RenderItem));
+        packet->items = items;
+        packet->itemCapacity *= 2;
+    }
+
+    RenderItem *item = &packet->items[packet->itemCount++];
+    item->model = instance->model;
+    item->position = instance->position;
+    item->scale = instance->scale;
+    item->color = instance->color;
+}
+
+void UnloadRenderPacket(RenderPacket *packet) {
+    UnloadArena(&packet->arena);
+    packet->items = NULL;
+    packet->itemCount = 0;
+    packet->itemCapacity = 0;
+}
+
+void GetFrustumPlanes(Matrix viewProjection, Vector4 *planes) {
+    const Matrix m = viewProjection;
+    float rows[4][4] = {
+        { m.m0, m.m4, m.m8, m.m12 },
+        { m.m1, m.m5, m.m9, m.m13 },
+        { m.m2, m.m6, m.m10, m.m14 },
+        { m.m3, m.m7, m.m11, m.m15 }
+    };
+
+    // Left/right, bottom/top, near/far: the last row plus or minus each of the others
+    for (int i = 0; i < 6; i++) {
+        float sign = (i & 1) ? -1.0f : 1.0f;
+        const float *row = rows[i / 2];
+        Vector4 plane = { rows[3][0] + sign * row[0], rows[3][1] + sign * row[1], rows[3][2] + sign * row[2], rows[3][3] + sign * row[3] };
+
+        float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f) {
+            plane.x /= length;
+            plane.y /= length;
+            plane.z /= length;
+            plane.w /= length;
+        }
+        planes[i] = plane;
+    }
+}
+
+bool IsSphereInFrustum(const Vector4 *planes, Vector3 center, float radius) {
+    for (int i = 0; i < 6; i++) {
+        if (planes[i].x * center.x + planes[i].y * center.y + planes[i].z * center.z + planes[i].w < -radius) return false;
+    }
+    return true;
+}
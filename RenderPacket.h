@@ -0,0 +1,50 @@
+// RenderPacket.h
+#ifndef RENDERPACKET_H
+#define RENDERPACKET_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "Arena.h"
+#include "ModelArray.h"
+
+#define RENDER_PACKET_INITIAL_ITEMS 64      // Items allocated up front, the list grows by doubling
+#define RENDER_PACKET_ARENA_SIZE (64 * 1024) // First block of the packet arena, grows to the busiest frame
+
+// One model to draw, Model is copied by value so its transform is frozen with the packet
+typedef struct RenderItem {
+    Model model;
+    Vector3 position;
+    float scale;
+    Color color;
+} RenderItem;
+
+// Everything a frame is drawn from, written by the simulation and read-only while drawn
+typedef struct RenderPacket {
+    Camera camera;
+    Arena arena;                // Per-frame memory of the packet, reset by ClearRenderPacket
+    RenderItem *items;          // Instances inside the view frustum, in arena
+    int itemCount;
+    int itemCapacity;           // Kept across frames, so a steady scene never grows the list
+    int entityCount;            // Instances simulated, visible or not
+    bool bulletActive;
+    Vector3 bulletPosition;
+    float speed;                // HUD values
+    float altitude;
+    int flightBodies;           // Aircraft the flight model integrated
+    int flightSteps;            // Fixed steps this frame
+    double flightTime;          // Seconds spent integrating them
+    int transformsRebuilt;      // Instance matrices rebuilt because their orientation changed
+    int attachmentCount;        // Nodes in the plane's transform hierarchy
+    int attachmentsRebuilt;     // Of those, world matrices rebuilt this frame
+    double simulationTime;      // Seconds spent simulating this frame
+} RenderPacket;
+
+// Function declarations
+void InitRenderPacket(RenderPacket *packet);                                        // Allocate the item list
+void ClearRenderPacket(RenderPacket *packet);                                       // Forget last frame's items and everything else in the arena
+void PushRenderItem(RenderPacket *packet, const ModelInstance *instance);           // Snapshot an instance for drawing
+void UnloadRenderPacket(RenderPacket *packet);                                      // Free the arena
+void GetFrustumPlanes(Matrix viewProjection, Vector4 *planes);                      // Six normalized planes, inside is positive
+bool IsSphereInFrustum(const Vector4 *planes, Vector3 center, float radius);        // Sphere test against GetFrustumPlanes output
+
+#endif // RENDERPACKET_H
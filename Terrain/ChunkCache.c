@@ -0,0 +1,144 @@
+// ChunkCache.c
+#include "ChunkCache.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void FreeEntry(ChunkCache *cache, int index);
+static int FindEntry(ChunkCache *cache, int chunkX, int chunkZ);
+static void EvictLeastRecent(ChunkCache *cache);
+
+void InitChunkCache(ChunkCache *cache, size_t byteBudget, bool quantize) {
+    cache->entries = NULL;
+    cache->count = 0;
+    cache->capacity = 0;
+    cache->bytesUsed = 0;
+    cache->byteBudget = byteBudget;
+    cache->quantize = quantize;
+    cache->tick = 0;
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+void ChunkCacheStore(ChunkCache *cache, int chunkX, int chunkZ, const float *heights, int size) {
+    int vertexCount = size * size;
+    size_t bytes = vertexCount * (cache->quantize ? sizeof(unsigned short) : sizeof(float));
+
+    if (bytes > cache->byteBudget) return;
+
+    // Replace any stale copy of the same chunk
+    int existing = FindEntry(cache, chunkX, chunkZ);
+    if (existing >= 0) FreeEntry(cache, existing);
+
+    while (cache->count > 0 && cache->bytesUsed + bytes > cache->byteBudget) {
+        EvictLeastRecent(cache);
+    }
+
+    if (cache->count >= cache->capacity) {
+        int capacity = cache->capacity > 0 ? cache->capacity * 2 : 16;
+        ChunkCacheEntry *entries = (ChunkCacheEntry *)realloc(cache->entries, capacity * sizeof(ChunkCacheEntry));
+        if (!entries) return;
+        cache->entries = entries;
+        cache->capacity = capacity;
+    }
+
+    ChunkCacheEntry entry = { 0 };
+    entry.chunkX = chunkX;
+    entry.chunkZ = chunkZ;
+    entry.size = size;
+    entry.bytes = bytes;
+    entry.lastUse = ++cache->tick;
+
+    if (cache->quantize) {
+        float minHeight = heights[0];
+        float maxHeight = heights[0];
+        for (int i = 1; i < vertexCount; i++) {
+            if (heights[i] < minHeight) minHeight = heights[i];
+            if (heights[i] > maxHeight) maxHeight = heights[i];
+        }
+
+        entry.quantized = (unsigned short *)malloc(bytes);
+        if (!entry.quantized) return;
+        entry.minHeight = minHeight;
+        entry.heightStep = (maxHeight - minHeight) / 65535.0f;
+
+        float invStep = entry.heightStep > 0.0f ? 1.0f / entry.heightStep : 0.0f;
+        for (int i = 0; i < vertexCount; i++) {
+            entry.quantized[i] = (unsigned short)((heights[i] - minHeight) * invStep + 0.5f);
+        }
+    } else {
+        entry.heights = (float *)malloc(bytes);
+        if (!entry.heights) return;
+        memcpy(entry.heights, heights, bytes);
+    }
+
+    cache->entries[cache->count++] = entry;
+    cache->bytesUsed += bytes;
+}
+
+bool ChunkCacheFetch(ChunkCache *cache, int chunkX, int chunkZ, float *heights, int size) {
+    int index = FindEntry(cache, chunkX, chunkZ);
+    if (index < 0 || cache->entries[index].size != size) {
+        cache->misses++;
+        return false;
+    }
+
+    ChunkCacheEntry *entry = &cache->entries[index];
+    int vertexCount = size * size;
+
+    if (entry->quantized) {
+        for (int i = 0; i < vertexCount; i++) {
+            heights[i] = entry->minHeight + entry->quantized[i] * entry->heightStep;
+        }
+    } else {
+        memcpy(heights, entry->heights, vertexCount * sizeof(float));
+    }
+
+    // The chunk becomes resident again, so the cached copy is no longer needed
+    FreeEntry(cache, index);
+    cache->hits++;
+    return true;
+}
+
+float GetChunkCacheHitRatio(const ChunkCache *cache) {
+    unsigned int lookups = cache->hits + cache->misses;
+    return lookups > 0 ? (float)cache->hits / lookups : 0.0f;
+}
+
+void UnloadChunkCache(ChunkCache *cache) {
+    while (cache->count > 0) {
+        FreeEntry(cache, cache->count - 1);
+    }
+    free(cache->entries);
+    cache->entries = NULL;
+    cache->capacity = 0;
+}
+
+static void FreeEntry(ChunkCache *cache, int index) {
+    ChunkCacheEntry *entry = &cache->entries[index];
+    free(entry->heights);
+    free(entry->quantized);
+    cache->bytesUsed -= entry->bytes;
+
+    // Order does not matter, so fill the hole with the last entry
+    cache->entries[index] = cache->entries[cache->count - 1];
+    cache->count--;
+}
+
+static int FindEntry(ChunkCache *cache, int chunkX, int chunkZ) {
+    for (int i = 0; i < cache->count; i++) {
+        if (cache->entries[i].chunkX == chunkX && cache->entries[i].chunkZ == chunkZ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void EvictLeastRecent(ChunkCache *cache) {
+    int oldest = 0;
+    for (int i = 1; i < cache->count; i++) {
+        if (cache->entries[i].lastUse < cache->entries[oldest].lastUse) {
+            oldest = i;
+        }
+    }
+    FreeEntry(cache, oldest);
+}
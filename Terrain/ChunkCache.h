@@ -0,0 +1,40 @@
+#ifndef CHUNKCACHE_H
+#define CHUNKCACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Cached CPU heightfield of an evicted terrain chunk
+typedef struct ChunkCacheEntry {
+    int chunkX;                 // Chunk grid coordinate on X
+    int chunkZ;                 // Chunk grid coordinate on Z
+    int size;                   // Vertices per chunk side
+    float *heights;             // Full precision heights (NULL when quantized)
+    unsigned short *quantized;  // 16-bit heights (NULL when full precision)
+    float minHeight;            // Dequantization bias
+    float heightStep;           // Dequantization scale
+    size_t bytes;               // Memory held by this entry
+    unsigned int lastUse;       // LRU timestamp
+} ChunkCacheEntry;
+
+// Byte-bounded LRU cache of evicted chunk heightfields
+typedef struct ChunkCache {
+    ChunkCacheEntry *entries;   // Cached entries (unordered)
+    int count;                  // Number of cached entries
+    int capacity;               // Allocated entry slots
+    size_t bytesUsed;           // Heightfield bytes currently held
+    size_t byteBudget;          // Maximum heightfield bytes to hold
+    bool quantize;              // Store heights as 16-bit values
+    unsigned int tick;          // LRU clock
+    unsigned int hits;          // Fetches served from the cache
+    unsigned int misses;        // Fetches that required generation
+} ChunkCache;
+
+// Function declarations
+void InitChunkCache(ChunkCache *cache, size_t byteBudget, bool quantize);                        // Initialize an empty cache
+void ChunkCacheStore(ChunkCache *cache, int chunkX, int chunkZ, const float *heights, int size);  // Keep the heightfield of an evicted chunk
+bool ChunkCacheFetch(ChunkCache *cache, int chunkX, int chunkZ, float *heights, int size);        // Restore and remove a cached heightfield
+float GetChunkCacheHitRatio(const ChunkCache *cache);                                            // Hits / (hits + misses)
+void UnloadChunkCache(ChunkCache *cache);                                                        // Free all cached heightfields
+
+#endif // CHUNKCACHE_H
@@ -0,0 +1,258 @@
+// HeightPipeline.c
+#include <float.h>
+
+// Clients generate terrain from the seed the server sends, so every build must produce the
+// same bits: no fused multiply-adds, including in FastNoiseLite below, and no x87 precision
+#if defined(__FAST_MATH__)
+#error "HeightPipeline.c must not be compiled with -ffast-math"
+#endif
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 1 || FLT_EVAL_METHOD == 2)
+#error "HeightPipeline.c needs float arithmetic in float precision, build with SSE2 (-msse2 -mfpmath=sse)"
+#endif
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract (off)
+#endif
+
+#define FNL_IMPL
+#include "FastNoiseLite.h"
+#include "HeightPipeline.h"
+#include <math.h>
+#include <string.h>
+
+static double PowUnit(double t, double exponent);
+static float SampleSimplex2D(int seed, double x, double y);
+
+HeightPipelineDesc GetDefaultHeightPipelineDesc(void) {
+    HeightPipelineDesc desc = { 0 };
+
+    desc.seed = NOISE_SEED;
+    desc.noiseType = FNL_NOISE_OPENSIMPLEX2;
+    desc.frequency = NOISE_FREQUENCY;
+    desc.octaves = NOISE_OCTAVES;
+    desc.lacunarity = NOISE_LACUNARITY;
+    desc.gain = NOISE_PERSISTENCE;
+    desc.warpAmplitude = 0.0f;
+    desc.warpFrequency = NOISE_FREQUENCY;
+    desc.remap = HEIGHT_REMAP_NONE;
+    desc.remapParam = 1.0f;
+    desc.amplitude = NOISE_AMPLITUDE;
+
+    return desc;
+}
+
+HeightPipeline CompileHeightPipeline(HeightPipelineDesc desc) {
+    HeightPipeline pipeline = { 0 };
+
+    int octaves = desc.octaves;
+    if (octaves < 1) octaves = 1;
+    if (octaves > HEIGHT_MAX_OCTAVES) octaves = HEIGHT_MAX_OCTAVES;
+
+    // Base noise is sampled one octave at a time, frequency and skew are applied once per sample
+    pipeline.base = fnlCreateState();
+    pipeline.base.seed = desc.seed;
+    pipeline.base.noise_type = desc.noiseType;
+    pipeline.base.frequency = desc.frequency;
+    pipeline.base.fractal_type = FNL_FRACTAL_FBM;
+    pipeline.base.octaves = octaves;
+    pipeline.base.gain = desc.gain;
+
+    // Same seeds and weights as _fnlGenFractalFBM2D with weighted_strength 0
+    float amplitude = _fnlCalculateFractalBounding(&pipeline.base);
+    float scale = 1.0f;
+    for (int i = 0; i < octaves; i++) {
+        pipeline.octaveSeeds[i] = desc.seed + i;
+        pipeline.octaveScales[i] = scale;
+        pipeline.octaveAmplitudes[i] = amplitude;
+        scale *= desc.lacunarity;
+        amplitude *= desc.gain;
+    }
+    pipeline.octaves = octaves;
+
+    pipeline.warpEnabled = desc.warpAmplitude != 0.0f;
+    pipeline.warp = fnlCreateState();
+    pipeline.warp.seed = desc.seed + HEIGHT_MAX_OCTAVES;
+    pipeline.warp.frequency = desc.warpFrequency;
+    pipeline.warp.domain_warp_type = FNL_DOMAIN_WARP_OPENSIMPLEX2;
+    pipeline.warp.domain_warp_amp = desc.warpAmplitude;
+    pipeline.warp.fractal_type = FNL_FRACTAL_NONE;
+
+    pipeline.remapEnabled = desc.remap != HEIGHT_REMAP_NONE;
+    for (int i = 0; i <= HEIGHT_REMAP_SIZE; i++) {
+        float t = (float)i / HEIGHT_REMAP_SIZE;
+        float value = t;
+
+        if (desc.remap == HEIGHT_REMAP_POWER) {
+            value = (float)PowUnit(t, desc.remapParam);
+        } else if (desc.remap == HEIGHT_REMAP_TERRACE && desc.remapParam >= 1.0f) {
+            // Flat steps joined by smoothstep ramps
+            float steps = desc.remapParam;
+            float step = floorf(t * steps);
+            float f = t * steps - step;
+            value = (step + f * f * (3.0f - 2.0f * f)) / steps;
+        }
+
+        pipeline.remapCurve[i] = fminf(fmaxf(value, 0.0f), 1.0f);
+    }
+
+    pipeline.amplitude = desc.amplitude;
+
+    return pipeline;
+}
+
+float EvaluateHeight(const HeightPipeline *pipeline, double x, double z) {
+    // FastNoiseLite never writes to its state, the casts only satisfy its signatures
+    fnl_state *base = (fnl_state *)&pipeline->base;
+
+    // The warp is a smooth offset of a few tens of units, its float sample position is enough
+    // but adding it to a float position would round to whole units ten million units out
+    if (pipeline->warpEnabled) {
+        fnl_state *warp = (fnl_state *)&pipeline->warp;
+        FNLfloat warpX = (FNLfloat)x;
+        FNLfloat warpZ = (FNLfloat)z;
+        FNLfloat offsetX = 0.0f;
+        FNLfloat offsetZ = 0.0f;
+        _fnlTransformDomainWarpCoordinate2D(warp, &warpX, &warpZ);
+        _fnlDoSingleDomainWarp2D(warp, warp->seed, warp->domain_warp_amp * _fnlCalculateFractalBounding(warp), warp->frequency,
+                                 warpX, warpZ, &offsetX, &offsetZ);
+        x += offsetX;
+        z += offsetZ;
+    }
+
+    // _fnlTransformNoiseCoordinate2D in double, FastNoiseLite's positions are float
+    double sampleX = x * base->frequency;
+    double sampleZ = z * base->frequency;
+    if (base->noise_type == FNL_NOISE_OPENSIMPLEX2 || base->noise_type == FNL_NOISE_OPENSIMPLEX2S) {
+        const double SQRT3 = 1.7320508075688772935274463415059;
+        const double F2 = 0.5 * (SQRT3 - 1);
+        double t = (sampleX + sampleZ) * F2;
+        sampleX += t;
+        sampleZ += t;
+    }
+
+    // The coordinate transform is linear, so scaling after it matches FastNoiseLite's per-octave lacunarity
+    float sum = 0.0f;
+    for (int i = 0; i < pipeline->octaves; i++) {
+        double scale = pipeline->octaveScales[i];
+        float noise = base->noise_type == FNL_NOISE_OPENSIMPLEX2
+                    ? SampleSimplex2D(pipeline->octaveSeeds[i], sampleX * scale, sampleZ * scale)
+                    : _fnlGenNoiseSingle2D(base, pipeline->octaveSeeds[i], (FNLfloat)(sampleX * scale), (FNLfloat)(sampleZ * scale));
+        sum += noise * pipeline->octaveAmplitudes[i];
+    }
+
+    // Fractal bounding keeps the sum in [-1, 1], clamp away rounding overshoot
+    float t = fminf(fmaxf(sum * 0.5f + 0.5f, 0.0f), 1.0f);
+
+    if (pipeline->remapEnabled) {
+        float position = t * HEIGHT_REMAP_SIZE;
+        int index = (int)position;
+        if (index >= HEIGHT_REMAP_SIZE) index = HEIGHT_REMAP_SIZE - 1;
+        float f = position - index;
+        t = pipeline->remapCurve[index] + (pipeline->remapCurve[index + 1] - pipeline->remapCurve[index]) * f;
+    }
+
+    return (t * 2.0f - 1.0f) * pipeline->amplitude;
+}
+
+unsigned int GetChunkHeightChecksum(const HeightPipeline *pipeline, int chunkSize, float tileScale, int chunkX, int chunkZ) {
+    // Same sample positions as AddTerrainChunk and GenerateChunkHeights
+    float chunkWorldSize = (chunkSize - 1) * tileScale;
+    double cornerX = (double)chunkX * chunkWorldSize;
+    double cornerZ = (double)chunkZ * chunkWorldSize;
+
+    unsigned int hash = 2166136261u;
+    for (int z = 0; z < chunkSize; z++) {
+        for (int x = 0; x < chunkSize; x++) {
+            float height = EvaluateHeight(pipeline, (double)x * tileScale + cornerX, (double)z * tileScale + cornerZ);
+
+            unsigned char bytes[sizeof(float)];
+            memcpy(bytes, &height, sizeof(float));
+            for (int i = 0; i < (int)sizeof(float); i++) {
+                hash = (hash ^ bytes[i]) * 16777619u;
+            }
+        }
+    }
+
+    return hash;
+}
+
+// t^exponent for t in [0, 1] from +, * and / alone, powf rounds differently between C libraries
+static double PowUnit(double t, double exponent) {
+    if (t <= 0.0) return exponent > 0.0 ? 0.0 : 1.0;
+
+    // ln(t) = e ln(2) + ln(m), m in [0.5, 1), with the atanh series of ln(m)
+    const double ln2 = 0.69314718055994530942;
+    int e;
+    double m = frexp(t, &e);
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double term = s;
+    double logM = 0.0;
+    for (int k = 1; k < 60; k += 2) {
+        logM += term / k;
+        term *= s2;
+    }
+    double y = exponent * (e * ln2 + 2.0 * logM);
+    if (y < -1000.0) return 0.0;
+
+    // exp(y) = 2^n exp(r), r in [0, ln(2)), with its Taylor series
+    double n = floor(y / ln2);
+    double r = y - n * ln2;
+    double sum = 1.0;
+    term = 1.0;
+    for (int k = 1; k < 25; k++) {
+        term *= r / k;
+        sum += term;
+    }
+
+    return ldexp(sum, (int)n);
+}
+
+// _fnlSingleSimplex2D with double positions: only the lattice split needs them, the offsets
+// inside a cell are float as in FastNoiseLite, so heights match it bit for bit near the origin
+static float SampleSimplex2D(int seed, double x, double y) {
+    const float SQRT3 = 1.7320508075688772935274463415059f;
+    const float G2 = (3 - SQRT3) / 6;
+
+    // _fnlFastFloor, including its off-by-one on negative whole numbers
+    int i = x >= 0 ? (int)x : (int)x - 1;
+    int j = y >= 0 ? (int)y : (int)y - 1;
+    float xi = (float)(x - i);
+    float yi = (float)(y - j);
+
+    float t = (xi + yi) * G2;
+    float x0 = (float)(xi - t);
+    float y0 = (float)(yi - t);
+
+    i *= PRIME_X;
+    j *= PRIME_Y;
+
+    float n0 = 0.0f, n1 = 0.0f, n2 = 0.0f;
+
+    float a = 0.5f - x0 * x0 - y0 * y0;
+    if (a > 0) n0 = (a * a) * (a * a) * _fnlGradCoord2D(seed, i, j, x0, y0);
+
+    float c = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2)) * t + ((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2)) + a);
+    if (c > 0) {
+        float x2 = x0 + (2 * (float)G2 - 1);
+        float y2 = y0 + (2 * (float)G2 - 1);
+        n2 = (c * c) * (c * c) * _fnlGradCoord2D(seed, i + PRIME_X, j + PRIME_Y, x2, y2);
+    }
+
+    if (y0 > x0) {
+        float x1 = x0 + (float)G2;
+        float y1 = y0 + ((float)G2 - 1);
+        float b = 0.5f - x1 * x1 - y1 * y1;
+        if (b > 0) n1 = (b * b) * (b * b) * _fnlGradCoord2D(seed, i, j + PRIME_Y, x1, y1);
+    } else {
+        float x1 = x0 + ((float)G2 - 1);
+        float y1 = y0 + (float)G2;
+        float b = 0.5f - x1 * x1 - y1 * y1;
+        if (b > 0) n1 = (b * b) * (b * b) * _fnlGradCoord2D(seed, i + PRIME_X, j, x1, y1);
+    }
+
+    return (n0 + n1 + n2) * 99.83685446303647f;
+}
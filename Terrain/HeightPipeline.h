@@ -0,0 +1,60 @@
+#ifndef HEIGHTPIPELINE_H
+#define HEIGHTPIPELINE_H
+
+#include <stdbool.h>
+#include "FastNoiseLite.h"
+
+#define HEIGHT_MAX_OCTAVES 12      // Maximum fractal octaves in a pipeline
+#define HEIGHT_REMAP_SIZE 256      // Segments in the precomputed remap curve
+#define NOISE_AMPLITUDE 10.0f      // Amplitude of noise for terrain generation
+#define NOISE_FREQUENCY 0.01f      // Frequency of noise for terrain generation
+#define NOISE_SEED 1000            // Seed of the first noise octave
+#define NOISE_OCTAVES 4            // Fractal octaves
+#define NOISE_PERSISTENCE 0.5f     // Amplitude multiplier between octaves
+#define NOISE_LACUNARITY 2.0f      // Frequency multiplier between octaves
+
+// Curve applied to the normalized fractal sum
+typedef enum HeightRemapType {
+    HEIGHT_REMAP_NONE = 0,         // Identity
+    HEIGHT_REMAP_POWER,            // Raise [0, 1] height to remapParam, flattens lowlands
+    HEIGHT_REMAP_TERRACE           // Smoothed steps, remapParam is the step count
+} HeightRemapType;
+
+// Height function parameters: domain warp -> fractal base noise -> remap curve
+typedef struct HeightPipelineDesc {
+    int seed;                      // Seed of the first octave, octave i uses seed + i
+    fnl_noise_type noiseType;      // Base noise
+    float frequency;               // Frequency of the first octave
+    int octaves;                   // Fractal octaves (1..HEIGHT_MAX_OCTAVES)
+    float lacunarity;              // Frequency multiplier between octaves
+    float gain;                    // Amplitude multiplier between octaves
+    float warpAmplitude;           // Domain warp amplitude in world units (0 disables warping)
+    float warpFrequency;           // Domain warp frequency
+    HeightRemapType remap;         // Remap curve type
+    float remapParam;              // Exponent or terrace step count
+    float amplitude;               // Output heights lie in [-amplitude, amplitude]
+} HeightPipelineDesc;
+
+// Compiled height function, every per-octave constant is resolved up front.
+// Heights are bit-identical on every build and platform: HeightPipeline.c has no libm calls
+// in the sample path, forbids fused multiply-adds and refuses to compile with excess precision.
+typedef struct HeightPipeline {
+    fnl_state base;                                 // Single-octave base noise state
+    fnl_state warp;                                 // Domain warp state
+    bool warpEnabled;                               // Apply domain warp before sampling
+    int octaves;                                    // Number of octaves to sum
+    int octaveSeeds[HEIGHT_MAX_OCTAVES];            // Per-octave seed
+    float octaveScales[HEIGHT_MAX_OCTAVES];         // Per-octave coordinate scale (lacunarity^i)
+    float octaveAmplitudes[HEIGHT_MAX_OCTAVES];     // Per-octave weight including fractal bounding
+    bool remapEnabled;                              // Apply remapCurve
+    float remapCurve[HEIGHT_REMAP_SIZE + 1];        // Remap samples over [0, 1]
+    float amplitude;                                // Output scale
+} HeightPipeline;
+
+// Function declarations
+HeightPipelineDesc GetDefaultHeightPipelineDesc(void);               // Four octaves of OpenSimplex2 FBM without warping or remapping
+HeightPipeline CompileHeightPipeline(HeightPipelineDesc desc);        // Precompute constants for a height function
+float EvaluateHeight(const HeightPipeline *pipeline, double x, double z);  // Height at world x/z, within [-amplitude, amplitude]
+unsigned int GetChunkHeightChecksum(const HeightPipeline *pipeline, int chunkSize, float tileScale, int chunkX, int chunkZ);  // FNV-1a of the heights a terrain chunk generates, before caching or deformation
+
+#endif // HEIGHTPIPELINE_H
@@ -0,0 +1,129 @@
+// Impostor.c
+#include "Impostor.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "TerrainShader.h"
+#include <math.h>
+
+void InitImpostorAtlas(ImpostorAtlas *atlas) {
+    atlas->target = LoadRenderTexture(IMPOSTOR_VIEWS * IMPOSTOR_CELL_SIZE, IMPOSTOR_MAX_MODELS * IMPOSTOR_CELL_SIZE);
+    atlas->modelCount = 0;
+    atlas->quadCount = 0;
+    atlas->cameraPosition = (Vector3){ 0.0f, 0.0f, 0.0f };
+
+    // raylib's default vertex shader feeds the batch, only the fragment stage discards
+    atlas->shader = LoadShaderFromMemory(NULL, impostorFragmentShader);
+
+    BeginTextureMode(atlas->target);
+    ClearBackground(BLANK);
+    EndTextureMode();
+}
+
+// Orthographic views from IMPOSTOR_VIEWS directions around the model, at ground level.
+// View v looks from angle v * 2 * PI / IMPOSTOR_VIEWS in the model's own frame.
+int BakeImpostor(ImpostorAtlas *atlas, Model model) {
+    if (atlas->modelCount >= IMPOSTOR_MAX_MODELS) return -1;
+    int index = atlas->modelCount++;
+
+    // A square that holds the model at any rotation around Y
+    BoundingBox bounds = GetModelBoundingBox(model);
+    Vector3 extent = Vector3Subtract(bounds.max, bounds.min);
+    float size = fmaxf(sqrtf(extent.x * extent.x + extent.z * extent.z), extent.y) * 1.05f;
+    float centerY = (bounds.min.y + bounds.max.y) * 0.5f;
+    atlas->size[index] = size;
+    atlas->centerY[index] = centerY;
+
+    // Models may carry an instancing shader, bake them with raylib's default one
+    Shader defaultShader = { rlGetShaderIdDefault(), rlGetShaderLocsDefault() };
+    Shader shaders[16];
+    int materialCount = model.materialCount < 16 ? model.materialCount : 16;
+    for (int i = 0; i < materialCount; i++) {
+        shaders[i] = model.materials[i].shader;
+        model.materials[i].shader = defaultShader;
+    }
+
+    BeginTextureMode(atlas->target);
+    for (int view = 0; view < IMPOSTOR_VIEWS; view++) {
+        float angle = view * 2.0f * PI / IMPOSTOR_VIEWS;
+
+        Camera camera = { 0 };
+        camera.target = (Vector3){ 0.0f, centerY, 0.0f };
+        camera.position = (Vector3){ sinf(angle) * size * 2.0f, centerY, cosf(angle) * size * 2.0f };
+        camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+        camera.fovy = size;
+        camera.projection = CAMERA_ORTHOGRAPHIC;
+
+        // BeginMode3D takes its aspect from the whole atlas, which is square while IMPOSTOR_VIEWS equals IMPOSTOR_MAX_MODELS
+        rlViewport(view * IMPOSTOR_CELL_SIZE, index * IMPOSTOR_CELL_SIZE, IMPOSTOR_CELL_SIZE, IMPOSTOR_CELL_SIZE);
+        BeginMode3D(camera);
+        DrawModel(model, (Vector3){ 0.0f, 0.0f, 0.0f }, 1.0f, WHITE);
+        EndMode3D();
+    }
+    EndTextureMode();
+
+    for (int i = 0; i < materialCount; i++) {
+        model.materials[i].shader = shaders[i];
+    }
+
+    // Distant impostors are minified heavily
+    GenTextureMipmaps(&atlas->target.texture);
+    SetTextureFilter(atlas->target.texture, TEXTURE_FILTER_TRILINEAR);
+
+    return index;
+}
+
+void BeginImpostors(ImpostorAtlas *atlas, Vector3 cameraPosition, Color tint) {
+    atlas->cameraPosition = cameraPosition;
+    atlas->quadCount = 0;
+
+    BeginShaderMode(atlas->shader);
+    rlSetTexture(atlas->target.texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+}
+
+// Cylindrical billboard: the quad turns around Y towards the camera and shows the closest baked view
+void DrawImpostor(ImpostorAtlas *atlas, int index, Vector3 position, float yaw, float scale) {
+    float dx = atlas->cameraPosition.x - position.x;
+    float dz = atlas->cameraPosition.z - position.z;
+    float angle = atan2f(dx, dz);
+
+    // Instances are rotated by yaw, so the view angle in the model's frame is the difference
+    float step = 2.0f * PI / IMPOSTOR_VIEWS;
+    int view = (int)lrintf((angle - yaw) / step) % IMPOSTOR_VIEWS;
+    if (view < 0) view += IMPOSTOR_VIEWS;
+
+    float half = atlas->size[index] * scale * 0.5f;
+    float centerY = position.y + atlas->centerY[index] * scale;
+    float rightX = cosf(angle) * half;
+    float rightZ = -sinf(angle) * half;
+
+    // Render textures are stored bottom-up, so row index starts at v = index / rows
+    float u0 = (float)view / IMPOSTOR_VIEWS;
+    float u1 = (float)(view + 1) / IMPOSTOR_VIEWS;
+    float v0 = (float)index / IMPOSTOR_MAX_MODELS;
+    float v1 = (float)(index + 1) / IMPOSTOR_MAX_MODELS;
+
+    rlTexCoord2f(u0, v1);
+    rlVertex3f(position.x - rightX, centerY + half, position.z - rightZ);
+    rlTexCoord2f(u0, v0);
+    rlVertex3f(position.x - rightX, centerY - half, position.z - rightZ);
+    rlTexCoord2f(u1, v0);
+    rlVertex3f(position.x + rightX, centerY - half, position.z + rightZ);
+    rlTexCoord2f(u1, v1);
+    rlVertex3f(position.x + rightX, centerY + half, position.z + rightZ);
+
+    atlas->quadCount++;
+}
+
+void EndImpostors(ImpostorAtlas *atlas) {
+    rlEnd();
+    rlSetTexture(0);
+    EndShaderMode();
+}
+
+void UnloadImpostorAtlas(ImpostorAtlas *atlas) {
+    UnloadShader(atlas->shader);
+    UnloadRenderTexture(atlas->target);
+    atlas->modelCount = 0;
+}
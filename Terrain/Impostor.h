@@ -0,0 +1,29 @@
+#ifndef IMPOSTOR_H
+#define IMPOSTOR_H
+
+#include "raylib.h"
+
+#define IMPOSTOR_VIEWS 8           // Pre-rendered view angles around Y per model
+#define IMPOSTOR_MAX_MODELS 8      // Atlas rows
+#define IMPOSTOR_CELL_SIZE 128     // Pixels per view
+
+// Views of every baked model in one texture: views across, models up
+typedef struct ImpostorAtlas {
+    RenderTexture2D target;                     // Atlas with depth for baking
+    Shader shader;                              // Alpha-tested textured quads
+    int modelCount;                             // Baked rows
+    float size[IMPOSTOR_MAX_MODELS];            // World size of the square each view covers
+    float centerY[IMPOSTOR_MAX_MODELS];         // Height of the view centre above the model origin
+    Vector3 cameraPosition;                     // Camera used by the current batch
+    int quadCount;                              // Quads emitted by the current batch
+} ImpostorAtlas;
+
+// Function declarations
+void InitImpostorAtlas(ImpostorAtlas *atlas);                                           // Allocate the atlas and shader
+int BakeImpostor(ImpostorAtlas *atlas, Model model);                                    // Render IMPOSTOR_VIEWS views of a model, returns its row or -1 when full
+void BeginImpostors(ImpostorAtlas *atlas, Vector3 cameraPosition, Color tint);         // Start a batch of camera-facing quads, tinted like DrawModel
+void DrawImpostor(ImpostorAtlas *atlas, int index, Vector3 position, float yaw, float scale);  // Queue one impostor standing at position
+void EndImpostors(ImpostorAtlas *atlas);                                                // Submit the batch
+void UnloadImpostorAtlas(ImpostorAtlas *atlas);                                         // Unload the atlas and shader
+
+#endif // IMPOSTOR_H
@@ -0,0 +1,245 @@
+// Scatter.c
+#include "Scatter.h"
+#include "raymath.h"
+#include "TerrainShader.h"
+#include <math.h>
+#include <stdlib.h>
+
+// Internal functions
+static Model LoadPropModel(PropScatter *scatter, PropType type, const char *modelPath, const char *texturePath, Mesh fallback, Color color);
+static unsigned int HashChunk(int seed, int chunkX, int chunkZ);
+static float NextRandom(unsigned int *state);
+static float SampleChunkHeight(const float *heights, int size, float gridX, float gridZ);
+
+void InitPropScatter(PropScatter *scatter, int seed, float spacing, float maxDensity) {
+    scatter->seed = seed;
+    scatter->spacing = spacing;
+    scatter->maxDensity = maxDensity;
+
+    // Forests and villages come in patches a few hundred units wide
+    scatter->density = fnlCreateState();
+    scatter->density.seed = seed;
+    scatter->density.noise_type = FNL_NOISE_OPENSIMPLEX2;
+    scatter->density.frequency = 0.004f;
+    scatter->density.fractal_type = FNL_FRACTAL_FBM;
+    scatter->density.octaves = 2;
+
+    scatter->shader = LoadShaderFromMemory(propVertexShader, propFragmentShader);
+    scatter->shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(scatter->shader, "instanceTransform");
+
+    // Trees and rocks are generated, houses fall back to boxes when the assets are missing
+    scatter->models[PROP_TREE] = LoadPropModel(scatter, PROP_TREE, NULL, NULL, GenMeshCone(2.0f, 8.0f, 6), DARKGREEN);
+    scatter->models[PROP_ROCK] = LoadPropModel(scatter, PROP_ROCK, NULL, NULL, GenMeshHemiSphere(1.5f, 3, 6), GRAY);
+    scatter->models[PROP_HOUSE] = LoadPropModel(scatter, PROP_HOUSE, PROP_HOUSE_MODEL, PROP_HOUSE_TEXTURE, GenMeshCube(6.0f, 5.0f, 6.0f), BEIGE);
+    scatter->models[PROP_COTTAGE] = LoadPropModel(scatter, PROP_COTTAGE, PROP_COTTAGE_MODEL, PROP_COTTAGE_TEXTURE, GenMeshCube(4.0f, 4.0f, 5.0f), BROWN);
+
+    // Bake every prop once, distant chunks draw these views instead of meshes
+    InitImpostorAtlas(&scatter->impostors);
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        scatter->impostorIndex[type] = BakeImpostor(&scatter->impostors, scatter->models[type]);
+    }
+
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        scatter->transforms[type] = NULL;
+        scatter->transformCounts[type] = 0;
+        scatter->transformCapacity[type] = 0;
+    }
+}
+
+static Model LoadPropModel(PropScatter *scatter, PropType type, const char *modelPath, const char *texturePath, Mesh fallback, Color color) {
+    Model model;
+    scatter->textures[type] = (Texture2D){ 0 };
+    scatter->baseOffset[type] = 0.0f;
+
+    if (modelPath && FileExists(modelPath)) {
+        UnloadMesh(fallback);
+        model = LoadModel(modelPath);
+        if (texturePath && FileExists(texturePath)) scatter->textures[type] = LoadTexture(texturePath);
+    } else {
+        // Generated boxes are centred on the origin, cones and hemispheres already sit on y = 0
+        BoundingBox bounds = GetMeshBoundingBox(fallback);
+        scatter->baseOffset[type] = -bounds.min.y;
+        model = LoadModelFromMesh(fallback);
+        model.materials[0].maps[MATERIAL_MAP_DIFFUSE].color = color;
+    }
+
+    for (int i = 0; i < model.materialCount; i++) {
+        model.materials[i].shader = scatter->shader;
+        if (scatter->textures[type].id != 0) model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture = scatter->textures[type];
+    }
+
+    return model;
+}
+
+// Jittered grid: one candidate per cell, kept with the probability given by the density noise.
+// Every random number comes from the chunk coordinates, so a chunk always gets the same props.
+int ScatterChunkProps(const PropScatter *scatter, int chunkX, int chunkZ, const float *heights, int size, float tileScale, float amplitude, PropInstance **props) {
+    float chunkSize = (size - 1) * tileScale;
+    int cells = (int)(chunkSize / scatter->spacing);
+    if (cells < 1) cells = 1;
+    float cellSize = chunkSize / cells;
+
+    PropInstance *instances = (PropInstance *)RL_MALLOC(cells * cells * sizeof(PropInstance));
+    unsigned int state = HashChunk(scatter->seed, chunkX, chunkZ);
+    int count = 0;
+
+    for (int cz = 0; cz < cells; cz++) {
+        for (int cx = 0; cx < cells; cx++) {
+            // Draw every number up front so a rejected cell does not shift the next one
+            float jitterX = NextRandom(&state);
+            float jitterZ = NextRandom(&state);
+            float chance = NextRandom(&state);
+            float pick = NextRandom(&state);
+            float yaw = NextRandom(&state);
+            float scale = NextRandom(&state);
+
+            float x = (cx + jitterX) * cellSize;
+            float z = (cz + jitterZ) * cellSize;
+            double worldX = (double)chunkX * chunkSize + x;
+            double worldZ = (double)chunkZ * chunkSize + z;
+
+            // FastNoiseLite never writes to its state, the cast only satisfies its signature
+            float density = fnlGetNoise2D((fnl_state *)&scatter->density, worldX, worldZ) * 0.5f + 0.5f;
+            if (chance >= density * scatter->maxDensity) continue;
+
+            float gridX = x / tileScale;
+            float gridZ = z / tileScale;
+            float y = SampleChunkHeight(heights, size, gridX, gridZ);
+            float h = (y + amplitude) / (2.0f * amplitude);
+
+            // Steepness from the height change over one tile
+            float slopeX = SampleChunkHeight(heights, size, gridX + 1.0f, gridZ) - y;
+            float slopeZ = SampleChunkHeight(heights, size, gridX, gridZ + 1.0f) - y;
+            float slope = sqrtf(slopeX * slopeX + slopeZ * slopeZ) / tileScale;
+
+            // Same bands as the default colour gradient: water, sand, grass, rock, snow
+            PropType type;
+            if (h < 0.22f || h > 0.85f) continue;
+            if (h < 0.3f) {
+                if (pick > 0.3f) continue;
+                type = PROP_ROCK;
+            } else if (h < 0.7f && slope < 0.5f) {
+                if (pick < 0.02f && slope < 0.15f) type = pick < 0.01f ? PROP_HOUSE : PROP_COTTAGE;
+                else type = PROP_TREE;
+            } else {
+                type = PROP_ROCK;
+            }
+
+            float minScale = type == PROP_ROCK ? 0.5f : (type == PROP_TREE ? 0.7f : 1.0f);
+            float maxScale = type == PROP_ROCK ? 1.5f : (type == PROP_TREE ? 1.3f : 1.0f);
+
+            PropInstance *instance = &instances[count++];
+            instance->x = x;
+            instance->y = y;
+            instance->z = z;
+            instance->type = (unsigned char)type;
+            instance->yaw = (unsigned char)(yaw * 256.0f);
+            instance->scale = (unsigned char)lrintf(Lerp(minScale, maxScale, scale) * 64.0f);
+            instance->reserved = 0;
+        }
+    }
+
+    // Keep only what was placed, most cells are rejected
+    if (count == 0) {
+        RL_FREE(instances);
+        instances = NULL;
+    } else {
+        instances = (PropInstance *)RL_REALLOC(instances, count * sizeof(PropInstance));
+    }
+
+    *props = instances;
+    return count;
+}
+
+void ClearPropBatches(PropScatter *scatter) {
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        scatter->transformCounts[type] = 0;
+    }
+}
+
+void AppendPropBatch(PropScatter *scatter, const PropInstance *props, int count, Vector3 origin) {
+    for (int i = 0; i < count; i++) {
+        const PropInstance *prop = &props[i];
+        int type = prop->type;
+
+        if (scatter->transformCounts[type] == scatter->transformCapacity[type]) {
+            int capacity = scatter->transformCapacity[type] > 0 ? scatter->transformCapacity[type] * 2 : 256;
+            scatter->transforms[type] = (Matrix *)RL_REALLOC(scatter->transforms[type], capacity * sizeof(Matrix));
+            scatter->transformCapacity[type] = capacity;
+        }
+
+        float scale = prop->scale / 64.0f;
+        Matrix matScale = MatrixScale(scale, scale, scale);
+        Matrix matRotation = MatrixRotateY(prop->yaw * (2.0f * PI / 256.0f));
+        Matrix matTranslation = MatrixTranslate(origin.x + prop->x, origin.y + prop->y + scatter->baseOffset[type] * scale, origin.z + prop->z);
+
+        scatter->transforms[type][scatter->transformCounts[type]++] = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
+    }
+}
+
+void DrawPropBatches(PropScatter *scatter) {
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        if (scatter->transformCounts[type] == 0) continue;
+
+        Model model = scatter->models[type];
+        for (int m = 0; m < model.meshCount; m++) {
+            DrawMeshInstanced(model.meshes[m], model.materials[model.meshMaterial[m]], scatter->transforms[type], scatter->transformCounts[type]);
+        }
+    }
+}
+
+void DrawPropImpostors(PropScatter *scatter, const PropInstance *props, int count, Vector3 origin) {
+    for (int i = 0; i < count; i++) {
+        const PropInstance *prop = &props[i];
+        float scale = prop->scale / 64.0f;
+        Vector3 position = { origin.x + prop->x, origin.y + prop->y + scatter->baseOffset[prop->type] * scale, origin.z + prop->z };
+
+        DrawImpostor(&scatter->impostors, scatter->impostorIndex[prop->type], position, prop->yaw * (2.0f * PI / 256.0f), scale);
+    }
+}
+
+void UnloadPropScatter(PropScatter *scatter) {
+    // UnloadModel leaves shaders and textures alone, they are shared and freed here
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+        UnloadModel(scatter->models[type]);
+        if (scatter->textures[type].id != 0) UnloadTexture(scatter->textures[type]);
+        RL_FREE(scatter->transforms[type]);
+        scatter->transforms[type] = NULL;
+        scatter->transformCounts[type] = 0;
+        scatter->transformCapacity[type] = 0;
+    }
+    UnloadShader(scatter->shader);
+    UnloadImpostorAtlas(&scatter->impostors);
+}
+
+// Integer mix of the seed and chunk coordinates
+static unsigned int HashChunk(int seed, int chunkX, int chunkZ) {
+    unsigned int hash = (unsigned int)seed * 0x9E3779B1u;
+    hash ^= (unsigned int)chunkX * 0x85EBCA77u;
+    hash = (hash ^ (hash >> 15)) * 0xC2B2AE3Du;
+    hash ^= (unsigned int)chunkZ * 0x27D4EB2Fu;
+    hash = (hash ^ (hash >> 16)) * 0x7FEB352Du;
+    hash = (hash ^ (hash >> 15)) * 0x846CA68Bu;
+    return hash ^ (hash >> 16);
+}
+
+// Linear congruential step, returns [0, 1) from the high 24 bits
+static float NextRandom(unsigned int *state) {
+    *state = *state * 1664525u + 1013904223u;
+    return (*state >> 8) * (1.0f / 16777216.0f);
+}
+
+// Bilinear height between grid vertices, clamped to the chunk
+static float SampleChunkHeight(const float *heights, int size, float gridX, float gridZ) {
+    gridX = Clamp(gridX, 0.0f, (float)(size - 1));
+    gridZ = Clamp(gridZ, 0.0f, (float)(size - 1));
+
+    int gx = gridX >= size - 1 ? size - 2 : (int)gridX;
+    int gz = gridZ >= size - 1 ? size - 2 : (int)gridZ;
+    float fx = gridX - gx;
+    float fz = gridZ - gz;
+    const float *row0 = &heights[gz * size + gx];
+    const float *row1 = row0 + size;
+
+    return Lerp(Lerp(row0[0], row0[1], fx), Lerp(row1[0], row1[1], fx), fz);
+}
@@ -0,0 +1,58 @@
+#ifndef SCATTER_H
+#define SCATTER_H
+
+#include "raylib.h"
+#include "FastNoiseLite.h"
+#include "Impostor.h"
+
+#define PROP_TYPE_COUNT 4              // Number of prop kinds
+#define PROP_HOUSE_MODEL    "resources/models/obj/house.obj"
+#define PROP_HOUSE_TEXTURE  "resources/models/obj/house_diffuse.png"
+#define PROP_COTTAGE_MODEL  "resources/models/obj/cottage_obj.obj"
+#define PROP_COTTAGE_TEXTURE "resources/models/obj/cottage_diffuse.png"
+
+typedef enum PropType {
+    PROP_TREE = 0,
+    PROP_ROCK,
+    PROP_HOUSE,
+    PROP_COTTAGE
+} PropType;
+
+// One scattered object, position is relative to the chunk origin (16 bytes)
+typedef struct PropInstance {
+    float x;
+    float y;
+    float z;
+    unsigned char type;        // PropType
+    unsigned char yaw;         // Rotation around Y in 1/256 turns
+    unsigned char scale;       // Scale in 1/64 units
+    unsigned char reserved;
+} PropInstance;
+
+// Deterministic prop placement and instanced drawing
+typedef struct PropScatter {
+    fnl_state density;                          // Low-frequency density noise
+    int seed;                                   // Placement seed
+    float spacing;                              // Jittered grid cell size in world units
+    float maxDensity;                           // Highest chance of a prop per cell
+    Shader shader;                              // Instancing shader
+    Model models[PROP_TYPE_COUNT];              // Asset per prop type
+    Texture2D textures[PROP_TYPE_COUNT];        // Textures owned by the scatter (id 0 when none)
+    float baseOffset[PROP_TYPE_COUNT];          // Lift that puts the bottom of the model on the ground
+    ImpostorAtlas impostors;                    // Baked views for distant props
+    int impostorIndex[PROP_TYPE_COUNT];         // Atlas row per prop type
+    Matrix *transforms[PROP_TYPE_COUNT];        // Instance transforms gathered for drawing
+    int transformCounts[PROP_TYPE_COUNT];       // Used transforms per type
+    int transformCapacity[PROP_TYPE_COUNT];     // Allocated transforms per type
+} PropScatter;
+
+// Function declarations
+void InitPropScatter(PropScatter *scatter, int seed, float spacing, float maxDensity);   // Load prop assets and the instancing shader
+int ScatterChunkProps(const PropScatter *scatter, int chunkX, int chunkZ, const float *heights, int size, float tileScale, float amplitude, PropInstance **props);  // Place props on one chunk, returns the count
+void ClearPropBatches(PropScatter *scatter);                                            // Start gathering instances
+void AppendPropBatch(PropScatter *scatter, const PropInstance *props, int count, Vector3 origin);  // Gather one chunk's props
+void DrawPropBatches(PropScatter *scatter);                                             // One instanced draw per prop mesh
+void DrawPropImpostors(PropScatter *scatter, const PropInstance *props, int count, Vector3 origin);  // Queue one chunk's props as impostors, between BeginImpostors and EndImpostors
+void UnloadPropScatter(PropScatter *scatter);                                           // Unload assets and batches
+
+#endif // SCATTER_H
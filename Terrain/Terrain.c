@@ -1,5 +1,3 @@
-#define FNL_IMPL
-#include "FastNoiseLite.h"
 #include "Terrain.h"
 #include "raymath.h"
 #include <math.h>
@@ -7,123 +5,463 @@
 #include <stdio.h>
 #include <string.h> 
 #include "rlgl.h"   
+#include "TerrainShader.h"
+
+// Data types missing from rlgl.h
+#ifndef RL_BYTE
+    #define RL_BYTE 0x1400
+#endif
+#ifndef RL_SHORT
+    #define RL_SHORT 0x1402
+#endif
+
+// Shared arguments of the row tasks that build a chunk
+typedef struct ChunkRowsTask {
+    const HeightPipeline *pipeline;  // Height function
+    float *heights;                  // size * size heights
+    TerrainVertex *vertices;         // Vertices from firstRow on (mesh pass only)
+    int firstRow;                    // Grid row stored at vertices[0]
+    int size;                        // Vertices per side
+    float scale;                     // World units between vertices
+    float maxHeight;                 // Quantization range (mesh pass only)
+    double worldX;                   // Absolute world X of vertex (0, 0)
+    double worldZ;                   // Absolute world Z of vertex (0, 0)
+} ChunkRowsTask;
+
+// Arguments of the culling jobs
+typedef struct ChunkCullTask {
+    TerrainChunk *chunks;
+    Vector4 planes[6];               // Frustum planes, inside is positive
+    float chunkWorldSize;            // Side of a chunk in world units
+    float amplitude;                 // Heights stay within +-amplitude
+} ChunkCullTask;
 
 // Internal functions
-float GetNoiseValue(float x, float z);
-float GetOctaveNoise(float x, float z, int octaves, float persistence, float lacunarity);
-static Mesh GenerateTerrainMesh(int size, float scale, Vector3 offset);
-static void AddTerrainChunk(TerrainManager *terrain, Vector3 offset);
+static void RunChunkRows(TerrainManager *terrain, JobRangeFunction task, ChunkRowsTask *data);
+static void GenerateChunkHeights(void *userData, int rowBegin, int rowEnd);
+static void GenerateTerrainMesh(void *userData, int rowBegin, int rowEnd);
+static void CullChunks(void *userData, int begin, int end);
+static void EncodeOctahedralNormal(Vector3 normal, signed char *out);
+static void UploadTerrainChunk(TerrainManager *terrain, TerrainChunk *chunk);
+static void LoadTerrainRenderer(TerrainManager *terrain);
+static void AddTerrainChunk(TerrainManager *terrain, int chunkX, int chunkZ, const Vector2 *hull, int hullCount, Vector2 focus);
+static void RemoveTerrainChunk(TerrainManager *terrain, int index);
+static int FindChunk(const TerrainManager *terrain, int chunkX, int chunkZ);
+static void RebuildChunkSlots(TerrainManager *terrain);
+static void UpdateCoarseHeights(TerrainManager *terrain, Vector3 focus);
+static float GetCoarseHeight(const TerrainManager *terrain, float x, float z);
+static int FindChunkToEvict(TerrainManager *terrain, const Vector2 *hull, int hullCount, Vector2 focus, float distanceSqr);
+static float GetChunkDistanceSqr(TerrainManager *terrain, Vector3 position, Vector2 focus);
 static bool IsChunkLoaded(TerrainManager *terrain, int chunkX, int chunkZ);
-static void UnloadFarChunks(TerrainManager *terrain, Vector3 planePosition, float chunkSize, int maxRange);
-
-// FastNoiseLite state
-static fnl_state noise;
+static void UnloadChunksOutside(TerrainManager *terrain, const Vector2 *hull, int hullCount, float margin);
+static int ComputeStreamingFootprint(TerrainManager *terrain, Camera camera, Vector3 planeForward, Vector2 *hull);
+static int ConvexHull(const Vector2 *points, int count, Vector2 *hull);
+static bool RectIntersectsHull(const Vector2 *hull, int hullCount, float minX, float minZ, float maxX, float maxZ, float margin);
+
+TerrainConfig GetDefaultTerrainConfig(void) {
+    TerrainConfig config = { 0 };
+
+    config.height = GetDefaultHeightPipelineDesc();
+
+    config.chunkSize = CHUNK_SIZE;
+    config.tileScale = TILE_SCALE;
+    config.viewDistance = TERRAIN_VIEW_DISTANCE;
+    config.prefetchMargin = TERRAIN_PREFETCH_MARGIN;
+    config.prefetchAhead = TERRAIN_PREFETCH_AHEAD;
+    config.jobs = NULL;
+    config.propSpacing = TERRAIN_PROP_SPACING;
+    config.propDensity = TERRAIN_PROP_DENSITY;
+    config.impostorDistance = TERRAIN_IMPOSTOR_DISTANCE;
+    config.headless = false;
+
+    // Water, sand, grass, rock and snow bands
+    config.colorStops[0] = (TerrainColorStop){ 0.0f, BLUE };
+    config.colorStops[1] = (TerrainColorStop){ 0.2f, BEIGE };
+    config.colorStops[2] = (TerrainColorStop){ 0.5f, GREEN };
+    config.colorStops[3] = (TerrainColorStop){ 0.8f, DARKGRAY };
+    config.colorStops[4] = (TerrainColorStop){ 1.0f, WHITE };
+    config.colorStopCount = 5;
+
+    return config;
+}
 
 void InitTerrain(TerrainManager *terrain) {
-    terrain->chunkCount = 0;
+    InitTerrainEx(terrain, GetDefaultTerrainConfig());
+}
 
-    // Initialize FastNoiseLite
-    noise = fnlCreateState();
-    noise.seed = 1000;
-    noise.noise_type = FNL_NOISE_OPENSIMPLEX2;
-    noise.frequency = NOISE_FREQUENCY;
+void InitTerrainEx(TerrainManager *terrain, TerrainConfig config) {
+    terrain->chunkCount = 0;
+    terrain->chunkSize = (int)Clamp((float)config.chunkSize, TERRAIN_MIN_CHUNK_SIZE, TERRAIN_MAX_CHUNK_SIZE);
+    terrain->tileScale = config.tileScale;
+    terrain->viewDistance = config.viewDistance;
+    terrain->prefetchMargin = config.prefetchMargin;
+    terrain->prefetchAhead = config.prefetchAhead;
+    terrain->chunksGenerated = 0;
+    terrain->chunksEvicted = 0;
+    terrain->headless = config.headless;
+    terrain->originChunkX = 0;
+    terrain->originChunkZ = 0;
+
+    // Split chunks whose vertices do not fit 16-bit indices into row bands sharing one edge row
+    int size = terrain->chunkSize;
+    terrain->bandRows = size * size <= 65536 ? size : 65536 / size;
+    terrain->bandCount = (size - 2) / (terrain->bandRows - 1) + 1;
+
+    InitChunkCache(&terrain->cache, CHUNK_CACHE_BUDGET, CHUNK_CACHE_QUANTIZE);
+    RebuildChunkSlots(terrain);
+    terrain->coarseHeights = (float *)RL_MALLOC(TERRAIN_COARSE_SIZE * TERRAIN_COARSE_SIZE * sizeof(float));
+    terrain->coarseValid = false;
+    terrain->bytesUploaded = 0;
+    terrain->bytesUploadedLegacy = 0;
+    BuildTerrainColorLUT(terrain->colorLut, TERRAIN_COLOR_LUT_SIZE, config.colorStops, config.colorStopCount);
+    if (!terrain->headless) LoadTerrainRenderer(terrain);
+    terrain->jobs = config.jobs;
+    terrain->visibleChunks = 0;
+
+    // Resolve every per-octave constant of the height function once
+    terrain->heightPipeline = CompileHeightPipeline(config.height);
+
+    // Props need their models for impostor baking, so a headless terrain has none
+    if (!terrain->headless) InitPropScatter(&terrain->scatter, config.height.seed, config.propSpacing, config.propDensity);
+    else terrain->scatter = (PropScatter){ 0 };
+    terrain->propsDirty = true;
+    terrain->propCount = 0;
+    terrain->impostorDistance = config.impostorDistance;
+    terrain->propMeshInstances = 0;
+    terrain->propImpostors = 0;
 }
 
 void UpdateTerrain(TerrainManager *terrain, Vector3 planePosition, Vector3 planeForward, Camera camera) {
-    float chunkSize = (CHUNK_SIZE - 1) * TILE_SCALE;
-
-    // Calculate the visible area
-    float maxDistance = camera.fovy * (float)720 / 1080;
-    int range = ceilf(maxDistance / chunkSize) + 1;
-
-    // Determine the chunk coordinates the plane is currently over
-    int planeChunkX = (int)floorf(planePosition.x / chunkSize);
-    int planeChunkZ = (int)floorf(planePosition.z / chunkSize);
-
-    // Normalize the plane's forward direction to get chunk offsets
-    Vector2 forwardDir = Vector2Normalize((Vector2){ planeForward.x, planeForward.z });
-
-    // Loop over the range to generate chunks ahead and around the plane
-    for (int z = -range; z <= range; z++) {
-        for (int x = -range; x <= range; x++) {
-            int offsetX = planeChunkX + x;
-            int offsetZ = planeChunkZ + z;
-
-            if (!IsChunkLoaded(terrain, offsetX, offsetZ)) {
-                Vector3 chunkPosition = {
-                    offsetX * chunkSize,
-                    0,
-                    offsetZ * chunkSize
-                };
-                AddTerrainChunk(terrain, chunkPosition);
-            }
+    float chunkSize = (terrain->chunkSize - 1) * terrain->tileScale;
+
+    // Ground off the resident chunks, read by GetTerrainHeight from any thread until the next update
+    UpdateCoarseHeights(terrain, camera.position);
+
+    // Ground area the camera can see, stretched ahead of the plane
+    Vector2 hull[TERRAIN_FOOTPRINT_POINTS];
+    int hullCount = ComputeStreamingFootprint(terrain, camera, planeForward, hull);
+
+    // Drop chunks well outside the footprint first so the new ones fit in MAX_CHUNKS
+    UnloadChunksOutside(terrain, hull, hullCount, 2.0f * terrain->prefetchMargin);
+
+    float minX = hull[0].x, maxX = hull[0].x;
+    float minZ = hull[0].y, maxZ = hull[0].y;
+    for (int i = 1; i < hullCount; i++) {
+        minX = fminf(minX, hull[i].x);
+        maxX = fmaxf(maxX, hull[i].x);
+        minZ = fminf(minZ, hull[i].y);
+        maxZ = fmaxf(maxZ, hull[i].y);
+    }
+
+    float margin = terrain->prefetchMargin;
+    int startX = (int)floorf((minX - margin) / chunkSize);
+    int endX = (int)floorf((maxX + margin) / chunkSize);
+    int startZ = (int)floorf((minZ - margin) / chunkSize);
+    int endZ = (int)floorf((maxZ + margin) / chunkSize);
+
+    // Load every chunk whose square touches the footprint, nearer chunks win once MAX_CHUNKS are resident
+    Vector2 focus = { camera.position.x, camera.position.z };
+    for (int z = startZ; z <= endZ; z++) {
+        for (int x = startX; x <= endX; x++) {
+            if (IsChunkLoaded(terrain, terrain->originChunkX + x, terrain->originChunkZ + z)) continue;
+            if (!RectIntersectsHull(hull, hullCount, x * chunkSize, z * chunkSize, (x + 1) * chunkSize, (z + 1) * chunkSize, margin)) continue;
+
+            AddTerrainChunk(terrain, terrain->originChunkX + x, terrain->originChunkZ + z, hull, hullCount, focus);
         }
     }
 }
 
-void UnloadFarChunks(TerrainManager *terrain, Vector3 planePosition, float chunkSize, int maxRange) {
-    float maxDistance = maxRange * chunkSize;
+Vector3 RebaseTerrainOrigin(TerrainManager *terrain, Vector3 focus) {
+    if (fabsf(focus.x) < TERRAIN_REBASE_DISTANCE && fabsf(focus.z) < TERRAIN_REBASE_DISTANCE) {
+        return (Vector3){ 0.0f, 0.0f, 0.0f };
+    }
+
+    // Shift by whole chunks so chunk corners stay exactly representable
+    float chunkSize = (terrain->chunkSize - 1) * terrain->tileScale;
+    int shiftX = (int)floorf(focus.x / chunkSize);
+    int shiftZ = (int)floorf(focus.z / chunkSize);
+    Vector3 shift = { shiftX * chunkSize, 0.0f, shiftZ * chunkSize };
+
+    terrain->originChunkX += shiftX;
+    terrain->originChunkZ += shiftZ;
 
+    // Resident chunks keep their GPU data, only their render-space position moves
     for (int i = 0; i < terrain->chunkCount; i++) {
-        Vector3 chunkCenter = Vector3Add(terrain->chunks[i].position, (Vector3){ chunkSize / 2, 0, chunkSize / 2 });
-        float distance = Vector3Distance(chunkCenter, planePosition);
-
-        if (distance > maxDistance) {
-            // Unload this chunk
-            UnloadModel(terrain->chunks[i].model);
-            // Remove chunk from array
-            for (int j = i; j < terrain->chunkCount - 1; j++) {
-                terrain->chunks[j] = terrain->chunks[j + 1];
-            }
-            terrain->chunkCount--;
+        TerrainChunk *chunk = &terrain->chunks[i];
+        chunk->position.x = (chunk->chunkX - terrain->originChunkX) * chunkSize;
+        chunk->position.z = (chunk->chunkZ - terrain->originChunkZ) * chunkSize;
+    }
+    terrain->propsDirty = true;
+
+    return shift;
+}
+
+static void UnloadChunksOutside(TerrainManager *terrain, const Vector2 *hull, int hullCount, float margin) {
+    float chunkSize = (terrain->chunkSize - 1) * terrain->tileScale;
+
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        Vector3 position = terrain->chunks[i].position;
+
+        if (!RectIntersectsHull(hull, hullCount, position.x, position.z, position.x + chunkSize, position.z + chunkSize, margin)) {
+            RemoveTerrainChunk(terrain, i);
             i--; // Adjust index after removal
         }
     }
 }
 
-void DrawTerrain(TerrainManager *terrain) {
-    for (int i = 0; i < terrain->chunkCount; i++) {
-        DrawModel(terrain->chunks[i].model, terrain->chunks[i].position, 1.0f, WHITE);
+// Projects the camera frustum onto the ground: the apex plus every corner ray, cut where it
+// reaches the lowest possible terrain or the view distance, plus where the edges of the far
+// face cross that ground. The same points shifted along the flight direction are added, and
+// the convex hull of all of them is returned on XZ.
+static int ComputeStreamingFootprint(TerrainManager *terrain, Camera camera, Vector3 planeForward, Vector2 *hull) {
+    Vector3 forward = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector3 right = Vector3CrossProduct(forward, camera.up);
+    if (Vector3LengthSqr(right) < 1e-6f) right = Vector3CrossProduct(forward, (Vector3){ 0.0f, 1.0f, 0.0f });
+    right = Vector3Normalize(right);
+    Vector3 up = Vector3CrossProduct(right, forward);
+
+    float aspect = (float)SCREEN_ASPECT_WIDTH / SCREEN_ASPECT_HEIGHT;
+    if (IsWindowReady() && GetScreenHeight() > 0) aspect = (float)GetScreenWidth() / GetScreenHeight();
+
+    float tanY = tanf(camera.fovy * 0.5f * DEG2RAD);
+    float tanX = tanY * aspect;
+    float groundY = -terrain->heightPipeline.amplitude;
+
+    Vector2 points[TERRAIN_FOOTPRINT_POINTS];
+    int count = 0;
+    points[count++] = (Vector2){ camera.position.x, camera.position.z };
+
+    // Corners in winding order, so consecutive ones share an edge of the far face
+    Vector3 farCorners[4];
+    for (int corner = 0; corner < 4; corner++) {
+        float sx = (corner == 1 || corner == 2) ? 1.0f : -1.0f;
+        float sy = (corner >= 2) ? 1.0f : -1.0f;
+        Vector3 direction = Vector3Normalize(Vector3Add(forward, Vector3Add(Vector3Scale(right, sx * tanX), Vector3Scale(up, sy * tanY))));
+        farCorners[corner] = Vector3Add(camera.position, Vector3Scale(direction, terrain->viewDistance));
+
+        float distance = terrain->viewDistance;
+        if (direction.y < 0.0f) {
+            float groundDistance = (groundY - camera.position.y) / direction.y;
+            if (groundDistance >= 0.0f && groundDistance < distance) distance = groundDistance;
+        }
+
+        Vector3 point = Vector3Add(camera.position, Vector3Scale(direction, distance));
+        points[count++] = (Vector2){ point.x, point.z };
     }
+
+    // A far edge reaching below the ground bounds the footprint where it crosses it,
+    // beyond the ends of the shortened corner rays
+    for (int corner = 0; corner < 4; corner++) {
+        Vector3 a = farCorners[corner];
+        Vector3 b = farCorners[(corner + 1) % 4];
+        if ((a.y < groundY) == (b.y < groundY)) continue;
+
+        float t = (groundY - a.y) / (b.y - a.y);
+        points[count++] = (Vector2){ a.x + t * (b.x - a.x), a.z + t * (b.z - a.z) };
+    }
+
+    // Bias the prefetch along the flight direction
+    Vector2 ahead = Vector2Normalize((Vector2){ planeForward.x, planeForward.z });
+    ahead = Vector2Scale(ahead, terrain->prefetchAhead);
+    int groundCount = count;
+    for (int i = 0; i < groundCount; i++) {
+        points[count++] = Vector2Add(points[i], ahead);
+    }
+
+    return ConvexHull(points, count, hull);
 }
 
-void UnloadTerrain(TerrainManager *terrain) {
-    for (int i = 0; i < terrain->chunkCount; i++) {
-        UnloadModel(terrain->chunks[i].model);
+// Gift wrapping, fine for the handful of footprint points. Returns a counter-clockwise hull.
+static int ConvexHull(const Vector2 *points, int count, Vector2 *hull) {
+    int start = 0;
+    for (int i = 1; i < count; i++) {
+        if (points[i].x < points[start].x || (points[i].x == points[start].x && points[i].y < points[start].y)) start = i;
     }
-    terrain->chunkCount = 0;
+
+    int hullCount = 0;
+    int current = start;
+    do {
+        hull[hullCount++] = points[current];
+
+        int next = (current + 1) % count;
+        for (int i = 0; i < count; i++) {
+            Vector2 a = Vector2Subtract(points[next], points[current]);
+            Vector2 b = Vector2Subtract(points[i], points[current]);
+            float cross = a.x * b.y - a.y * b.x;
+
+            // Take the most clockwise candidate, preferring the farther one when collinear
+            if (cross < 0.0f || (cross == 0.0f && Vector2LengthSqr(b) > Vector2LengthSqr(a))) next = i;
+        }
+        current = next;
+    } while (current != start && hullCount < count);
+
+    return hullCount;
 }
 
-// Customizable parameters for Perlin noise
-#define NOISE_OCTAVES 4
-#define NOISE_PERSISTENCE 0.5f
-#define NOISE_LACUNARITY 2.0f
+// Separating axis test between a counter-clockwise convex hull and a rectangle grown by margin
+static bool RectIntersectsHull(const Vector2 *hull, int hullCount, float minX, float minZ, float maxX, float maxZ, float margin) {
+    minX -= margin;
+    minZ -= margin;
+    maxX += margin;
+    maxZ += margin;
+
+    // Rectangle axes
+    bool left = true, right = true, below = true, above = true;
+    for (int i = 0; i < hullCount; i++) {
+        left = left && hull[i].x < minX;
+        right = right && hull[i].x > maxX;
+        below = below && hull[i].y < minZ;
+        above = above && hull[i].y > maxZ;
+    }
+    if (left || right || below || above) return false;
+
+    // Hull edge normals: separated when every rectangle corner is outside one edge
+    Vector2 corners[4] = { { minX, minZ }, { maxX, minZ }, { maxX, maxZ }, { minX, maxZ } };
+    for (int i = 0; i < hullCount; i++) {
+        Vector2 a = hull[i];
+        Vector2 edge = Vector2Subtract(hull[(i + 1) % hullCount], a);
+
+        bool outside = true;
+        for (int c = 0; c < 4 && outside; c++) {
+            Vector2 offset = Vector2Subtract(corners[c], a);
+            outside = edge.x * offset.y - edge.y * offset.x < 0.0f;
+        }
+        if (outside) return false;
+    }
 
-// Generate multi-octave noise for terrain
-float GetOctaveNoise(float x, float z, int octaves, float persistence, float lacunarity) {
-    float amplitude = 1.0f;
-    float frequency = 1.0f;
-    float noiseHeight = 0.0f;
-    float maxPossibleHeight = 0.0f;
+    return true;
+}
 
-    for (int i = 0; i < octaves; i++) {
-        float sampleX = x * frequency;
-        float sampleZ = z * frequency;
-        float noiseValue = GetNoiseValue(sampleX, sampleZ) * 2.0f - 1.0f;
+void DrawTerrain(TerrainManager *terrain) {
+    if (terrain->headless) return;
+
+    // Flush raylib's batch so the terrain draws use the current matrices
+    rlDrawRenderBatchActive();
+
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    int chunkSize = terrain->chunkSize;
+    float tileScale = terrain->tileScale;
+    float heightScale = terrain->heightPipeline.amplitude;
+    float colorHeight = terrain->heightPipeline.amplitude;
+
+    rlEnableShader(terrain->shader.id);
+    rlSetUniformMatrix(terrain->shaderLocs[0], mvp);
+    rlSetUniform(terrain->shaderLocs[2], &chunkSize, SHADER_UNIFORM_INT, 1);
+    rlSetUniform(terrain->shaderLocs[3], &tileScale, SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(terrain->shaderLocs[4], &heightScale, SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(terrain->shaderLocs[5], &colorHeight, SHADER_UNIFORM_FLOAT, 1);
+
+    // Frustum planes straight from the rows of the view-projection matrix
+    ChunkCullTask cull;
+    cull.chunks = terrain->chunks;
+    cull.chunkWorldSize = (chunkSize - 1) * tileScale;
+    cull.amplitude = terrain->heightPipeline.amplitude;
+    float rows[4][4] = {
+        { mvp.m0, mvp.m4, mvp.m8, mvp.m12 },
+        { mvp.m1, mvp.m5, mvp.m9, mvp.m13 },
+        { mvp.m2, mvp.m6, mvp.m10, mvp.m14 },
+        { mvp.m3, mvp.m7, mvp.m11, mvp.m15 }
+    };
+    for (int i = 0; i < 6; i++) {
+        float sign = (i & 1) ? -1.0f : 1.0f;
+        const float *row = rows[i / 2];
+        cull.planes[i] = (Vector4){ rows[3][0] + sign * row[0], rows[3][1] + sign * row[1], rows[3][2] + sign * row[2], rows[3][3] + sign * row[3] };
+    }
+    ParallelFor(terrain->jobs, terrain->chunkCount, TERRAIN_CULL_GRAIN, CullChunks, &cull);
 
-        noiseHeight += noiseValue * amplitude;
-        maxPossibleHeight += amplitude;
+    int lutSlot = 0;
+    rlActiveTextureSlot(lutSlot);
+    rlEnableTexture(terrain->colorLutTexture.id);
+    rlSetUniform(terrain->shaderLocs[6], &lutSlot, SHADER_UNIFORM_INT, 1);
 
-        amplitude *= persistence;
-        frequency *= lacunarity;
+    terrain->visibleChunks = 0;
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        if (!terrain->chunks[i].visible) continue;
+        terrain->visibleChunks++;
+
+        for (int band = 0; band < terrain->bandCount; band++) {
+            int startRow = band * (terrain->bandRows - 1);
+            int rows = terrain->chunkSize - startRow < terrain->bandRows ? terrain->chunkSize - startRow : terrain->bandRows;
+
+            // Vertex IDs restart at every band, so shift the origin to the band's first row
+            Vector3 origin = terrain->chunks[i].position;
+            origin.z += startRow * tileScale;
+
+            rlSetUniform(terrain->shaderLocs[1], &origin, SHADER_UNIFORM_VEC3, 1);
+            rlEnableVertexArray(terrain->chunks[i].vaoIds[band]);
+            rlDrawVertexArrayElements(0, (rows - 1) * (chunkSize - 1) * 6, 0);
+        }
     }
 
-    return noiseHeight / maxPossibleHeight; // Normalize height to [-1, 1]
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+
+    // Camera position from the view matrix, DrawTerrain runs inside BeginMode3D
+    Matrix view = MatrixInvert(rlGetMatrixModelview());
+    Vector3 cameraPosition = { view.m12, view.m13, view.m14 };
+    float chunkWorldSize = (chunkSize - 1) * tileScale;
+
+    // Whole chunks switch between meshes and impostors, by their closest point to the camera
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        TerrainChunk *chunk = &terrain->chunks[i];
+        float dx = fmaxf(fmaxf(chunk->position.x - cameraPosition.x, cameraPosition.x - chunk->position.x - chunkWorldSize), 0.0f);
+        float dz = fmaxf(fmaxf(chunk->position.z - cameraPosition.z, cameraPosition.z - chunk->position.z - chunkWorldSize), 0.0f);
+        bool near = dx * dx + dz * dz < terrain->impostorDistance * terrain->impostorDistance;
+
+        if (near != chunk->propsNear) {
+            chunk->propsNear = near;
+            terrain->propsDirty = true;
+        }
+    }
+
+    // Prop transforms only change when chunks come, go, move or change detail
+    if (terrain->propsDirty) {
+        ClearPropBatches(&terrain->scatter);
+        terrain->propMeshInstances = 0;
+        for (int i = 0; i < terrain->chunkCount; i++) {
+            if (!terrain->chunks[i].propsNear) continue;
+            AppendPropBatch(&terrain->scatter, terrain->chunks[i].props, terrain->chunks[i].propCount, terrain->chunks[i].position);
+            terrain->propMeshInstances += terrain->chunks[i].propCount;
+        }
+        terrain->propsDirty = false;
+    }
+    DrawPropBatches(&terrain->scatter);
+
+    // Impostors face the camera, so they are rebuilt every frame into a single batch
+    BeginImpostors(&terrain->scatter.impostors, cameraPosition, WHITE);
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        if (terrain->chunks[i].propsNear || !terrain->chunks[i].visible) continue;
+        DrawPropImpostors(&terrain->scatter, terrain->chunks[i].props, terrain->chunks[i].propCount, terrain->chunks[i].position);
+    }
+    EndImpostors(&terrain->scatter.impostors);
+    terrain->propImpostors = terrain->scatter.impostors.quadCount;
 }
 
-float GetNoiseValue(float x, float z) {
-    // Get noise value from FastNoiseLite
-    return fnlGetNoise2D(&noise, x, z) * NOISE_AMPLITUDE;
+void UnloadTerrain(TerrainManager *terrain) {
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        if (!terrain->headless) {
+            for (int band = 0; band < terrain->bandCount; band++) {
+                rlUnloadVertexArray(terrain->chunks[i].vaoIds[band]);
+            }
+            rlUnloadVertexBuffer(terrain->chunks[i].vboId);
+        }
+        RL_FREE(terrain->chunks[i].heights);
+        RL_FREE(terrain->chunks[i].props);
+    }
+    terrain->chunkCount = 0;
+    terrain->propCount = 0;
+    RebuildChunkSlots(terrain);
+    RL_FREE(terrain->coarseHeights);
+    terrain->coarseHeights = NULL;
+    terrain->coarseValid = false;
+    UnloadChunkCache(&terrain->cache);
+    if (terrain->headless) return;
+
+    rlUnloadVertexBuffer(terrain->indexBufferId);
+    UnloadTexture(terrain->colorLutTexture);
+    UnloadShader(terrain->shader);
+    UnloadPropScatter(&terrain->scatter);
 }
 
 // Color ColorLerp(Color colorA, Color colorB, float t) {
@@ -138,120 +476,296 @@ float GetNoiseValue(float x, float z) {
 // }
 
 static bool IsChunkLoaded(TerrainManager *terrain, int chunkX, int chunkZ) {
-    float chunkSize = (CHUNK_SIZE - 1) * TILE_SCALE;
-    float posX = chunkX * chunkSize;
-    float posZ = chunkZ * chunkSize;
+    return FindChunk(terrain, chunkX, chunkZ) >= 0;
+}
+
+// Linear probing from the hashed slot, resident chunks never fill more than half the table
+static int FindChunk(const TerrainManager *terrain, int chunkX, int chunkZ) {
+    unsigned int slot = ((unsigned int)chunkX * 73856093u ^ (unsigned int)chunkZ * 19349663u) & (TERRAIN_CHUNK_SLOTS - 1);
+
+    for (int index; (index = terrain->chunkSlots[slot] - 1) >= 0; slot = (slot + 1) & (TERRAIN_CHUNK_SLOTS - 1)) {
+        if (terrain->chunks[index].chunkX == chunkX && terrain->chunks[index].chunkZ == chunkZ) return index;
+    }
+    return -1;
+}
+
+// Removing a chunk shifts the ones after it, so the slots are rebuilt rather than patched
+static void RebuildChunkSlots(TerrainManager *terrain) {
+    memset(terrain->chunkSlots, 0, sizeof(terrain->chunkSlots));
 
     for (int i = 0; i < terrain->chunkCount; i++) {
-        if ((terrain->chunks[i].position.x == posX) && (terrain->chunks[i].position.z == posZ)) {
-            return true;
-        }
+        unsigned int slot = ((unsigned int)terrain->chunks[i].chunkX * 73856093u ^ (unsigned int)terrain->chunks[i].chunkZ * 19349663u) & (TERRAIN_CHUNK_SLOTS - 1);
+        while (terrain->chunkSlots[slot]) slot = (slot + 1) & (TERRAIN_CHUNK_SLOTS - 1);
+        terrain->chunkSlots[slot] = (short)(i + 1);
     }
-    return false;
 }
 
-static void AddTerrainChunk(TerrainManager *terrain, Vector3 offset) {
+static void AddTerrainChunk(TerrainManager *terrain, int chunkX, int chunkZ, const Vector2 *hull, int hullCount, Vector2 focus) {
+    int size = terrain->chunkSize;
+    float chunkSize = (size - 1) * terrain->tileScale;
+    Vector3 offset = { (chunkX - terrain->originChunkX) * chunkSize, 0, (chunkZ - terrain->originChunkZ) * chunkSize };
+
     if (terrain->chunkCount >= MAX_CHUNKS) {
-        // Remove the oldest chunk
-        UnloadModel(terrain->chunks[0].model);
-        for (int i = 1; i < terrain->chunkCount; i++) {
-            terrain->chunks[i - 1] = terrain->chunks[i];
-        }
-        terrain->chunkCount--;
+        int evict = FindChunkToEvict(terrain, hull, hullCount, focus, GetChunkDistanceSqr(terrain, offset, focus));
+        if (evict < 0) return;  // Every resident chunk is needed more than this one
+
+        RemoveTerrainChunk(terrain, evict);
+        terrain->chunksEvicted++;
     }
 
-    // Generate new chunk
-    Mesh mesh = GenerateTerrainMesh(CHUNK_SIZE, TILE_SCALE, offset);
-    Model model = LoadModelFromMesh(mesh);
+    // Reuse the heightfield of a recently evicted chunk, otherwise generate it
+    float *heights = (float *)RL_MALLOC(size * size * sizeof(float));
+    if (!ChunkCacheFetch(&terrain->cache, chunkX, chunkZ, heights, size)) {
+        GenerateTerrainHeightmap(terrain, heights, size, terrain->tileScale, (double)chunkX * chunkSize, (double)chunkZ * chunkSize);
+        terrain->chunksGenerated++;
+    }
 
-    terrain->chunks[terrain->chunkCount].position = offset;
-    terrain->chunks[terrain->chunkCount].mesh = mesh;
-    terrain->chunks[terrain->chunkCount].model = model;
+    TerrainChunk *chunk = &terrain->chunks[terrain->chunkCount];
+    chunk->position = offset;
+    chunk->chunkX = chunkX;
+    chunk->chunkZ = chunkZ;
+    chunk->heights = heights;
+    UploadTerrainChunk(terrain, chunk);
+
+    // Props are cheap to place again and depend only on the chunk, so they are never cached
+    chunk->propCount = 0;
+    chunk->props = NULL;
+    chunk->propsNear = false;
+    chunk->visible = true;
+    if (terrain->scatter.maxDensity > 0.0f) {
+        chunk->propCount = ScatterChunkProps(&terrain->scatter, chunkX, chunkZ, heights, size, terrain->tileScale, terrain->heightPipeline.amplitude, &chunk->props);
+    }
+    terrain->propCount += chunk->propCount;
+    terrain->propsDirty = true;
 
     terrain->chunkCount++;
+    RebuildChunkSlots(terrain);
 }
 
-static Mesh GenerateTerrainMesh(int size, float scale, Vector3 offset) {
-    int vertexCount = size * size;
-    Mesh mesh = { 0 };
+static void RemoveTerrainChunk(TerrainManager *terrain, int index) {
+    TerrainChunk *chunk = &terrain->chunks[index];
+
+    // Keep the CPU heightfield around so re-entering the chunk skips noise generation
+    ChunkCacheStore(&terrain->cache, chunk->chunkX, chunk->chunkZ, chunk->heights, terrain->chunkSize);
+    RL_FREE(chunk->heights);
+    RL_FREE(chunk->props);
+    terrain->propCount -= chunk->propCount;
+    terrain->propsDirty = true;
+    if (!terrain->headless) {
+        for (int band = 0; band < terrain->bandCount; band++) {
+            rlUnloadVertexArray(chunk->vaoIds[band]);
+        }
+        rlUnloadVertexBuffer(chunk->vboId);
+    }
 
-    mesh.vertexCount = vertexCount;
-    mesh.triangleCount = (size - 1) * (size - 1) * 2;
+    for (int i = index; i < terrain->chunkCount - 1; i++) {
+        terrain->chunks[i] = terrain->chunks[i + 1];
+    }
+    terrain->chunkCount--;
+    RebuildChunkSlots(terrain);
+}
 
-    // Allocate memory for mesh data
-    mesh.vertices = (float *)RL_MALLOC(mesh.vertexCount * 3 * sizeof(float));    // 3 components (x, y, z)
-    mesh.texcoords = (float *)RL_MALLOC(mesh.vertexCount * 2 * sizeof(float));   // 2 components (u, v)
-    mesh.normals = (float *)RL_CALLOC(mesh.vertexCount * 3, sizeof(float));      // Initialize to zero
-    mesh.colors = (unsigned char *)RL_MALLOC(mesh.vertexCount * 4 * sizeof(unsigned char)); // Colors (r, g, b, a)
-    mesh.indices = (unsigned short *)RL_MALLOC(mesh.triangleCount * 3 * sizeof(unsigned short));
+// The farthest chunk outside the footprint, those are only kept as hysteresis. With every
+// chunk inside it, the farthest one if it is farther than the chunk being added, else -1.
+static int FindChunkToEvict(TerrainManager *terrain, const Vector2 *hull, int hullCount, Vector2 focus, float distanceSqr) {
+    float chunkSize = (terrain->chunkSize - 1) * terrain->tileScale;
+    int farthestOutside = -1, farthestInside = -1;
+    float outsideDistance = -1.0f, insideDistance = distanceSqr;
 
-    int vertexIndex = 0;
-    int texCoordIndex = 0;
-    int colorIndex = 0;
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        Vector3 position = terrain->chunks[i].position;
+        float chunkDistance = GetChunkDistanceSqr(terrain, position, focus);
 
-    // Generate vertices, texcoords, and colors
-    for (int z = 0; z < size; z++) {
-        for (int x = 0; x < size; x++) {
-            float posX = (float)x * scale;
-            float posZ = (float)z * scale;
-            float worldX = posX + offset.x;
-            float worldZ = posZ + offset.z;
-
-            // Generate height using octave noise
-            float posY = GetOctaveNoise(worldX, worldZ, NOISE_OCTAVES, NOISE_PERSISTENCE, NOISE_LACUNARITY);
-
-            // Set vertex positions
-            mesh.vertices[vertexIndex++] = posX;
-            mesh.vertices[vertexIndex++] = posY;
-            mesh.vertices[vertexIndex++] = posZ;
-
-            // Set texture coordinates
-            mesh.texcoords[texCoordIndex++] = (float)x / (size - 1);
-            mesh.texcoords[texCoordIndex++] = (float)z / (size - 1);
-
-            // Normalize height to [0, 1]
-            float minHeight = -NOISE_AMPLITUDE;
-            float maxHeight = NOISE_AMPLITUDE;
-            float normalizedHeight = (posY - minHeight) / (maxHeight - minHeight);
-
-            // Define base colors for more detailed transitions
-            Color waterColor = BLUE;
-            Color sandColor = BEIGE;
-            Color grassColor = GREEN;
-            Color rockColor = DARKGRAY;
-            Color snowColor = WHITE;
-
-            // Interpolate colors based on height for more detailed terrain
-            Color color;
-            if (normalizedHeight < 0.2f) {
-                // Water to sand transition
-                float t = normalizedHeight / 0.2f;
-                color = ColorLerp(waterColor, sandColor, t);
-            } else if (normalizedHeight < 0.5f) {
-                // Sand to grass transition
-                float t = (normalizedHeight - 0.2f) / 0.3f;
-                color = ColorLerp(sandColor, grassColor, t);
-            } else if (normalizedHeight < 0.8f) {
-                // Grass to rock transition
-                float t = (normalizedHeight - 0.5f) / 0.3f;
-                color = ColorLerp(grassColor, rockColor, t);
-            } else {
-                // Rock to snow transition
-                float t = (normalizedHeight - 0.8f) / 0.2f;
-                color = ColorLerp(rockColor, snowColor, t);
+        if (!RectIntersectsHull(hull, hullCount, position.x, position.z, position.x + chunkSize, position.z + chunkSize, terrain->prefetchMargin)) {
+            if (chunkDistance > outsideDistance) {
+                outsideDistance = chunkDistance;
+                farthestOutside = i;
             }
+        } else if (chunkDistance > insideDistance) {
+            insideDistance = chunkDistance;
+            farthestInside = i;
+        }
+    }
+
+    return farthestOutside >= 0 ? farthestOutside : farthestInside;
+}
+
+// Squared distance on XZ from the chunk centre to the camera
+static float GetChunkDistanceSqr(TerrainManager *terrain, Vector3 position, Vector2 focus) {
+    float halfSize = 0.5f * (terrain->chunkSize - 1) * terrain->tileScale;
+    float dx = position.x + halfSize - focus.x;
+    float dz = position.z + halfSize - focus.y;
+    return dx * dx + dz * dz;
+}
 
-            // Assign color
-            mesh.colors[colorIndex++] = color.r;
-            mesh.colors[colorIndex++] = color.g;
-            mesh.colors[colorIndex++] = color.b;
-            mesh.colors[colorIndex++] = color.a;
+void GenerateTerrainHeightmap(TerrainManager *terrain, float *heights, int size, float scale, double worldX, double worldZ) {
+    ChunkRowsTask task = { &terrain->heightPipeline, heights, NULL, 0, size, scale, 0.0f, worldX, worldZ };
+    RunChunkRows(terrain, GenerateChunkHeights, &task);
+}
+
+// Small chunks stay on the calling thread, waking helpers costs more than it saves
+static void RunChunkRows(TerrainManager *terrain, JobRangeFunction task, ChunkRowsTask *data) {
+    if (terrain->jobs && data->size >= TERRAIN_PARALLEL_MIN_SIZE) {
+        ParallelFor(terrain->jobs, data->size, TERRAIN_PARALLEL_GRAIN, task, data);
+    } else {
+        task(data, 0, data->size);
+    }
+}
+
+static void GenerateChunkHeights(void *userData, int rowBegin, int rowEnd) {
+    const ChunkRowsTask *task = (const ChunkRowsTask *)userData;
+    int size = task->size;
+
+    for (int z = rowBegin; z < rowEnd; z++) {
+        for (int x = 0; x < size; x++) {
+            double worldX = (double)x * task->scale + task->worldX;
+            double worldZ = (double)z * task->scale + task->worldZ;
+
+            task->heights[z * size + x] = EvaluateHeight(task->pipeline, worldX, worldZ);
         }
     }
+}
+
+// Needs every height of the chunk, so it runs after GenerateChunkHeights has finished
+static void GenerateTerrainMesh(void *userData, int rowBegin, int rowEnd) {
+    const ChunkRowsTask *task = (const ChunkRowsTask *)userData;
+    const float *heights = task->heights;
+    int size = task->size;
+    float scale = task->scale;
+    float heightToShort = 32767.0f / task->maxHeight;
+
+    for (int z = rowBegin; z < rowEnd; z++) {
+        TerrainVertex *vertices = &task->vertices[(z - task->firstRow) * size];
+
+        for (int x = 0; x < size; x++) {
+            float posY = heights[z * size + x];
+
+            // Quantize height to 16 bits over the height pipeline range
+            float quantized = Clamp(posY * heightToShort, -32767.0f, 32767.0f);
+            vertices[x].height = (short)lrintf(quantized);
+
+            // Central differences, clamped at the chunk border
+            int x0 = x > 0 ? x - 1 : x;
+            int x1 = x < size - 1 ? x + 1 : x;
+            int z0 = z > 0 ? z - 1 : z;
+            int z1 = z < size - 1 ? z + 1 : z;
+            float dx = (heights[z * size + x1] - heights[z * size + x0]) / ((x1 - x0) * scale);
+            float dz = (heights[z1 * size + x] - heights[z0 * size + x]) / ((z1 - z0) * scale);
+
+            EncodeOctahedralNormal(Vector3Normalize((Vector3){ -dx, 1.0f, -dz }), vertices[x].normal);
+        }
+    }
+}
+
+// Chunk bounds against every frustum plane, using the corner farthest along the plane normal
+static void CullChunks(void *userData, int begin, int end) {
+    const ChunkCullTask *task = (const ChunkCullTask *)userData;
+
+    for (int i = begin; i < end; i++) {
+        TerrainChunk *chunk = &task->chunks[i];
+        Vector3 min = { chunk->position.x, -task->amplitude, chunk->position.z };
+        Vector3 max = { chunk->position.x + task->chunkWorldSize, task->amplitude, chunk->position.z + task->chunkWorldSize };
+
+        bool visible = true;
+        for (int p = 0; p < 6 && visible; p++) {
+            Vector4 plane = task->planes[p];
+            float x = plane.x >= 0.0f ? max.x : min.x;
+            float y = plane.y >= 0.0f ? max.y : min.y;
+            float z = plane.z >= 0.0f ? max.z : min.z;
+            visible = plane.x * x + plane.y * y + plane.z * z + plane.w >= 0.0f;
+        }
+        chunk->visible = visible;
+    }
+}
+
+// Octahedral encoding with Y as the folding axis (terrain normals mostly point up)
+static void EncodeOctahedralNormal(Vector3 normal, signed char *out) {
+    float invL1 = 1.0f / (fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z));
+    float u = normal.x * invL1;
+    float v = normal.z * invL1;
+
+    if (normal.y < 0.0f) {
+        float foldedU = (1.0f - fabsf(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        float foldedV = (1.0f - fabsf(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = foldedU;
+        v = foldedV;
+    }
+
+    out[0] = (signed char)lrintf(u * 127.0f);
+    out[1] = (signed char)lrintf(v * 127.0f);
+}
+
+static void UploadTerrainChunk(TerrainManager *terrain, TerrainChunk *chunk) {
+    int size = terrain->chunkSize;
+    int vertexCount = size * size;
+    int dataSize = vertexCount * sizeof(TerrainVertex);
+
+    TerrainVertex *vertices = (TerrainVertex *)RL_MALLOC(dataSize);
+    ChunkRowsTask task = { &terrain->heightPipeline, chunk->heights, vertices, 0, size, terrain->tileScale, terrain->heightPipeline.amplitude, 0.0, 0.0 };
+    RunChunkRows(terrain, GenerateTerrainMesh, &task);
+
+    // Headless terrains still encode the vertices, so timings include the whole chunk build
+    if (terrain->headless) {
+        RL_FREE(vertices);
+        return;
+    }
+
+    chunk->vboId = rlLoadVertexBuffer(vertices, dataSize, true);
+
+    int heightLoc = terrain->attribLocs[0];
+    int normalLoc = terrain->attribLocs[1];
+
+    // Each band reads the same buffer from its first row, so vertex IDs stay below 65536
+    for (int band = 0; band < terrain->bandCount; band++) {
+        int bandOffset = band * (terrain->bandRows - 1) * size * sizeof(TerrainVertex);
+
+        chunk->vaoIds[band] = rlLoadVertexArray();
+        rlEnableVertexArray(chunk->vaoIds[band]);
+        rlEnableVertexBuffer(chunk->vboId);
+        rlSetVertexAttribute(heightLoc, 1, RL_SHORT, true, sizeof(TerrainVertex), bandOffset);
+        rlEnableVertexAttribute(heightLoc);
+        rlSetVertexAttribute(normalLoc, 2, RL_BYTE, true, sizeof(TerrainVertex), bandOffset + 2);
+        rlEnableVertexAttribute(normalLoc);
+
+        // Every band shares the same topology, so bind the common index buffer into this VAO
+        rlEnableVertexBufferElement(terrain->indexBufferId);
+        rlDisableVertexArray();
+    }
+
+    RL_FREE(vertices);
+
+    // Legacy Mesh layout: float xyz + float uv + float normal + RGBA8 colour, 16-bit indices per chunk
+    terrain->bytesUploaded += dataSize;
+    terrain->bytesUploadedLegacy += vertexCount * (3 + 2 + 3) * sizeof(float) + vertexCount * 4
+                                    + (size - 1) * (size - 1) * 6 * sizeof(unsigned short);
+}
+
+static void LoadTerrainRenderer(TerrainManager *terrain) {
+    terrain->shader = LoadShaderFromMemory(terrainVertexShader, terrainFragmentShader);
+    terrain->shaderLocs[0] = GetShaderLocation(terrain->shader, "mvp");
+    terrain->shaderLocs[1] = GetShaderLocation(terrain->shader, "chunkOrigin");
+    terrain->shaderLocs[2] = GetShaderLocation(terrain->shader, "chunkSize");
+    terrain->shaderLocs[3] = GetShaderLocation(terrain->shader, "tileScale");
+    terrain->shaderLocs[4] = GetShaderLocation(terrain->shader, "heightScale");
+    terrain->shaderLocs[5] = GetShaderLocation(terrain->shader, "colorHeight");
+    terrain->shaderLocs[6] = GetShaderLocation(terrain->shader, "colorLut");
+    terrain->attribLocs[0] = GetShaderLocationAttrib(terrain->shader, "vertexHeight");
+    terrain->attribLocs[1] = GetShaderLocationAttrib(terrain->shader, "vertexNormal");
+
+    // Upload the gradient table as a 1D texture, filtering reproduces the lerp between entries
+    Image lutImage = { terrain->colorLut, TERRAIN_COLOR_LUT_SIZE, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    terrain->colorLutTexture = LoadTextureFromImage(lutImage);
+    SetTextureFilter(terrain->colorLutTexture, TEXTURE_FILTER_BILINEAR);
+    SetTextureWrap(terrain->colorLutTexture, TEXTURE_WRAP_CLAMP);
+
+    // Generate the grid indices of one full band once for all chunks,
+    // shorter bands draw a prefix since quads are emitted row by row
+    int size = terrain->chunkSize;
+    int indexCount = (terrain->bandRows - 1) * (size - 1) * 6;
+    unsigned short *indices = (unsigned short *)RL_MALLOC(indexCount * sizeof(unsigned short));
 
-    // Generate indices and calculate normals (same as in the original)
     int index = 0;
-    for (int z = 0; z < size - 1; z++) {
+    for (int z = 0; z < terrain->bandRows - 1; z++) {
         for (int x = 0; x < size - 1; x++) {
             int i0 = z * size + x;
             int i1 = i0 + 1;
@@ -259,34 +773,201 @@ static Mesh GenerateTerrainMesh(int size, float scale, Vector3 offset) {
             int i3 = i2 + 1;
 
             // Triangle 1
-            mesh.indices[index++] = i0;
-            mesh.indices[index++] = i2;
-            mesh.indices[index++] = i1;
+            indices[index++] = i0;
+            indices[index++] = i2;
+            indices[index++] = i1;
 
             // Triangle 2
-            mesh.indices[index++] = i1;
-            mesh.indices[index++] = i2;
-            mesh.indices[index++] = i3;
+            indices[index++] = i1;
+            indices[index++] = i2;
+            indices[index++] = i3;
+        }
+    }
+
+    terrain->indexBufferId = rlLoadVertexBufferElement(indices, indexCount * sizeof(unsigned short), false);
+    RL_FREE(indices);
+}
+
+void DeformTerrain(TerrainManager *terrain, Vector3 center, float radius, float depth) {
+    int size = terrain->chunkSize;
+    float scale = terrain->tileScale;
+    float chunkSize = (size - 1) * scale;
+    float amplitude = terrain->heightPipeline.amplitude;
+
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        TerrainChunk *chunk = &terrain->chunks[i];
+        float localX = center.x - chunk->position.x;
+        float localZ = center.z - chunk->position.z;
+
+        if (localX + radius < 0.0f || localX - radius > chunkSize) continue;
+        if (localZ + radius < 0.0f || localZ - radius > chunkSize) continue;
+
+        // Grid rectangle covered by the crater
+        int x0 = (int)Clamp(floorf((localX - radius) / scale), 0, size - 1);
+        int x1 = (int)Clamp(ceilf((localX + radius) / scale), 0, size - 1);
+        int z0 = (int)Clamp(floorf((localZ - radius) / scale), 0, size - 1);
+        int z1 = (int)Clamp(ceilf((localZ + radius) / scale), 0, size - 1);
+
+        // Parabolic bowl, deepest at the centre
+        for (int z = z0; z <= z1; z++) {
+            for (int x = x0; x <= x1; x++) {
+                float dx = x * scale - localX;
+                float dz = z * scale - localZ;
+                float falloff = 1.0f - (dx * dx + dz * dz) / (radius * radius);
+                if (falloff <= 0.0f) continue;
+
+                float *height = &chunk->heights[z * size + x];
+                *height = Clamp(*height - depth * falloff, -amplitude, amplitude);
+            }
+        }
+
+        // Normals read one row either side, so rebuild one row beyond the edit
+        int firstRow = z0 > 0 ? z0 - 1 : 0;
+        int lastRow = z1 < size - 1 ? z1 + 1 : size - 1;
+        int rowCount = lastRow - firstRow + 1;
+        int dataSize = rowCount * size * sizeof(TerrainVertex);
+
+        TerrainVertex *vertices = (TerrainVertex *)RL_MALLOC(dataSize);
+        ChunkRowsTask task = { &terrain->heightPipeline, chunk->heights, vertices, firstRow, size, scale, amplitude, 0.0, 0.0 };
+        GenerateTerrainMesh(&task, firstRow, lastRow + 1);
 
-            // Normals calculation remains unchanged
+        // Rows are contiguous in the buffer, so the dirty range is a single update
+        if (!terrain->headless) {
+            rlUpdateVertexBuffer(chunk->vboId, vertices, dataSize, firstRow * size * sizeof(TerrainVertex));
+            terrain->bytesUploaded += dataSize;
+        }
+        RL_FREE(vertices);
+
+        // Settle props into the crater
+        for (int p = 0; p < chunk->propCount; p++) {
+            PropInstance *prop = &chunk->props[p];
+            float dx = prop->x - localX;
+            float dz = prop->z - localZ;
+            if (dx * dx + dz * dz >= radius * radius) continue;
+
+            prop->y = GetTerrainHeight(terrain, chunk->position.x + prop->x, chunk->position.z + prop->z);
+            terrain->propsDirty = true;
         }
     }
+}
+
+float GetTerrainHeight(const TerrainManager *terrain, float x, float z) {
+    int size = terrain->chunkSize;
+    float scale = terrain->tileScale;
+    float chunkSize = (size - 1) * scale;
+
+    // Chunk grid cell relative to the origin, then the resident chunk covering it if any
+    float gridX = x / chunkSize;
+    float gridZ = z / chunkSize;
+    int cellX = (int)floorf(gridX);
+    int cellZ = (int)floorf(gridZ);
+    int chunkX = terrain->originChunkX + cellX;
+    int chunkZ = terrain->originChunkZ + cellZ;
+    int index = FindChunk(terrain, chunkX, chunkZ);
+
+    // Edges are shared, a point on the low edge of a cell is also the high edge of the one before
+    bool edgeX = gridX - cellX < TERRAIN_EDGE_EPSILON;
+    bool edgeZ = gridZ - cellZ < TERRAIN_EDGE_EPSILON;
+    if (index < 0 && edgeX) index = FindChunk(terrain, chunkX - 1, chunkZ);
+    if (index < 0 && edgeZ) index = FindChunk(terrain, chunkX, chunkZ - 1);
+    if (index < 0 && edgeX && edgeZ) index = FindChunk(terrain, chunkX - 1, chunkZ - 1);
+    if (index < 0) return GetCoarseHeight(terrain, x, z);
+
+    const TerrainChunk *chunk = &terrain->chunks[index];
+    float localX = Clamp((x - chunk->position.x) / scale, 0.0f, size - 1);
+    float localZ = Clamp((z - chunk->position.z) / scale, 0.0f, size - 1);
+
+    // Bilinear interpolation of the resident, possibly deformed, heightfield
+    int gx = localX >= size - 1 ? size - 2 : (int)localX;
+    int gz = localZ >= size - 1 ? size - 2 : (int)localZ;
+    float fx = localX - gx;
+    float fz = localZ - gz;
+    const float *row0 = &chunk->heights[gz * size + gx];
+    const float *row1 = row0 + size;
+
+    return Lerp(Lerp(row0[0], row0[1], fx), Lerp(row1[0], row1[1], fx), fz);
+}
+
+// Scrolls the coarse grid to stay centred on focus. Samples keep their slot while they stay in
+// the window, so only the rows and columns that entered it are evaluated.
+static void UpdateCoarseHeights(TerrainManager *terrain, Vector3 focus) {
+    float spacing = (terrain->chunkSize - 1) * terrain->tileScale / TERRAIN_COARSE_PER_CHUNK;
+    int lowX = terrain->originChunkX * TERRAIN_COARSE_PER_CHUNK + (int)floorf(focus.x / spacing) - TERRAIN_COARSE_SIZE / 2;
+    int lowZ = terrain->originChunkZ * TERRAIN_COARSE_PER_CHUNK + (int)floorf(focus.z / spacing) - TERRAIN_COARSE_SIZE / 2;
+    if (terrain->coarseValid && lowX == terrain->coarseX && lowZ == terrain->coarseZ) return;
+
+    for (int z = lowZ; z < lowZ + TERRAIN_COARSE_SIZE; z++) {
+        bool rowKept = terrain->coarseValid && z >= terrain->coarseZ && z < terrain->coarseZ + TERRAIN_COARSE_SIZE;
+        float *row = &terrain->coarseHeights[(z & (TERRAIN_COARSE_SIZE - 1)) * TERRAIN_COARSE_SIZE];
+
+        for (int x = lowX; x < lowX + TERRAIN_COARSE_SIZE; x++) {
+            if (rowKept && x >= terrain->coarseX && x < terrain->coarseX + TERRAIN_COARSE_SIZE) continue;
+            row[x & (TERRAIN_COARSE_SIZE - 1)] = EvaluateHeight(&terrain->heightPipeline, (double)x * spacing, (double)z * spacing);
+        }
+    }
+
+    terrain->coarseX = lowX;
+    terrain->coarseZ = lowZ;
+    terrain->coarseValid = true;
+}
 
-    // Normalize the accumulated normals
-    for (int i = 0; i < mesh.vertexCount; i++) {
-        Vector3 normal = (Vector3){
-            mesh.normals[i * 3],
-            mesh.normals[i * 3 + 1],
-            mesh.normals[i * 3 + 2]
-        };
-        normal = Vector3Normalize(normal);
-        mesh.normals[i * 3]     = normal.x;
-        mesh.normals[i * 3 + 1] = normal.y;
-        mesh.normals[i * 3 + 2] = normal.z;
+// Bilinear between coarse samples inside the window, the exact height function outside it
+static float GetCoarseHeight(const TerrainManager *terrain, float x, float z) {
+    float chunkSize = (terrain->chunkSize - 1) * terrain->tileScale;
+    float spacing = chunkSize / TERRAIN_COARSE_PER_CHUNK;
+    float sampleX = floorf(x / spacing);
+    float sampleZ = floorf(z / spacing);
+    int gx = terrain->originChunkX * TERRAIN_COARSE_PER_CHUNK + (int)sampleX;
+    int gz = terrain->originChunkZ * TERRAIN_COARSE_PER_CHUNK + (int)sampleZ;
+
+    if (!terrain->coarseValid || gx < terrain->coarseX || gz < terrain->coarseZ ||
+        gx >= terrain->coarseX + TERRAIN_COARSE_SIZE - 1 || gz >= terrain->coarseZ + TERRAIN_COARSE_SIZE - 1) {
+        double worldX = (double)terrain->originChunkX * chunkSize + x;
+        double worldZ = (double)terrain->originChunkZ * chunkSize + z;
+        return EvaluateHeight(&terrain->heightPipeline, worldX, worldZ);
     }
 
-    // Upload mesh to GPU
-    UploadMesh(&mesh, true);
+    float fx = x / spacing - sampleX;
+    float fz = z / spacing - sampleZ;
+    const float *row0 = &terrain->coarseHeights[(gz & (TERRAIN_COARSE_SIZE - 1)) * TERRAIN_COARSE_SIZE];
+    const float *row1 = &terrain->coarseHeights[((gz + 1) & (TERRAIN_COARSE_SIZE - 1)) * TERRAIN_COARSE_SIZE];
+    int x0 = gx & (TERRAIN_COARSE_SIZE - 1);
+    int x1 = (gx + 1) & (TERRAIN_COARSE_SIZE - 1);
 
-    return mesh;
+    return Lerp(Lerp(row0[x0], row0[x1], fx), Lerp(row1[x0], row1[x1], fx), fz);
+}
+
+Color GetTerrainColor(const TerrainManager *terrain, float height) {
+    float amplitude = terrain->heightPipeline.amplitude;
+    float normalizedHeight = (height + amplitude) / (2.0f * amplitude);
+
+    // Blend the two nearest entries as the bilinear LUT texture does, the nearest entry
+    // alone is up to 3 LSB off the gradient where a band spans few entries
+    float position = Clamp(normalizedHeight, 0.0f, 1.0f) * (TERRAIN_COLOR_LUT_SIZE - 1);
+    int index = (int)position;
+    if (index > TERRAIN_COLOR_LUT_SIZE - 2) index = TERRAIN_COLOR_LUT_SIZE - 2;
+    return ColorLerp(terrain->colorLut[index], terrain->colorLut[index + 1], position - (float)index);
+}
+
+// Entry i holds the gradient at i/(size-1), blended like ColorLerp so the table stays
+// within 1 LSB of the former per-vertex gradient, see tools/terraintest
+void BuildTerrainColorLUT(Color *lut, int size, const TerrainColorStop *stops, int stopCount) {
+    int stop = 0;
+
+    for (int i = 0; i < size; i++) {
+        float h = (float)i / (size - 1);
+
+        // Entries are visited in ascending height, so the active band only moves forward
+        while (stop < stopCount - 2 && h >= stops[stop + 1].height) stop++;
+
+        Color a = stops[stop].color;
+        Color b = stops[stopCount > 1 ? stop + 1 : stop].color;
+        float span = stops[stopCount > 1 ? stop + 1 : stop].height - stops[stop].height;
+        float t = span > 0.0f ? Clamp((h - stops[stop].height) / span, 0.0f, 1.0f) : 0.0f;
+
+        lut[i].r = (unsigned char)((1.0f - t) * a.r + t * b.r);
+        lut[i].g = (unsigned char)((1.0f - t) * a.g + t * b.g);
+        lut[i].b = (unsigned char)((1.0f - t) * a.b + t * b.b);
+        lut[i].a = (unsigned char)((1.0f - t) * a.a + t * b.a);
+    }
 }
@@ -2,30 +2,135 @@
 #define TERRAIN_H
 
 #include "raylib.h"
+#include "ChunkCache.h"
+#include "HeightPipeline.h"
+#include "JobSystem.h"
+#include "Scatter.h"
 
-#define CHUNK_SIZE 64          // Size of each terrain chunk
-#define TILE_SCALE 3.0f        // Scaling for each tile
+#define CHUNK_SIZE 64          // Default vertices per chunk side
+#define TILE_SCALE 3.0f        // Default scaling for each tile
+#define TERRAIN_VIEW_DISTANCE 800.0f    // Default camera distance beyond which terrain is not streamed
+#define TERRAIN_PREFETCH_MARGIN 60.0f   // Default margin around the frustum footprint
+#define TERRAIN_PREFETCH_AHEAD 300.0f   // Default extra prefetch along the flight direction
+#define TERRAIN_FOOTPRINT_POINTS 18     // Apex, four corner rays and up to four far edge ground crossings, plus the same shifted ahead
+#define TERRAIN_REBASE_DISTANCE 4096.0f // Distance from the origin that triggers an origin rebase
+#define SCREEN_ASPECT_WIDTH 1080        // Aspect ratio used when no window is open
+#define SCREEN_ASPECT_HEIGHT 720
+#define TERRAIN_MIN_CHUNK_SIZE 2     // Smallest supported chunk
+#define TERRAIN_MAX_CHUNK_SIZE 1024  // Largest supported chunk
+#define TERRAIN_MAX_BANDS 32         // Sub-meshes per chunk, each indexable with 16-bit indices
 #define MAX_CHUNKS 100         // Maximum number of chunks loaded at once
-#define NOISE_AMPLITUDE 10.0f  // Amplitude of noise for terrain generation
-#define NOISE_FREQUENCY 0.01f  // Frequency of noise for terrain generation
+#define TERRAIN_CHUNK_SLOTS 256  // Hash slots of resident chunks, a power of two above 2 * MAX_CHUNKS
+#define TERRAIN_COARSE_SIZE 256        // Coarse height samples per side kept around the camera for ground off the resident chunks
+#define TERRAIN_COARSE_PER_CHUNK 16    // Coarse samples per chunk side, so rebasing keeps them aligned
+#define TERRAIN_EDGE_EPSILON 1e-4f     // Fraction of a chunk within which a point counts as on its low edge
+#define CHUNK_CACHE_BUDGET (4 * 1024 * 1024)  // Bytes kept for heightfields of evicted chunks
+#define CHUNK_CACHE_QUANTIZE true              // Store cached heights as 16-bit values
+#define TERRAIN_COLOR_LUT_SIZE 256             // Entries in the height-to-colour gradient table
+#define TERRAIN_MAX_COLOR_STOPS 8              // Maximum gradient stops in a TerrainConfig
+#define TERRAIN_PARALLEL_MIN_SIZE 128          // Chunks with fewer rows are generated serially
+#define TERRAIN_PARALLEL_GRAIN 4               // Fewest rows per generation job
+#define TERRAIN_CULL_GRAIN 16                  // Fewest chunks per culling job
+#define TERRAIN_PROP_SPACING 12.0f             // Default jittered grid cell size for props
+#define TERRAIN_PROP_DENSITY 0.6f              // Default highest chance of a prop per cell
+#define TERRAIN_IMPOSTOR_DISTANCE 300.0f       // Default distance beyond which chunk props become impostors
+
+// Compact terrain vertex, x/z and uv are implied by the vertex index
+typedef struct TerrainVertex {
+    short height;          // Height normalized over the height pipeline amplitude
+    signed char normal[2]; // Octahedral-encoded normal
+} TerrainVertex;
+
+// Gradient stop, height is normalized over [-amplitude, amplitude] to [0, 1]
+typedef struct TerrainColorStop {
+    float height;
+    Color color;
+} TerrainColorStop;
+
+// Runtime terrain parameters
+typedef struct TerrainConfig {
+    int chunkSize;                                         // Vertices per chunk side
+    float tileScale;                                       // World units between vertices
+    float viewDistance;                                    // Camera distance beyond which terrain is not streamed
+    float prefetchMargin;                                  // Margin around the frustum footprint
+    float prefetchAhead;                                   // Extra prefetch along the flight direction
+    HeightPipelineDesc height;                             // Height function
+    TerrainColorStop colorStops[TERRAIN_MAX_COLOR_STOPS];  // Gradient stops in ascending height
+    int colorStopCount;                                    // Number of used stops
+    JobSystem *jobs;                                       // Shared job system for generation and culling, NULL runs serially
+    float propSpacing;                                     // Jittered grid cell size for trees, rocks and houses
+    float propDensity;                                     // Highest chance of a prop per cell (0 disables props)
+    float impostorDistance;                                // Chunks farther than this draw their props as impostors
+    bool headless;                                         // Keep heights only, no GPU resources or props, for tools without a window
+} TerrainConfig;
 
 // Terrain chunk structure
 typedef struct TerrainChunk {
-    Vector3 position;  // Position of the chunk in the world
-    Mesh mesh;         // Terrain mesh for the chunk
-    Model model;       // Model generated from the mesh
+    Vector3 position;  // Position of the chunk relative to the floating origin
+    int chunkX;        // Absolute chunk grid coordinate on X
+    int chunkZ;        // Absolute chunk grid coordinate on Z
+    float *heights;    // CPU heightfield (chunkSize * chunkSize)
+    unsigned int vaoIds[TERRAIN_MAX_BANDS];  // One vertex array per row band, bound to the shared index buffer
+    unsigned int vboId;  // TerrainVertex buffer for the chunk
+    PropInstance *props; // Trees, rocks and houses standing on the chunk
+    int propCount;       // Number of props
+    bool propsNear;      // Props are drawn as meshes rather than impostors
+    bool visible;        // Inside the view frustum last frame
 } TerrainChunk;
 
 // Terrain manager structure
 typedef struct TerrainManager {
     TerrainChunk chunks[MAX_CHUNKS];  // Array of terrain chunks
     int chunkCount;                   // Number of currently loaded chunks
+    int chunkSize;                    // Vertices per chunk side
+    float tileScale;                  // World units between vertices
+    float viewDistance;               // Camera distance beyond which terrain is not streamed
+    float prefetchMargin;             // Margin around the frustum footprint
+    float prefetchAhead;              // Extra prefetch along the flight direction
+    unsigned int chunksGenerated;     // Chunks whose heights were generated rather than cached
+    int originChunkX;                 // Absolute chunk coordinate of the render-space origin on X
+    int originChunkZ;                 // Absolute chunk coordinate of the render-space origin on Z
+    int bandRows;                     // Vertex rows per sub-mesh, keeps indices below 65536
+    int bandCount;                    // Sub-meshes per chunk
+    ChunkCache cache;                 // Heightfields of recently evicted chunks
+    HeightPipeline heightPipeline;    // Compiled height function
+    JobSystem *jobs;                  // Splits chunk generation and culling across threads, may be NULL
+    int visibleChunks;                // Chunks inside the view frustum last frame
+    PropScatter scatter;              // Prop placement and instanced drawing
+    bool propsDirty;                  // Prop batches need rebuilding after chunks changed or moved
+    int propCount;                    // Props on resident chunks
+    float impostorDistance;           // Chunks farther than this draw their props as impostors
+    int propMeshInstances;            // Props drawn as meshes last frame
+    int propImpostors;                // Props drawn as impostors last frame
+    Shader shader;                    // Reconstructs vertices from TerrainVertex data
+    int shaderLocs[7];                // mvp, chunkOrigin, chunkSize, tileScale, heightScale, colorHeight, colorLut
+    int attribLocs[2];                // vertexHeight, vertexNormal
+    Color colorLut[TERRAIN_COLOR_LUT_SIZE];  // Height-to-colour gradient table
+    Texture2D colorLutTexture;        // colorLut uploaded as a 1D texture
+    unsigned int indexBufferId;       // Index buffer shared by every chunk
+    size_t bytesUploaded;             // Vertex bytes sent to the GPU
+    size_t bytesUploadedLegacy;       // Bytes the float Mesh layout would have sent
+    bool headless;                    // No GPU resources, DrawTerrain does nothing
+    short chunkSlots[TERRAIN_CHUNK_SLOTS];  // Index + 1 of the resident chunk hashed here, 0 when empty
+    float *coarseHeights;             // TERRAIN_COARSE_SIZE^2 heights, addressed by absolute sample modulo the size
+    int coarseX;                      // Absolute coarse sample of the grid's low corner on X
+    int coarseZ;                      // Absolute coarse sample of the grid's low corner on Z
+    bool coarseValid;                 // coarseHeights holds the window at coarseX, coarseZ
+    unsigned int chunksEvicted;       // Resident chunks dropped to make room within MAX_CHUNKS
 } TerrainManager;
 
 // Function declarations
-void InitTerrain(TerrainManager *terrain);                                   // Initialize the terrain system
-void UpdateTerrain(TerrainManager *terrain, Vector3 planePosition, Vector3 planeForward, Camera camera);  // Update terrain chunks based on the camera/plane position
-void DrawTerrain(TerrainManager *terrain);                                   // Draw the loaded terrain chunks
+TerrainConfig GetDefaultTerrainConfig(void);                                 // Default water/sand/grass/rock/snow terrain
+void InitTerrain(TerrainManager *terrain);                                   // Initialize the terrain system with the default config
+void InitTerrainEx(TerrainManager *terrain, TerrainConfig config);           // Initialize the terrain system
+Color GetTerrainColor(const TerrainManager *terrain, float height);          // Gradient colour for a height, filtered between entries like the GPU
+void BuildTerrainColorLUT(Color *lut, int size, const TerrainColorStop *stops, int stopCount);  // Bake colour stops into the gradient table InitTerrainEx uploads
+float GetTerrainHeight(const TerrainManager *terrain, float x, float z);    // Terrain height at a render-space position, including deformation
+void DeformTerrain(TerrainManager *terrain, Vector3 center, float radius, float depth);  // Carve a crater into resident chunks, re-uploading only the dirty rows
+void GenerateTerrainHeightmap(TerrainManager *terrain, float *heights, int size, float scale, double worldX, double worldZ);  // Fill size * size heights from an absolute world corner, e.g. for a map preview
+void UpdateTerrain(TerrainManager *terrain, Vector3 planePosition, Vector3 planeForward, Camera camera);  // Update terrain chunks based on the camera/plane position (render space)
+Vector3 RebaseTerrainOrigin(TerrainManager *terrain, Vector3 focus);        // Move the origin near focus, returns the shift to subtract from every render-space position
+void DrawTerrain(TerrainManager *terrain);                                   // Draw the loaded terrain chunks and their props
 void UnloadTerrain(TerrainManager *terrain);                                 // Unload all loaded terrain chunks
 //Color ColorLerp(Color colorA, Color colorB, float t);
 
@@ -0,0 +1,93 @@
+// TerrainShader.h
+#ifndef TERRAINSHADER_H
+#define TERRAINSHADER_H
+
+// Terrain vertices only carry a 16-bit height and an octahedral normal.
+// The grid position is rebuilt from gl_VertexID, which equals the index
+// value when drawing with the shared chunk index buffer.
+static const char *terrainVertexShader =
+    "#version 330\n"
+    "in float vertexHeight;\n"
+    "in vec2 vertexNormal;\n"
+    "uniform mat4 mvp;\n"
+    "uniform vec3 chunkOrigin;\n"
+    "uniform int chunkSize;\n"
+    "uniform float tileScale;\n"
+    "uniform float heightScale;\n"
+    "out vec3 fragNormal;\n"
+    "out float fragHeight;\n"
+    "void main() {\n"
+    "    float x = float(gl_VertexID % chunkSize) * tileScale;\n"
+    "    float z = float(gl_VertexID / chunkSize) * tileScale;\n"
+    "    float y = vertexHeight * heightScale;\n"
+    "    vec3 n = vec3(vertexNormal.x, 1.0 - abs(vertexNormal.x) - abs(vertexNormal.y), vertexNormal.y);\n"
+    "    if (n.y < 0.0) n.xz = (1.0 - abs(n.zx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.z >= 0.0 ? 1.0 : -1.0);\n"
+    "    fragNormal = normalize(n);\n"
+    "    fragHeight = y;\n"
+    "    gl_Position = mvp * vec4(chunkOrigin + vec3(x, y, z), 1.0);\n"
+    "}\n";
+
+// Colour comes from the height gradient LUT built at InitTerrain. Texel i
+// holds the gradient at i/(N-1), so remap h to texel centres before sampling.
+static const char *terrainFragmentShader =
+    "#version 330\n"
+    "in vec3 fragNormal;\n"
+    "in float fragHeight;\n"
+    "uniform float colorHeight;\n"
+    "uniform sampler2D colorLut;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float h = clamp((fragHeight + colorHeight) / (2.0 * colorHeight), 0.0, 1.0);\n"
+    "    float lutSize = float(textureSize(colorLut, 0).x);\n"
+    "    vec3 color = texture(colorLut, vec2((h * (lutSize - 1.0) + 0.5) / lutSize, 0.5)).rgb;\n"
+    "    float light = 0.4 + 0.6 * max(dot(normalize(fragNormal), normalize(vec3(0.3, 1.0, 0.2))), 0.0);\n"
+    "    finalColor = vec4(color * light, 1.0);\n"
+    "}\n";
+
+// Scattered props are drawn with DrawMeshInstanced, which feeds one model
+// matrix per instance through the instanceTransform attribute.
+static const char *propVertexShader =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec3 vertexNormal;\n"
+    "in mat4 instanceTransform;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec3 fragNormal;\n"
+    "void main() {\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragNormal = mat3(instanceTransform) * vertexNormal;\n"
+    "    gl_Position = mvp * instanceTransform * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+// Same light as the terrain so props sit in the landscape
+static const char *propFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec3 fragNormal;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec4 color = texture(texture0, fragTexCoord) * colDiffuse;\n"
+    "    float light = 0.4 + 0.6 * max(dot(normalize(fragNormal), normalize(vec3(0.3, 1.0, 0.2))), 0.0);\n"
+    "    finalColor = vec4(color.rgb * light, color.a);\n"
+    "}\n";
+
+// Impostor quads go through raylib's batch with its default vertex shader.
+// Alpha is tested rather than blended so quads need no sorting.
+static const char *impostorFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec4 color = texture(texture0, fragTexCoord) * colDiffuse * fragColor;\n"
+    "    if (color.a < 0.5) discard;\n"
+    "    finalColor = vec4(color.rgb, 1.0);\n"
+    "}\n";
+
+#endif // TERRAINSHADER_H
@@ -0,0 +1,113 @@
+// WorldDescriptor.c
+#include "WorldDescriptor.h"
+#include "Terrain.h"
+#include <string.h>
+
+static unsigned char *PutWorldField(unsigned char *bytes, unsigned int value);
+static const unsigned char *GetWorldField(const unsigned char *bytes, unsigned int *value);
+static unsigned int FloatBits(float value);
+static float BitsFloat(unsigned int bits);
+
+WorldDescriptor MakeWorldDescriptor(HeightPipelineDesc height, int chunkSize, float tileScale) {
+    WorldDescriptor world = { 0 };
+
+    world.version = WORLD_DESCRIPTOR_VERSION;
+    world.chunkSize = chunkSize;
+    world.tileScale = tileScale;
+    world.height = height;
+    world.checksum = GetWorldChecksum(&world);
+
+    return world;
+}
+
+unsigned int GetWorldChecksum(const WorldDescriptor *world) {
+    HeightPipeline pipeline = CompileHeightPipeline(world->height);
+
+    // Negative chunks too, they take the other rounding paths of the noise
+    unsigned int checksum = 2166136261u;
+    for (int z = -WORLD_PROBE_RADIUS; z <= WORLD_PROBE_RADIUS; z++) {
+        for (int x = -WORLD_PROBE_RADIUS; x <= WORLD_PROBE_RADIUS; x++) {
+            checksum = (checksum ^ GetChunkHeightChecksum(&pipeline, world->chunkSize, world->tileScale, x, z)) * 16777619u;
+        }
+    }
+
+    return checksum;
+}
+
+bool VerifyWorldDescriptor(const WorldDescriptor *world) {
+    return world->version == WORLD_DESCRIPTOR_VERSION && GetWorldChecksum(world) == world->checksum;
+}
+
+int WriteWorldDescriptor(const WorldDescriptor *world, unsigned char *bytes) {
+    const HeightPipelineDesc *height = &world->height;
+    unsigned char *out = bytes;
+
+    out = PutWorldField(out, (unsigned int)world->version);
+    out = PutWorldField(out, (unsigned int)world->chunkSize);
+    out = PutWorldField(out, FloatBits(world->tileScale));
+    out = PutWorldField(out, (unsigned int)height->seed);
+    out = PutWorldField(out, (unsigned int)height->noiseType);
+    out = PutWorldField(out, FloatBits(height->frequency));
+    out = PutWorldField(out, (unsigned int)height->octaves);
+    out = PutWorldField(out, FloatBits(height->lacunarity));
+    out = PutWorldField(out, FloatBits(height->gain));
+    out = PutWorldField(out, FloatBits(height->warpAmplitude));
+    out = PutWorldField(out, FloatBits(height->warpFrequency));
+    out = PutWorldField(out, (unsigned int)height->remap);
+    out = PutWorldField(out, FloatBits(height->remapParam));
+    out = PutWorldField(out, FloatBits(height->amplitude));
+    out = PutWorldField(out, world->checksum);
+
+    return (int)(out - bytes);
+}
+
+bool ReadWorldDescriptor(WorldDescriptor *world, const unsigned char *bytes, int size) {
+    if (size < WORLD_DESCRIPTOR_BYTES) return false;
+
+    unsigned int fields[WORLD_DESCRIPTOR_BYTES / 4];
+    for (int i = 0; i < WORLD_DESCRIPTOR_BYTES / 4; i++) bytes = GetWorldField(bytes, &fields[i]);
+    if (fields[0] != WORLD_DESCRIPTOR_VERSION) return false;
+
+    memset(world, 0, sizeof(WorldDescriptor));
+    world->version = (int)fields[0];
+    world->chunkSize = (int)fields[1];
+    world->tileScale = BitsFloat(fields[2]);
+    world->height.seed = (int)fields[3];
+    world->height.noiseType = (fnl_noise_type)fields[4];
+    world->height.frequency = BitsFloat(fields[5]);
+    world->height.octaves = (int)fields[6];
+    world->height.lacunarity = BitsFloat(fields[7]);
+    world->height.gain = BitsFloat(fields[8]);
+    world->height.warpAmplitude = BitsFloat(fields[9]);
+    world->height.warpFrequency = BitsFloat(fields[10]);
+    world->height.remap = (HeightRemapType)fields[11];
+    world->height.remapParam = BitsFloat(fields[12]);
+    world->height.amplitude = BitsFloat(fields[13]);
+    world->checksum = fields[14];
+
+    // Only sizes the terrain accepts, anything else cannot describe the sender's world
+    return world->chunkSize >= TERRAIN_MIN_CHUNK_SIZE && world->chunkSize <= TERRAIN_MAX_CHUNK_SIZE && world->tileScale > 0.0f;
+}
+
+static unsigned char *PutWorldField(unsigned char *bytes, unsigned int value) {
+    for (int i = 0; i < 4; i++) bytes[i] = (unsigned char)(value >> (8 * i));
+    return bytes + 4;
+}
+
+static const unsigned char *GetWorldField(const unsigned char *bytes, unsigned int *value) {
+    *value = 0;
+    for (int i = 0; i < 4; i++) *value |= (unsigned int)bytes[i] << (8 * i);
+    return bytes + 4;
+}
+
+static unsigned int FloatBits(float value) {
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float BitsFloat(unsigned int bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
@@ -0,0 +1,27 @@
+#ifndef WORLDDESCRIPTOR_H
+#define WORLDDESCRIPTOR_H
+
+#include <stdbool.h>
+#include "HeightPipeline.h"
+
+#define WORLD_DESCRIPTOR_VERSION 1    // Bump on any change to the fields or the height function
+#define WORLD_DESCRIPTOR_BYTES 60     // Serialized size, fifteen little-endian 32-bit fields
+#define WORLD_PROBE_RADIUS 1          // Chunks around chunk (0, 0) hashed into the checksum
+
+// Everything a client needs to generate the server's terrain itself, sent at connect time
+typedef struct WorldDescriptor {
+    int version;                // WORLD_DESCRIPTOR_VERSION of the sender
+    int chunkSize;              // Vertices per chunk side
+    float tileScale;            // World units between vertices
+    HeightPipelineDesc height;  // Height function
+    unsigned int checksum;      // Probe chunks as the sender generated them
+} WorldDescriptor;
+
+// Function declarations
+WorldDescriptor MakeWorldDescriptor(HeightPipelineDesc height, int chunkSize, float tileScale);  // Describe a world, generating its probe chunks
+unsigned int GetWorldChecksum(const WorldDescriptor *world);                    // Combined checksum of the probe chunks generated here
+bool VerifyWorldDescriptor(const WorldDescriptor *world);                       // False when this build generates different terrain than the sender
+int WriteWorldDescriptor(const WorldDescriptor *world, unsigned char *bytes);   // Serialize into WORLD_DESCRIPTOR_BYTES, returns the size
+bool ReadWorldDescriptor(WorldDescriptor *world, const unsigned char *bytes, int size);  // False when short or of another version
+
+#endif // WORLDDESCRIPTOR_H
@@ -4,9 +4,34 @@
 #include "rlgl.h"
 #include "Terrain.h"
 #include "Bullet.h"
+#include "BakedModel.h"
+#include "BakedTexture.h"
+#include "Arena.h"
+#include "JobSystem.h"
+#include "AIFleet.h"
+#include "NetClient.h"
+#include "WorldDescriptor.h"
 #include <stdio.h>
 #include <terraingeneration.h>
 
+// Fleet sizes selected with keys 1, 2 and 3 for load testing
+static const int ai_fleet_sizes[3] = { 1000, 5000, 10000 };
+
+// AI terrain avoidance reads the same heightfield the plane flies over
+static float TerrainGroundHeight(const void *ground, float x, float z) {
+    return GetTerrainHeight((const TerrainManager *)ground, x, z);
+}
+
+// Terrain is regenerated only when a server's world differs from the one being flown over
+static bool IsSameWorld(const TerrainConfig *config, const WorldDescriptor *world) {
+    const HeightPipelineDesc *a = &config->height;
+    const HeightPipelineDesc *b = &world->height;
+    return config->chunkSize == world->chunkSize && config->tileScale == world->tileScale &&
+           a->seed == b->seed && a->noiseType == b->noiseType && a->frequency == b->frequency && a->octaves == b->octaves &&
+           a->lacunarity == b->lacunarity && a->gain == b->gain && a->warpAmplitude == b->warpAmplitude &&
+           a->warpFrequency == b->warpFrequency && a->remap == b->remap && a->remapParam == b->remapParam && a->amplitude == b->amplitude;
+}
+
 
 //------------------------------------------------------------------------------------
 // Program main entry point
@@ -36,23 +61,22 @@ int terraingeneration(void)
     ModelArray *models = CreateModelArray(0);
 
     // Load models and textures
-    Model plane_model = LoadModel("resources/models/obj/plane.obj");
-    Texture2D plane_texture = LoadTexture("resources/models/obj/plane_diffuse.png");
+    Model plane_model = LoadBakedModel("resources/models/bin/plane.fmesh");
+    if (plane_model.meshCount == 0) plane_model = LoadModel("resources/models/obj/plane.obj");
+    Texture2D plane_texture = LoadBakedTexture("resources/models/bin/plane_diffuse.ftex").texture;
+    if (plane_texture.id == 0) plane_texture = LoadTexture("resources/models/obj/plane_diffuse.png");
 
-    // Model house_model = LoadModel("resources/models/obj/house.obj");
-    // Texture2D house_texture = LoadTexture("resources/models/obj/house_diffuse.png");
+    // Far AI and network planes are drawn from baked views of the same model, in one batch
+    ImpostorAtlas aircraft_impostors;
+    InitImpostorAtlas(&aircraft_impostors);
+    int plane_impostor = BakeImpostor(&aircraft_impostors, plane_model);
 
-    // Model cottage_model = LoadModel("resources/models/obj/cottage_obj.obj");
-    // Texture2D cottage_texture = LoadTexture("resources/models/obj/cottage_diffuse.png");
+    // Houses and cottages are scattered over the terrain, see Scatter.c
 
     // Create model instances
-    ModelInstance plane_instance = { plane_model, plane_texture, plane_position, 1.0f, WHITE };
-    //ModelInstance house_instance = { house_model, house_texture, (Vector3){ 0.0f, 40.0f, 0.0f }, 1.0f, WHITE };
-    //ModelInstance cottage_instance = { cottage_model, cottage_texture, (Vector3){ 0.0f, 0.0f, 0.0f }, 1.0f, WHITE };
+    ModelInstance plane_instance = { plane_model, plane_texture, plane_position, 1.0f, WHITE, 0, 0, { 0.0f, 0.0f, 0.0f, 1.0f }, false };
 
     AppendModel(models, plane_instance);
-    // AppendModel(models, house_instance);
-    // AppendModel(models, cottage_instance);
 
 
     float pitch = 0.0f;
@@ -75,9 +99,32 @@ int terraingeneration(void)
 
     //--------------------------------------------------------------------------------------
 
-    // Terrain initialization
+    // Terrain initialization, large chunks and culling are split across the job system.
+    // Static: the worker deques make it about 2 MB, more than a thread's stack on Windows.
+    static JobSystem jobs;
+    InitJobSystem(&jobs, 4);
+
+    // HUD text and other main-thread scratch, handed back at the end of every frame
+    Arena frame_arena;
+    InitArena(&frame_arena, 16 * 1024);
+
+    TerrainConfig config = GetDefaultTerrainConfig();
+    config.jobs = &jobs;
     TerrainManager terrain;
-    InitTerrain(&terrain);
+    InitTerrainEx(&terrain, config);
+
+    // AI aircraft share the job system with the terrain, batches run between terrain updates
+    AIFleet fleet;
+    InitAIFleet(&fleet, &jobs, TerrainGroundHeight, &terrain);
+    SetAIFleetCount(&fleet, ai_fleet_sizes[0], plane_instance.position);
+    double ai_time_total = 0.0;     // Update time since the fleet size last changed
+    int ai_ticks = 0;
+    int ai_kills = 0;
+
+    // C joins a tools/server on this machine, its fleet then replaces the local one
+    NetClient net;
+    InitNetClient(&net);
+    bool net_world_checked = false;     // The server's world descriptor was applied this connection
 
     //--------------------------------------------------------------------------------------
 
@@ -135,6 +182,12 @@ int terraingeneration(void)
         plane_instance->position.x += turning_value;//(models->models[0].position, Vector3Scale((Vector3){1.0f,0.0f,0.0f}, turning_value ));
         plane_instance->position.y = altitude;
 
+        // Shift everything back towards the origin on long flights, chunks keep their GPU data
+        Vector3 originShift = RebaseTerrainOrigin(&terrain, plane_instance->position);
+        plane_instance->position = Vector3Subtract(plane_instance->position, originShift);
+        bullet.position = Vector3Subtract(bullet.position, originShift);
+        ShiftAIFleet(&fleet, originShift);
+
 
         // Transformation matrix for rotations
         plane_instance->model.transform = MatrixRotateXYZ((Vector3){ DEG2RAD * pitch, DEG2RAD * yaw, DEG2RAD * roll });
@@ -156,6 +209,53 @@ int terraingeneration(void)
         // Update terrain based on plane position
         UpdateTerrain(&terrain, plane_instance->position, forward, camera);
 
+        // AI aircraft patrol around the plane and attack it, timed per tick for load testing
+        for (int i = 0; i < 3; i++) {
+            if (IsKeyPressed(KEY_ONE + i) && fleet.count != ai_fleet_sizes[i]) {
+                SetAIFleetCount(&fleet, ai_fleet_sizes[i], plane_instance->position);
+                ai_time_total = 0.0;
+                ai_ticks = 0;
+            }
+        }
+        if (net.state == NET_CLIENT_DISCONNECTED) {
+            UpdateAIFleet(&fleet, plane_instance->position, plane_instance->position, GetFrameTime());
+            ai_time_total += fleet.updateTime;
+            ai_ticks++;
+        }
+
+        // The server works in world space, render space is offset by the terrain's floating origin
+        float chunk_world_size = (terrain.chunkSize - 1) * terrain.tileScale;
+        Vector3 world_origin = { terrain.originChunkX * chunk_world_size, 0.0f, terrain.originChunkZ * chunk_world_size };
+        if (IsKeyPressed(KEY_C)) {
+            if (net.state == NET_CLIENT_DISCONNECTED) ConnectNetClient(&net, NET_DEFAULT_PORT, GetTime());
+            else DisconnectNetClient(&net);
+        }
+        PollNetClient(&net, Vector3Add(plane_instance->position, world_origin), GetTime());
+
+        // Terrain never crosses the network, the server's descriptor is generated here and checked first
+        if (net.state == NET_CLIENT_DISCONNECTED) net_world_checked = false;
+        if (net.state == NET_CLIENT_CONNECTED && !net_world_checked) {
+            net_world_checked = true;
+            WorldDescriptor server_world;
+            if (!ReadWorldDescriptor(&server_world, net.world, net.worldSize) || !VerifyWorldDescriptor(&server_world)) {
+                TraceLog(LOG_WARNING, "NET: This build generates different terrain than the server, disconnecting");
+                DisconnectNetClient(&net);
+            } else if (!IsSameWorld(&config, &server_world)) {
+                // Restart streaming in the server's world, keeping everything at its world position
+                Vector3 shift = Vector3Negate(world_origin);
+                plane_instance->position = Vector3Subtract(plane_instance->position, shift);
+                bullet.position = Vector3Subtract(bullet.position, shift);
+                ShiftAIFleet(&fleet, shift);
+
+                config.chunkSize = server_world.chunkSize;
+                config.tileScale = server_world.tileScale;
+                config.height = server_world.height;
+                UnloadTerrain(&terrain);
+                InitTerrainEx(&terrain, config);
+                world_origin = (Vector3){ 0.0f, 0.0f, 0.0f };
+            }
+        }
+
         // Update the bullet if it's active
         if (bullet.active) {
             // Move the bullet forward in its direction
@@ -165,6 +265,18 @@ int terraingeneration(void)
             if (Vector3Length(bullet.position) > (plane_instance->position.z + BULLET_RANGE)) {
                 bullet.active = false;
             }
+
+            // Shoot down AI aircraft
+            if (bullet.active && HitAIFleet(&fleet, bullet.position, AI_HIT_RADIUS * 2.0f) >= 0) {
+                bullet.active = false;
+                ai_kills++;
+            }
+
+            // Leave a crater where the bullet hits the ground
+            if (bullet.active && bullet.position.y < GetTerrainHeight(&terrain, bullet.position.x, bullet.position.z)) {
+                DeformTerrain(&terrain, bullet.position, 15.0f, 4.0f);
+                bullet.active = false;
+            }
         }
 
         // Draw
@@ -191,33 +303,55 @@ int terraingeneration(void)
                     DrawModel(models->models[i].model, models->models[i].position, models->models[i].scale, models->models[i].color);
                 }
 
+                if (net.state == NET_CLIENT_DISCONNECTED) DrawAIFleet(&fleet, plane_model, &aircraft_impostors, plane_impostor, camera);
+                else if (GetNetClientSnapshot(&net)) DrawNetSnapshot(GetNetClientSnapshot(&net), plane_model, &aircraft_impostors, plane_impostor, camera, world_origin);
+
                 if(bullet.active)
                     DrawCube(bullet.position, 7.5f, 7.5f, 15.0f, RED);  // Draw the bullet as a rectangle
                 
             EndMode3D();
 
-            DrawRectangle(5, 45, 250, 90, Fade(GREEN, 0.5f));
-            DrawRectangleLines(5, 45, 250, 90, Fade(DARKGREEN, 0.5f));
-            char info[128];
-            sprintf(info, "Speed: %.2f units/s", speed);
-            DrawText(info, 10, 50, 15, WHITE);
-            sprintf(info, "Altitude: %.2f units", models->models[0].position.y);
-            DrawText(info, 10, 70, 15, WHITE);
-            sprintf(info, "Bullet Position: %f ", bullet.position.z);
-            DrawText(info, 10, 90, 15, WHITE);
-            sprintf(info, "Bullet Active: %d ", bullet.active);
-            DrawText(info, 10, 110, 15, WHITE);
+            DrawRectangle(5, 45, 250, 270, Fade(GREEN, 0.5f));
+            DrawRectangleLines(5, 45, 250, 270, Fade(DARKGREEN, 0.5f));
+            DrawText(FormatArenaText(&frame_arena, "Speed: %.2f units/s", speed), 10, 50, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Altitude: %.2f units", models->models[0].position.y), 10, 70, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Bullet Position: %f ", bullet.position.z), 10, 90, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Bullet Active: %d ", bullet.active), 10, 110, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Chunk Cache: %.0f%% hits, %.1f KB", GetChunkCacheHitRatio(&terrain.cache) * 100.0f, terrain.cache.bytesUsed / 1024.0f), 10, 130, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Chunk VRAM: %.1f KB, saved %.1f KB/s", terrain.chunkSize * terrain.chunkSize * sizeof(TerrainVertex) / 1024.0f,
+                    (terrain.bytesUploadedLegacy - terrain.bytesUploaded) / 1024.0f / GetTime()), 10, 150, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Chunks: %d loaded, %d visible, %.1f generated/s", terrain.chunkCount, terrain.visibleChunks, terrain.chunksGenerated / GetTime()), 10, 170, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Props: %d meshes, %d impostors", terrain.propMeshInstances, terrain.propImpostors), 10, 190, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "AI: %d planes, %.2f ms/tick (1/2/3)", fleet.count, ai_ticks > 0 ? ai_time_total / ai_ticks * 1000.0 : 0.0), 10, 210, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "AI shots %d, hits %d, kills %d", fleet.shotsFired, fleet.hits, ai_kills), 10, 230, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "AI matrices: %d rebuilt, %.3f ms", fleet.matricesRebuilt, fleet.matrixTime * 1000.0), 10, 250, 15, WHITE);
+            if (net.state == NET_CLIENT_CONNECTED && GetNetClientSnapshot(&net)) {
+                DrawText(FormatArenaText(&frame_arena, "Net: %d entities, %.1f KB/s", GetNetClientSnapshot(&net)->count, net.bytesReceived / 1024.0 / (GetTime() - net.startTime)), 10, 270, 15, WHITE);
+            } else {
+                DrawText(FormatArenaText(&frame_arena, "Net: %s (C)", net.state == NET_CLIENT_CONNECTING ? "connecting" : "offline"), 10, 270, 15, WHITE);
+            }
+            DrawText(FormatArenaText(&frame_arena, "Frame arenas: HUD %.1f KB, workers %.1f KB peak", frame_arena.lastUsed / 1024.0,
+                    GetJobArenaHighWater(&jobs) / 1024.0), 10, 290, 15, WHITE);
 
             DrawText("(c) HKN SoftCrafting", screenWidth - 200, screenHeight - 20, 10, DARKGRAY);
 
         EndDrawing();
         //----------------------------------------------------------------------------------
+
+        // The culling jobs finished inside DrawAIFleet, terrain jobs never touch the arenas
+        ResetArena(&frame_arena);
+        ResetJobArenas(&jobs);
     }
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
     // Unload terrain
+    DisconnectNetClient(&net);
+    UnloadAIFleet(&fleet);
+    UnloadImpostorAtlas(&aircraft_impostors);
     UnloadTerrain(&terrain);
+    UnloadArena(&frame_arena);
+    UnloadJobSystem(&jobs);
     
     // Unload all models and textures
     UnloadModelArray(models);
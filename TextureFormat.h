@@ -0,0 +1,52 @@
+// TextureFormat.h
+#ifndef TEXTUREFORMAT_H
+#define TEXTUREFORMAT_H
+
+#include <stdint.h>
+
+// Baked texture file (.ftex), written by tools/texbaker and mapped by LoadBakedTexture.
+// Layout: TextureFileHeader, regionCount TextureFileRegion, then the pixel data at
+// dataOffset: every mip level from the largest down, back to back, as raylib expects
+// for a mipmapped Image. All values are little-endian.
+
+#define TEXTURE_FILE_MAGIC 0x58455446u   // "FTEX"
+#define TEXTURE_FILE_VERSION 1           // Bump on any layout change
+#define TEXTURE_FILE_NAME_SIZE 48        // Region name length including the terminator
+
+// Stored pixel layout, mapped to raylib's PixelFormat at load time
+typedef enum TextureFileFormat {
+    TEXTURE_FILE_RGBA8 = 0,     // 32-bit RGBA
+    TEXTURE_FILE_BC1,           // DXT1, 4 bpp, opaque
+    TEXTURE_FILE_BC3            // DXT5, 8 bpp, with alpha
+} TextureFileFormat;
+
+typedef struct TextureFileHeader {
+    uint32_t magic;             // TEXTURE_FILE_MAGIC
+    uint32_t version;           // TEXTURE_FILE_VERSION
+    uint32_t width;             // Size of mip level 0
+    uint32_t height;
+    uint32_t mipmaps;           // Levels stored, including level 0
+    uint32_t format;            // TextureFileFormat
+    uint32_t regionCount;       // Atlas regions, 0 for a plain texture
+    uint32_t dataOffset;        // Start of level 0 from the start of the file
+    uint32_t dataSize;          // Bytes of all levels
+} TextureFileHeader;
+
+// Named rectangle of an atlas, in level 0 pixels
+typedef struct TextureFileRegion {
+    char name[TEXTURE_FILE_NAME_SIZE];
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+} TextureFileRegion;
+
+// Bytes of one mip level, block formats store 4x4 pixel blocks
+static inline uint32_t GetTextureFileLevelSize(uint32_t width, uint32_t height, uint32_t format) {
+    uint32_t blocks = ((width + 3) / 4) * ((height + 3) / 4);
+    if (format == TEXTURE_FILE_BC1) return blocks * 8;
+    if (format == TEXTURE_FILE_BC3) return blocks * 16;
+    return width * height * 4;
+}
+
+#endif // TEXTUREFORMAT_H
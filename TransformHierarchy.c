@@ -0,0 +1,126 @@
+// TransformHierarchy.c
+#include "TransformHierarchy.h"
+#include "raymath.h"
+#include <stdlib.h>
+#include <string.h>
+
+static bool GrowTransformHierarchy(TransformHierarchy *hierarchy);
+
+void InitTransformHierarchy(TransformHierarchy *hierarchy) {
+    memset(hierarchy, 0, sizeof(TransformHierarchy));
+}
+
+int AddTransform(TransformHierarchy *hierarchy, int parent, Vector3 position, Quaternion rotation, float scale) {
+    // Appending keeps the order topological, a parent always exists before its child
+    if (parent < TRANSFORM_NO_PARENT || parent >= hierarchy->count) {
+        TraceLog(LOG_WARNING, "TRANSFORM: Parent %d does not exist", parent);
+        return TRANSFORM_NO_PARENT;
+    }
+    if (hierarchy->count == hierarchy->capacity && !GrowTransformHierarchy(hierarchy)) return TRANSFORM_NO_PARENT;
+
+    int node = hierarchy->count++;
+    hierarchy->parent[node] = parent;
+    hierarchy->localPosition[node] = position;
+    hierarchy->localRotation[node] = rotation;
+    hierarchy->localScale[node] = scale;
+    hierarchy->world[node] = MatrixIdentity();
+    hierarchy->dirty[node] = true;
+    hierarchy->changed[node] = false;
+
+    return node;
+}
+
+void SetTransformLocal(TransformHierarchy *hierarchy, int node, Vector3 position, Quaternion rotation) {
+    Vector3 oldPosition = hierarchy->localPosition[node];
+    Quaternion oldRotation = hierarchy->localRotation[node];
+    if (oldPosition.x == position.x && oldPosition.y == position.y && oldPosition.z == position.z &&
+        oldRotation.x == rotation.x && oldRotation.y == rotation.y && oldRotation.z == rotation.z && oldRotation.w == rotation.w) return;
+
+    hierarchy->localPosition[node] = position;
+    hierarchy->localRotation[node] = rotation;
+    hierarchy->dirty[node] = true;
+}
+
+void SetTransformScale(TransformHierarchy *hierarchy, int node, float scale) {
+    if (hierarchy->localScale[node] == scale) return;
+
+    hierarchy->localScale[node] = scale;
+    hierarchy->dirty[node] = true;
+}
+
+int UpdateTransforms(TransformHierarchy *hierarchy) {
+    int rebuilt = 0;
+
+    // Parents come first, so changed[parent] is already final when a child is reached
+    for (int node = 0; node < hierarchy->count; node++) {
+        int parent = hierarchy->parent[node];
+        bool parentChanged = parent != TRANSFORM_NO_PARENT && hierarchy->changed[parent];
+
+        hierarchy->changed[node] = hierarchy->dirty[node] || parentChanged;
+        if (!hierarchy->changed[node]) continue;
+
+        // Scale, then rotate, then translate, then the parent's world
+        float scale = hierarchy->localScale[node];
+        Vector3 position = hierarchy->localPosition[node];
+        Matrix local = QuaternionToMatrix(hierarchy->localRotation[node]);
+        local.m0 *= scale; local.m1 *= scale; local.m2 *= scale;
+        local.m4 *= scale; local.m5 *= scale; local.m6 *= scale;
+        local.m8 *= scale; local.m9 *= scale; local.m10 *= scale;
+        local.m12 = position.x;
+        local.m13 = position.y;
+        local.m14 = position.z;
+
+        hierarchy->world[node] = parent == TRANSFORM_NO_PARENT ? local : MatrixMultiply(local, hierarchy->world[parent]);
+        hierarchy->dirty[node] = false;
+        rebuilt++;
+    }
+
+    hierarchy->rebuilt = rebuilt;
+    return rebuilt;
+}
+
+Matrix GetTransformWorld(const TransformHierarchy *hierarchy, int node) {
+    return hierarchy->world[node];
+}
+
+Vector3 GetTransformPosition(const TransformHierarchy *hierarchy, int node) {
+    const Matrix *world = &hierarchy->world[node];
+    return (Vector3){ world->m12, world->m13, world->m14 };
+}
+
+void UnloadTransformHierarchy(TransformHierarchy *hierarchy) {
+    free(hierarchy->parent);
+    free(hierarchy->localPosition);
+    free(hierarchy->localRotation);
+    free(hierarchy->localScale);
+    free(hierarchy->world);
+    free(hierarchy->dirty);
+    free(hierarchy->changed);
+
+    memset(hierarchy, 0, sizeof(TransformHierarchy));
+}
+
+static bool GrowTransformHierarchy(TransformHierarchy *hierarchy) {
+    int capacity = hierarchy->capacity > 0 ? hierarchy->capacity * 2 : TRANSFORM_INITIAL_CAPACITY;
+
+    int *parent = (int *)realloc(hierarchy->parent, capacity * sizeof(int));
+    if (parent) hierarchy->parent = parent;
+    Vector3 *localPosition = (Vector3 *)realloc(hierarchy->localPosition, capacity * sizeof(Vector3));
+    if (localPosition) hierarchy->localPosition = localPosition;
+    Quaternion *localRotation = (Quaternion *)realloc(hierarchy->localRotation, capacity * sizeof(Quaternion));
+    if (localRotation) hierarchy->localRotation = localRotation;
+    float *localScale = (float *)realloc(hierarchy->localScale, capacity * sizeof(float));
+    if (localScale) hierarchy->localScale = localScale;
+    Matrix *world = (Matrix *)realloc(hierarchy->world, capacity * sizeof(Matrix));
+    if (world) hierarchy->world = world;
+    bool *dirty = (bool *)realloc(hierarchy->dirty, capacity * sizeof(bool));
+    if (dirty) hierarchy->dirty = dirty;
+    bool *changed = (bool *)realloc(hierarchy->changed, capacity * sizeof(bool));
+    if (changed) hierarchy->changed = changed;
+
+    // A failed realloc leaves its old block in place, so the old capacity stays valid
+    if (!parent || !localPosition || !localRotation || !localScale || !world || !dirty || !changed) return false;
+
+    hierarchy->capacity = capacity;
+    return true;
+}
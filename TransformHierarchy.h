@@ -0,0 +1,36 @@
+// TransformHierarchy.h
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define TRANSFORM_NO_PARENT         -1
+#define TRANSFORM_INITIAL_CAPACITY  16
+
+// Nodes in flat arrays, every parent stored before its children. One forward pass
+// therefore sees a parent's new world matrix before any child needs it.
+typedef struct TransformHierarchy {
+    int count;                  // Nodes in use
+    int capacity;               // Nodes allocated
+    int *parent;                // Lower index of the parent, or TRANSFORM_NO_PARENT
+    Vector3 *localPosition;     // Relative to the parent
+    Quaternion *localRotation;
+    float *localScale;          // Uniform
+    Matrix *world;              // Valid after UpdateTransforms
+    bool *dirty;                // Local changed since world was built
+    bool *changed;              // World rebuilt by the current pass, tells the children
+    int rebuilt;                // World matrices rebuilt by the last UpdateTransforms
+} TransformHierarchy;
+
+// Function declarations
+void InitTransformHierarchy(TransformHierarchy *hierarchy);                             // Empty hierarchy
+int AddTransform(TransformHierarchy *hierarchy, int parent, Vector3 position, Quaternion rotation, float scale);  // Append a node under an existing parent, returns its index
+void SetTransformLocal(TransformHierarchy *hierarchy, int node, Vector3 position, Quaternion rotation);  // Move a node, dirty only if something changed
+void SetTransformScale(TransformHierarchy *hierarchy, int node, float scale);           // Rescale a node, dirty only if it changed
+int UpdateTransforms(TransformHierarchy *hierarchy);                                    // Rebuild dirty nodes and everything under them, returns how many
+Matrix GetTransformWorld(const TransformHierarchy *hierarchy, int node);                // World matrix from the last update
+Vector3 GetTransformPosition(const TransformHierarchy *hierarchy, int node);             // World position from the last update
+void UnloadTransformHierarchy(TransformHierarchy *hierarchy);                           // Free the arrays
+
+#endif // TRANSFORMHIERARCHY_H
@@ -4,29 +4,55 @@
 #include "Bullet.h"
 #include <stdio.h>
 #include "game.h"
-
+#include "AssetLoader.h"
+#include "Arena.h"
+#include "AssetPack.h"
+#include "JobSystem.h"
+#include "RenderPacket.h"
+#include "FlightModel.h"
+#include "TransformHierarchy.h"
+#include <math.h>
+#include <stdlib.h>
 
 ModelArray *models;
+JobSystem jobs;
+AssetLoader loader;
+RenderPacket packets[2];     // Drawn and simulated frames, swapped every frame
+Arena frame_arena;           // Main-thread memory that lives until the end of the frame
+InputState input;            // Input for the frame being simulated
+bool pipelined = true;       // Simulate the next frame while drawing this one
+double draw_time = 0.0;      // Seconds spent submitting the last frame
+FlightBodies flight;         // Body i flies model instance i, the plane is body 0
+Quaternion aim_orientation;  // Gun aim, turned towards the mouse a little every tick
+TransformHierarchy attachments;  // Parts that follow the plane
+int plane_node;              // The airframe, parent of the gun
+int gun_node;                // Muzzle the bullet leaves from
+int camera_rig_node;         // At the plane, turned to its ground track
+int camera_node;             // Behind and above the rig
 Vector3 plane_position = { PLANE_INITIAL_POSITION_X, PLANE_INITIAL_POSITION_Y, PLANE_INITIAL_POSITION_Z };
 Camera camera = { 0 };
 Bullet bullet = { 0 };
 
-float pitch = 0.0f;
-float roll = 0.0f;
-float yaw = 0.0f;
-float turning_value = 0.0f;
 float altitude = 0.0f;
 float speed = PLANE_INITIAL_SPEED; // Units per second
 
+static int CompareFrameTimes(const void *a, const void *b);
+static void PrintFrameTimes(const char *name, double *samples);
+
 
 void LoadModels() {
 
     models = CreateModelArray(0);
     
-    Model plane_model = LoadModel(PLANE_MODEL);
-    Texture2D plane_texture = LoadTexture(PLANE_TEXTURE);
+    // One mapping serves every packed path, anything missing from it is read loose
+    MountAssetPack(ASSET_PACK);
+
+    // Files load in the background, the plane is drawn with placeholders until they arrive
+    InitAssetLoader(&loader, &jobs);
+    int plane_model = RequestModel(&loader, PLANE_MODEL_BAKED, PLANE_MODEL);
+    int plane_texture = RequestTexture(&loader, PLANE_TEXTURE_BAKED, PLANE_TEXTURE);
 
-    ModelInstance tmp_plane_instance = { plane_model, plane_texture, plane_position, PLANE_INITIAL_SCALE, WHITE };
+    ModelInstance tmp_plane_instance = { loader.placeholderModel, loader.placeholderTexture, plane_position, PLANE_INITIAL_SCALE, WHITE, plane_model, plane_texture, { 0.0f, 0.0f, 0.0f, 1.0f }, true };
 
     AppendModel(models, tmp_plane_instance);
 }
@@ -43,10 +69,26 @@ void LoadGame() {
 
     SetTargetFPS(TARGET_FPS); // Set our game to run at 60 frames-per-second
 
+    // One pool of threads for every subsystem, this thread stays worker 0 and owns GL
+    InitJobSystem(&jobs, JOB_THREADS);
+
     LoadModels();
 
     ModelInstance *plane_instance = &(models->models[0]);
 
+    // Every aircraft shares one airframe, the plane starts level and heading +Z
+    InitFlightBodies(&flight, GetDefaultFlightParams(), &jobs);
+    AddFlightBody(&flight, plane_instance->position, QuaternionIdentity(), PLANE_INITIAL_SPEED);
+    aim_orientation = QuaternionIdentity();
+
+    // Parents are added before their children, the hierarchy is updated in that order
+    InitTransformHierarchy(&attachments);
+    plane_node = AddTransform(&attachments, TRANSFORM_NO_PARENT, plane_instance->position, QuaternionIdentity(), 1.0f);
+    gun_node = AddTransform(&attachments, plane_node, (Vector3){ 0.0f, 0.0f, PLANE_GUN_OFFSET }, QuaternionIdentity(), 1.0f);
+    camera_rig_node = AddTransform(&attachments, TRANSFORM_NO_PARENT, plane_instance->position, QuaternionIdentity(), 1.0f);
+    camera_node = AddTransform(&attachments, camera_rig_node, (Vector3){ 0.0f, CAMERA_FOLLOW_HEIGHT, -CAMERA_FOLLOW_DISTANCE }, QuaternionIdentity(), 1.0f);
+    UpdateTransforms(&attachments);
+
     bullet.active = false;
 
     camera.position = (Vector3){ CAMERA_INITIAL_POSITION_X, CAMERA_INITIAL_POSITION_Y, CAMERA_INITIAL_POSITION_Z }; // Initial camera position (will be updated)
@@ -57,42 +99,241 @@ void LoadGame() {
 }
 
 void GameLoop() {
+    int frame = 0;
+
+    BeginFrames();
+
     // Main game loop
     while (!WindowShouldClose()) // Detect window close button or ESC key
     {
-        ModelInstance *plane_instance = &(models->models[0]);
-        altitude = plane_instance->position.y;
+        if (IsKeyPressed(KEY_E)) SpawnEscorts(ESCORT_BATCH);
+        if (IsKeyPressed(KEY_P)) pipelined = !pipelined;
+
+        RunFrame(frame++);
+    }
 
-        UserInput(plane_instance);
+    EndFrames();
+}
 
-        plane_instance->position.x += turning_value;
-        plane_instance->position.y = altitude;
+void BeginFrames() {
+    InitRenderPacket(&packets[0]);
+    InitRenderPacket(&packets[1]);
+    InitArena(&frame_arena, FRAME_ARENA_SIZE);
 
-        // Update the plane's transform to look at the mouse position
-        ObjectLookAtMouse(plane_instance->position, camera, &(plane_instance->model.transform));
-        Matrix userRotation = MatrixRotateXYZ((Vector3){ DEG2RAD * pitch, DEG2RAD * yaw, DEG2RAD * roll });
-        plane_instance->model.transform = MatrixMultiply(userRotation, plane_instance->model.transform);
+    // The first frame is simulated up front, from then on simulation runs one frame ahead of drawing
+    input = ReadInput();
+    Simulate(&packets[0]);
+}
 
-        // Update camera to follow the plane
-        Vector3 cameraOffset = { 0.0f, 100.0f, -300.0f }; // Adjusted offset values
-        camera.position = Vector3Add(plane_instance->position, cameraOffset);
-        camera.target = plane_instance->position;
-        camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+// Draws packet frame & 1 and leaves the next frame simulated in the other packet
+void RunFrame(int frame) {
+    JobCounter simulation = { 0 };
+    RenderPacket *drawn = &packets[frame & 1];
+    RenderPacket *next = &packets[(frame + 1) & 1];
+
+    // Nothing is simulating here, so Model data shared with the packets may change
+    RunMainThreadJobs(&jobs);
+    UpdateAssetLoader(&loader);
+    for (size_t i = 0; i < models->size; ++i) {
+        ResolveModelInstance(&loader, &models->models[i]);
+    }
 
-        if (bullet.active) {
-            // Move the bullet forward in its direction
-            bullet.position = Vector3Add(bullet.position, Vector3Scale(bullet.direction, BULLET_SPEED * GetFrameTime()));
-        
-            // Deactivate the bullet if it goes out of bounds
-            if (Vector3Length(bullet.position) > (plane_instance->position.z + BULLET_RANGE)) {
-                bullet.active = false;
+    // raylib polls input inside EndDrawing on this thread, the simulation works from a copy
+    input = ReadInput();
+
+    if (pipelined) {
+        // Frame N + 1 simulates on a worker while frame N is drawn from its packet
+        RunJob(&jobs, SimulateJob, next, &simulation);
+        Draw(drawn);
+        WaitForCounter(&jobs, &simulation);
+    } else {
+        Simulate(next);
+        Draw(next);
+    }
+
+    // The simulation has finished and asset jobs never touch the arenas, this frame's scratch goes back at once
+    ResetArena(&frame_arena);
+    ResetJobArenas(&jobs);
+}
+
+void EndFrames() {
+    UnloadRenderPacket(&packets[0]);
+    UnloadRenderPacket(&packets[1]);
+    UnloadArena(&frame_arena);
+}
+
+// Scripted timing run for game -framebench: every escort count, drawn serially and pipelined,
+// uncapped, once the loader has finished so real models are drawn and not placeholders
+void RunFrameBench() {
+    const int escort_counts[] = { 0, 100, 1000, 5000 };
+    double *samples = (double *)malloc(3 * FRAMEBENCH_FRAMES * sizeof(double));
+    double *frame_times = samples, *simulate_times = samples + FRAMEBENCH_FRAMES, *draw_times = samples + 2 * FRAMEBENCH_FRAMES;
+    int frame = 0;
+
+    SetTargetFPS(0);
+    BeginFrames();
+    while (!IsAssetLoaderDone(&loader) && !WindowShouldClose()) RunFrame(frame++);
+
+    printf("Frame times over %d frames after %d warm-up frames, %d threads, mean / p95 in ms:\n", FRAMEBENCH_FRAMES, FRAMEBENCH_WARMUP, JOB_THREADS);
+    for (int i = 0; i < (int)(sizeof(escort_counts) / sizeof(escort_counts[0])); ++i) {
+        SpawnEscorts(escort_counts[i] - ((int)models->size - 1));
+
+        for (int way = 0; way < 2; ++way) {
+            pipelined = way == 1;
+            for (int n = 0; n < FRAMEBENCH_WARMUP; ++n) RunFrame(frame++);
+
+            for (int n = 0; n < FRAMEBENCH_FRAMES; ++n) {
+                double start = GetTime();
+                RunFrame(frame);
+                frame_times[n] = GetTime() - start;
+                simulate_times[n] = packets[(frame + 1) & 1].simulationTime;
+                draw_times[n] = draw_time;
+                frame++;
             }
+
+            printf("  %5d escorts, %-9s", escort_counts[i], pipelined ? "pipelined" : "serial");
+            PrintFrameTimes("frame", frame_times);
+            PrintFrameTimes("simulate", simulate_times);
+            PrintFrameTimes("draw", draw_times);
+            printf("\n");
         }
+    }
+
+    EndFrames();
+    free(samples);
+}
+
+static int CompareFrameTimes(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Sorts the samples in place
+static void PrintFrameTimes(const char *name, double *samples) {
+    double sum = 0.0;
+    for (int n = 0; n < FRAMEBENCH_FRAMES; ++n) sum += samples[n];
+    qsort(samples, FRAMEBENCH_FRAMES, sizeof(double), CompareFrameTimes);
+    printf(", %s %.2f / %.2f", name, sum * 1000.0 / FRAMEBENCH_FRAMES, samples[(FRAMEBENCH_FRAMES - 1) * 95 / 100] * 1000.0);
+}
+
+InputState ReadInput() {
+    InputState state = { 0 };
+
+    state.pitchDown = IsKeyDown(KEY_DOWN);
+    state.pitchUp = IsKeyDown(KEY_UP);
+    state.yawLeft = IsKeyDown(KEY_A);
+    state.yawRight = IsKeyDown(KEY_S);
+    state.rollLeft = IsKeyDown(KEY_LEFT);
+    state.rollRight = IsKeyDown(KEY_RIGHT);
+    state.throttleUp = IsKeyDown(KEY_LEFT_SHIFT);
+    state.throttleDown = IsKeyDown(KEY_LEFT_CONTROL);
+    state.fire = IsKeyPressed(KEY_SPACE);
+    state.mouse = GetMousePosition();
+    state.frameTime = GetFrameTime();
+
+    return state;
+}
+
+void SimulateJob(void *data) {
+    Simulate((RenderPacket *)data);
+}
+
+// Owns every piece of game state while it runs, and touches no GL or raylib input
+void Simulate(RenderPacket *packet) {
+    double start = GetTime();
+
+    ModelInstance *plane_instance = &(models->models[0]);
+
+    // The gun aims at the mouse, the airframe goes where the controls take it
+    aim_orientation = ObjectLookAtMouse(plane_instance->position, input.mouse, camera, aim_orientation, AIM_TURN_RATE * input.frameTime);
+    UserInput(plane_instance);
+    UpdateEscorts(plane_instance->position);
 
-        Draw();
+    AdvanceFlightBodies(&flight, input.frameTime);
+    for (size_t i = 0; i < models->size; ++i) {
+        ModelInstance *instance = &models->models[i];
+        instance->position = GetFlightPosition(&flight, (int)i);
+        SetModelOrientation(instance, GetFlightOrientation(&flight, (int)i));
     }
+    int transforms_rebuilt = UpdateModelTransforms(models);
+
+    Vector3 velocity = GetFlightVelocity(&flight, 0);
+    altitude = plane_instance->position.y;
+    speed = Vector3Length(velocity);
+
+    // The bullet moves on another worker while the attachments update
+    Vector3 bullet_reference = plane_instance->position;
+    JobCounter frame_jobs = { 0 };
+    RunJob(&jobs, UpdateBullet, &bullet_reference, &frame_jobs);
+
+    // The camera rig keeps its last heading while the plane has no ground speed
+    Quaternion camera_heading = attachments.localRotation[camera_rig_node];
+    if (velocity.x * velocity.x + velocity.z * velocity.z > 1.0f) {
+        camera_heading = QuaternionFromAxisAngle((Vector3){ 0.0f, 1.0f, 0.0f }, atan2f(velocity.x, velocity.z));
+    }
+    SetTransformLocal(&attachments, plane_node, plane_instance->position, plane_instance->orientation);
+    SetTransformLocal(&attachments, camera_rig_node, plane_instance->position, camera_heading);
+    UpdateTransforms(&attachments);
+
+    // Update camera to follow the plane, behind it along its ground track
+    camera.position = GetTransformPosition(&attachments, camera_node);
+    camera.target = GetTransformPosition(&attachments, plane_node);
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+
+    // Snapshot what the frame needs, culled against the camera it will be drawn with
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, (double)SCREEN_WIDTH / SCREEN_HEIGHT, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+    Vector4 planes[6];
+    GetFrustumPlanes(MatrixMultiply(view, projection), planes);
+
+    ClearRenderPacket(packet);
+    packet->camera = camera;
+    packet->entityCount = (int)models->size;
+    for (size_t i = 0; i < models->size; ++i) {
+        const ModelInstance *instance = &models->models[i];
+        if (IsSphereInFrustum(planes, instance->position, ENTITY_CULL_RADIUS * instance->scale)) PushRenderItem(packet, instance);
+    }
+
+    WaitForCounter(&jobs, &frame_jobs);
+    packet->bulletActive = bullet.active;
+    packet->bulletPosition = bullet.position;
+    packet->speed = speed;
+    packet->altitude = altitude;
+    packet->flightBodies = flight.count;
+    packet->flightSteps = flight.steps;
+    packet->flightTime = flight.stepTime;
+    packet->transformsRebuilt = transforms_rebuilt;
+    packet->attachmentCount = attachments.count;
+    packet->attachmentsRebuilt = attachments.rebuilt;
+    packet->simulationTime = GetTime() - start;
+}
+
+void SpawnEscorts(int count) {
+    // Escorts share the plane's loader-owned model and texture, so they are never unloaded twice
+    ModelInstance escort = models->models[0];
+    Vector3 leader = GetFlightPosition(&flight, 0);
+    Quaternion orientation = GetFlightOrientation(&flight, 0);
+
+    for (int i = 0; i < count; ++i) {
+        int index = (int)models->size;
+        AppendModel(models, escort);
+        AddFlightBody(&flight, Vector3Add(leader, GetEscortOffset(index)), orientation, speed);
+    }
+}
+
+// Formation slot of escort index around the plane, on rings that widen with the count
+Vector3 GetEscortOffset(int index) {
+    float angle = (float)index * 2.39996f;
+    float radius = ESCORT_SPACING * (1.0f + (float)(index % 8));
+    return (Vector3){ cosf(angle) * radius, (float)(index % 5) * 15.0f, sinf(angle) * radius };
 }
 
+// Escorts are flown by the autopilot towards their slot, so they load the flight model like the plane
+void UpdateEscorts(Vector3 center) {
+    for (size_t i = 1; i < models->size; ++i) {
+        SteerFlightBody(&flight, (int)i, Vector3Add(center, GetEscortOffset((int)i)), speed);
+    }
+}
 
 // void GameLoop() {
 //     // Main game loop
@@ -132,16 +373,32 @@ void GameLoop() {
 // }
 
 
-void Draw() {
+void UpdateBullet(void *data) {
+    const Vector3 *plane_position = (const Vector3 *)data;
+
+    if (bullet.active) {
+        // Move the bullet forward in its direction
+        bullet.position = Vector3Add(bullet.position, Vector3Scale(bullet.direction, BULLET_SPEED * input.frameTime));
+
+        // Deactivate the bullet if it goes out of bounds
+        if (Vector3Length(bullet.position) > (plane_position->z + BULLET_RANGE)) {
+            bullet.active = false;
+        }
+    }
+}
+
+// Reads nothing but the packet and main-thread state, the simulation may be running meanwhile
+void Draw(const RenderPacket *packet) {
     // Draw
         //----------------------------------------------------------------------------------
+        double start = GetTime();
 
         BeginDrawing();
 
             ClearBackground(BLANK);
       
             // Draw 3D models
-            BeginMode3D(camera);
+            BeginMode3D(packet->camera);
 
                 // Enable wireframe mode
                 rlEnableWireMode();
@@ -149,120 +406,87 @@ void Draw() {
                 // Disable wireframe mode
                 rlDisableWireMode();
               
-                // Draw all models
-                for (size_t i = 0; i < models->size; ++i) {
-                    DrawModel(models->models[i].model, models->models[i].position, models->models[i].scale, models->models[i].color);
+                // Draw the visible models
+                for (int i = 0; i < packet->itemCount; ++i) {
+                    const RenderItem *item = &packet->items[i];
+                    DrawModel(item->model, item->position, item->scale, item->color);
                 }
 
-                if(bullet.active)
-                    DrawCube(bullet.position, 7.5f, 7.5f, 15.0f, RED);  // Draw the bullet as a rectangle
+                if(packet->bulletActive)
+                    DrawCube(packet->bulletPosition, 7.5f, 7.5f, 15.0f, RED);  // Draw the bullet as a rectangle
                 
             EndMode3D();
 
-            DrawRectangle(5, 45, 250, 90, Fade(GREEN, 0.5f));
-            DrawRectangleLines(5, 45, 250, 90, Fade(DARKGREEN, 0.5f));
-            char info[128];
-            sprintf(info, "Speed: %.2f units/s", speed);
-            DrawText(info, 10, 50, 15, WHITE);
-            sprintf(info, "Altitude: %.2f units", altitude);
-            DrawText(info, 10, 70, 15, WHITE);
-            sprintf(info, "Bullet Position: %f ", bullet.position.z);
-            DrawText(info, 10, 90, 15, WHITE);
-            sprintf(info, "Bullet Active: %d ", bullet.active);
-            DrawText(info, 10, 110, 15, WHITE);
-
-            
+            DrawRectangle(5, 45, 250, 250, Fade(GREEN, 0.5f));
+            DrawRectangleLines(5, 45, 250, 250, Fade(DARKGREEN, 0.5f));
+            DrawText(FormatArenaText(&frame_arena, "Speed: %.2f units/s", packet->speed), 10, 50, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Altitude: %.2f units", packet->altitude), 10, 70, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Bullet Position: %f ", packet->bulletPosition.z), 10, 90, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Bullet Active: %d ", packet->bulletActive), 10, 110, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "First frame: %.0f ms", loader.firstFrameTime * 1000.0), 10, 130, 15, WHITE);
+            if (IsAssetLoaderDone(&loader)) DrawText(FormatArenaText(&frame_arena, "Fully loaded: %.0f ms, %d opens", loader.loadedTime * 1000.0, GetAssetFileOpens()), 10, 150, 15, WHITE);
+            else DrawText(FormatArenaText(&frame_arena, "Loading: %d assets left", loader.pendingCount), 10, 150, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Entities: %d, %d visible (E: +%d)", packet->entityCount, packet->itemCount, ESCORT_BATCH), 10, 170, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Sim %.2f ms, draw %.2f ms, %d FPS", packet->simulationTime * 1000.0, draw_time * 1000.0, GetFPS()), 10, 190, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Pipelined: %s (P)", pipelined ? "on" : "off"), 10, 210, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Flight: %d x %d steps, %.0f bodies/ms", packet->flightBodies, packet->flightSteps,
+                    packet->flightTime > 0.0 ? packet->flightBodies * packet->flightSteps / (packet->flightTime * 1000.0) : 0.0), 10, 230, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Matrices: %d of %d, attachments %d of %d", packet->transformsRebuilt, packet->entityCount,
+                    packet->attachmentsRebuilt, packet->attachmentCount), 10, 250, 15, WHITE);
+            DrawText(FormatArenaText(&frame_arena, "Frame arenas: HUD %.1f KB, packet %.1f KB peak",
+                    frame_arena.lastUsed / 1024.0, packet->arena.highWater / 1024.0), 10, 270, 15, WHITE);
 
             DrawText("(c) HKN SoftCrafting", SCREEN_WIDTH - 200, SCREEN_HEIGHT - 20, 10, DARKGRAY);
 
+        // Submission only, EndDrawing waits for the frame rate cap
+        draw_time = GetTime() - start;
+
         EndDrawing();
         //----------------------------------------------------------------------------------
 }
 
-void ObjectLookAtMouse(Vector3 objectPosition, Camera3D camera, Matrix *outTransform)
+// Turn orientation towards the point under the mouse by at most maxAngle radians
+Quaternion ObjectLookAtMouse(Vector3 objectPosition, Vector2 mousePosition, Camera3D camera, Quaternion orientation, float maxAngle)
 {
-    // Get mouse position
-    Vector2 mousePosition = GetMousePosition();
-
     // Create a ray from the camera to the mouse position
     Ray ray = GetMouseRay(mousePosition, camera);
 
     // Find a point along the ray
     Vector3 targetPosition = Vector3Add(ray.position, Vector3Scale(ray.direction, 1000.0f));
+    Vector3 desired = Vector3Normalize(Vector3Subtract(targetPosition, objectPosition));
+    Vector3 forward = Vector3RotateByQuaternion((Vector3){ 0.0f, 0.0f, 1.0f }, orientation);
 
-    // Calculate forward vector (from target to object)
-    Vector3 forward = Vector3Subtract(objectPosition, targetPosition); // Swapped order
-    forward = Vector3Normalize(forward);
-
-    // **Invert the forward vector to face away from the camera**
-    forward = Vector3Negate(forward);
-
-    // Define up vector (Y-up)
-    Vector3 up = (Vector3){ 0.0f, 1.0f, 0.0f };
-
-    // Calculate right vector
-    Vector3 right = Vector3Normalize(Vector3CrossProduct(up, forward));
-
-    // Recalculate up vector to ensure orthogonality
-    up = Vector3CrossProduct(forward, right);
+    // Shortest arc from the current aim, clamped so the aim sweeps instead of snapping
+    float angle = acosf(Clamp(Vector3DotProduct(forward, desired), -1.0f, 1.0f));
+    if (angle <= 0.0f) return orientation;
 
-    // Create rotation matrix
-    Matrix rotation = {
-        right.x,    right.y,    right.z,    0.0f,
-        up.x,       up.y,       up.z,       0.0f,
-        forward.x,  forward.y,  forward.z,  0.0f,
-        0.0f,       0.0f,       0.0f,       1.0f
-    };
+    Quaternion turn = QuaternionFromVector3ToVector3(forward, desired);
+    if (angle > maxAngle) turn = QuaternionNlerp(QuaternionIdentity(), turn, maxAngle / angle);
 
-    // Create translation matrix
-    Matrix translation = MatrixTranslate(objectPosition.x, objectPosition.y, objectPosition.z);
-
-    // Combine translation and rotation
-    *outTransform = MatrixMultiply(translation, rotation);
+    return QuaternionNormalize(QuaternionMultiply(turn, orientation));
 }
 
 
 
-
 void UserInput(ModelInstance *plane_instance) {
-        // Plane pitch (x-axis) controls
-        if (IsKeyDown(KEY_DOWN)) { pitch += 0.6f; altitude -= 1.0f;}
-        else if (IsKeyDown(KEY_UP)) { pitch -= 0.6f; altitude += 1.0f;}
-        else
-        {
-            if (pitch > 0.3f) pitch -= 0.3f;
-            else if (pitch < -0.3f) pitch += 0.3f;
-        }
-
-        // Plane yaw (y-axis) controls
-        if (IsKeyDown(KEY_A)) yaw += 1.0f;
-        else if (IsKeyDown(KEY_S)) yaw -= 1.0f;
-        else
-        {
-            if (yaw > 0.0f) yaw -= 0.5f;
-            else if (yaw < 0.0f) yaw += 0.5f;
-        }
+        // Keys move the control surfaces, the flight model turns them into motion
+        float throttle = flight.throttle[0];
+        if (input.throttleUp) throttle += PLANE_THROTTLE_RATE * input.frameTime;
+        else if (input.throttleDown) throttle -= PLANE_THROTTLE_RATE * input.frameTime;
 
-        turning_value = 1.0f * GetFrameTime();
-        // Plane roll (z-axis) controls and x-axis control
-        if (IsKeyDown(KEY_LEFT)) {roll -= 1.0f; turning_value += 1.0f;} 
-        else if (IsKeyDown(KEY_RIGHT)) {roll += 1.0f; turning_value -= 1.0f;}
-        else
-        {
-            if (roll > 0.6f) roll -= 0.6f;
-            else if (roll < -0.6f) roll += 0.6f;
-        }
+        float pitch = (float)input.pitchUp - (float)input.pitchDown;
+        float yaw = (float)input.yawLeft - (float)input.yawRight;
+        float roll = (float)input.rollRight - (float)input.rollLeft;
+        SetFlightControls(&flight, 0, pitch, yaw, roll, throttle);
 
         // Plane shooting function
-        if (IsKeyPressed(KEY_SPACE) && !bullet.active) {
+        if (input.fire && !bullet.active) {
 
-            // Compute the plane's forward vector
-            Matrix rotation = plane_instance->model.transform;
-            Vector3 forward = { rotation.m8, rotation.m9, rotation.m10 };
-            forward = Vector3Normalize(forward);
+            // Compute the gun's forward vector
+            Vector3 forward = Vector3RotateByQuaternion((Vector3){ 0.0f, 0.0f, 1.0f }, aim_orientation);
 
-            bullet.position =  plane_instance->position;  // Set bullet position to plane's current position
-            bullet.direction = forward;  // Set bullet direction to the plane's forward vector
+            bullet.position = GetTransformPosition(&attachments, gun_node);  // Leave from the muzzle, where the last tick left it
+            bullet.direction = forward;  // Set bullet direction towards the mouse
             bullet.active = true;             // Activate the bullet
         }
 }
@@ -275,5 +499,13 @@ void UnloadGame() {
     // Free the model array
     FreeModelArray(models);
 
+    UnloadFlightBodies(&flight);
+    UnloadTransformHierarchy(&attachments);
+
+    // Wait for decode jobs and unload the assets the loader owns
+    UnloadAssetLoader(&loader);
+    UnmountAssetPack();
+    UnloadJobSystem(&jobs);
+
     CloseWindow(); // Close window and OpenGL context
 }
\ No newline at end of file
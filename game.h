@@ -1,40 +1,84 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include <stdbool.h>
 #include "raylib.h"
 #include "ModelArray.h"
+#include "RenderPacket.h"
 
 // Constants
 #define     SCREEN_WIDTH                1080
 #define     SCREEN_HEIGHT               720
 #define     TARGET_FPS                  60
+#define     JOB_THREADS                 4       // Job system threads, including the main thread
+#define     FRAME_ARENA_SIZE            (16 * 1024)  // First block of the main thread's frame arena, HUD text and the like
 
 #define     PLANE_INITIAL_POSITION_X    0.0f
 #define     PLANE_INITIAL_POSITION_Y    25.0f
 #define     PLANE_INITIAL_POSITION_Z    -5.0f
 #define     PLANE_INITIAL_SCALE         1.0f
-#define     PLANE_INITIAL_SPEED         25.0f // Units per second
+#define     PLANE_INITIAL_SPEED         60.0f // Units per second, near cruise so the plane does not start in a stall
+#define     AIM_TURN_RATE               6.0f  // Radians per second the gun aim follows the mouse
+#define     PLANE_THROTTLE_RATE         0.5f  // Throttle change per second while Shift/Ctrl is held
+#define     PLANE_GUN_OFFSET            10.0f // Muzzle distance ahead of the plane's origin
 
 #define     CAMERA_INITIAL_POSITION_X    0.0f
 #define     CAMERA_INITIAL_POSITION_Y    5.0f
 #define     CAMERA_INITIAL_POSITION_Z    -15.0f
 #define     CAMERA_FOVY                  60.0f        
+#define     CAMERA_FOLLOW_DISTANCE       300.0f       // Behind the plane along its ground track
+#define     CAMERA_FOLLOW_HEIGHT         100.0f       // Above the plane
+
+#define     ESCORT_BATCH                100     // Escorts added per press of E
+#define     ESCORT_SPACING              60.0f   // Distance between escort formation rings
+#define     ENTITY_CULL_RADIUS          30.0f   // Bounding sphere of a model at scale 1, for frustum culling
+
+#define     FRAMEBENCH_WARMUP           60      // Frames run before timing each case of game -framebench
+#define     FRAMEBENCH_FRAMES           600     // Frames timed per case
 
 #define     WINDOW_NAME                 "FLIGHT MANIA"
 
 // Resource paths
 #define     PLANE_MODEL     "resources/models/obj/plane.obj"
+#define     PLANE_MODEL_BAKED "resources/models/bin/plane.fmesh"   // Written by tools/meshbaker, preferred when present
 #define     PLANE_TEXTURE   "resources/models/obj/plane_diffuse.png"
+#define     PLANE_TEXTURE_BAKED "resources/models/bin/plane_diffuse.ftex"  // Written by tools/texbaker, preferred when present
+#define     ASSET_PACK      "resources/assets.fpak"   // Written by tools/packer, serves the paths above when present
 
+// Input sampled on the main thread, raylib only polls it there
+typedef struct InputState {
+    bool pitchDown;
+    bool pitchUp;
+    bool yawLeft;
+    bool yawRight;
+    bool rollLeft;
+    bool rollRight;
+    bool throttleUp;
+    bool throttleDown;
+    bool fire;
+    Vector2 mouse;
+    float frameTime;
+} InputState;
 
 // Function declarations
 void LoadModels();
 void LoadGame();
 void GameLoop();
-void Draw();
+void BeginFrames();
+void RunFrame(int frame);
+void EndFrames();
+void RunFrameBench();
+void Draw(const RenderPacket *packet);
+InputState ReadInput();
+void Simulate(RenderPacket *packet);
+void SimulateJob(void *data);
+void SpawnEscorts(int count);
+Vector3 GetEscortOffset(int index);
+void UpdateEscorts(Vector3 center);
 void UserInput();
+void UpdateBullet(void *data);
 void UnloadGame();
-void ObjectLookAtMouse(Vector3 objectPosition, Camera3D camera, Matrix *outTransform);
+Quaternion ObjectLookAtMouse(Vector3 objectPosition, Vector2 mousePosition, Camera3D camera, Quaternion orientation, float maxAngle);
 
 
 
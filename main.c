@@ -1,8 +1,19 @@
 #include "game.h"
+#include <stdio.h>
+#include <string.h>
 
-int main(void)
+int main(int argc, char **argv)
 {
+    // -framebench times scripted frames in a hidden window instead of playing
+    bool bench = argc == 2 && strcmp(argv[1], "-framebench") == 0;
+    if (argc > 1 && !bench) {
+        printf("Usage: game [-framebench]\n");
+        return 1;
+    }
+    if (bench) SetConfigFlags(FLAG_WINDOW_HIDDEN);
+
     LoadGame();
-    GameLoop();
+    if (bench) RunFrameBench();
+    else GameLoop();
     UnloadGame();
 }
@@ -0,0 +1,54 @@
+// BenchClock.h
+// Monotonic wall clock for the test and benchmark tools, and a page cache drop for cold loads.
+// Include before any other header: it sets _POSIX_C_SOURCE for clock_gettime and posix_fadvise
+// under -std=c99.
+#ifndef BENCHCLOCK_H
+#define BENCHCLOCK_H
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI                   // Keeps windows.h from clashing with raylib names included later
+    #define NOUSER
+    #include <windows.h>
+#else
+    #ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+    #endif
+    #include <time.h>
+#endif
+
+#include <stdbool.h>
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Seconds since an arbitrary start
+static inline double GetBenchClock(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+// Evicts a file's clean pages so the next read comes from disk, false where that is not possible
+static inline bool DropBenchFileCache(const char *fileName) {
+#if defined(__linux__)
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+    bool dropped = fdatasync(fd) == 0 && posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    close(fd);
+    return dropped;
+#else
+    (void)fileName;
+    return false;
+#endif
+}
+
+#endif // BENCHCLOCK_H
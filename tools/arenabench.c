@@ -0,0 +1,178 @@
+// arenabench.c
+// Frame arena against malloc and free for the three per-frame patterns that use it: HUD text,
+// the render list and the per-range cull scratch.
+// Usage: arenabench [-frames N]
+//
+// HUD: the fourteen lines game.c draws, through FormatArenaText and a reset at the end of the
+// frame, against a malloc'd snprintf per line freed at the end of the frame. Render list:
+// ARENABENCH_ITEMS pushes through RenderPacket, against a list malloc'd at
+// RENDER_PACKET_INITIAL_ITEMS, grown with realloc and freed every frame. Cull scratch: one
+// AIFleet-style index list per AI_CULL_GRAIN aircraft of ARENABENCH_AIRCRAFT, from one arena,
+// against one malloc per range. Everything runs on the main thread, so only the allocator differs.
+// The Makefile builds this without arena poisoning, as a release build runs.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "Arena.h"
+#include "AIFleet.h"
+#include "RenderPacket.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENABENCH_FRAMES       10000       // Default frames timed per way
+#define ARENABENCH_REPEATS      3           // Runs per way, alternating, the fastest is reported
+#define ARENABENCH_HUD_LINES    14          // Lines of the game's HUD
+#define ARENABENCH_ITEMS        1000        // Render items pushed per frame
+#define ARENABENCH_AIRCRAFT     10000       // Aircraft culled per frame
+#define ARENABENCH_ARENA_SIZE   (64 * 1024) // First block of the HUD and cull arenas
+
+typedef enum BenchWay { WAY_ARENA = 0, WAY_MALLOC, WAY_COUNT } BenchWay;
+
+// AIFleet's cull range, private to AIFleet.c
+typedef struct CullRange {
+    struct CullRange *next;
+    int planeCount;
+    int bulletCount;
+    int indices[];
+} CullRange;
+
+typedef double (*BenchPattern)(BenchWay way, int frames);
+
+static volatile size_t sink;
+
+static double TimeHudText(BenchWay way, int frames);
+static double TimeRenderList(BenchWay way, int frames);
+static double TimeCullScratch(BenchWay way, int frames);
+
+int main(int argc, char **argv) {
+    int frames = ARENABENCH_FRAMES;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc) frames = atoi(argv[++i]);
+        else {
+            printf("Usage: arenabench [-frames N]\n");
+            return 1;
+        }
+    }
+    if (frames < 1) frames = 1;
+
+    const char *names[3] = { "HUD text", "render list", "cull scratch" };
+    BenchPattern patterns[3] = { TimeHudText, TimeRenderList, TimeCullScratch };
+    printf("Frame arena against malloc, %d frames, best of %d, arena poisoning %s:\n", frames, ARENABENCH_REPEATS, ARENA_POISON ? "on" : "off");
+    for (int p = 0; p < 3; p++) {
+        double best[WAY_COUNT] = { INFINITY, INFINITY };
+        for (int repeat = 0; repeat < ARENABENCH_REPEATS; repeat++) {
+            for (int way = 0; way < WAY_COUNT; way++) best[way] = fmin(best[way], patterns[p](way, frames));
+        }
+        printf("  %-12s arena %7.3f us per frame, malloc %7.3f us per frame, %.2fx\n",
+               names[p], best[WAY_ARENA] * 1e6, best[WAY_MALLOC] * 1e6, best[WAY_MALLOC] / best[WAY_ARENA]);
+    }
+
+    return 0;
+}
+
+// Seconds per frame of HUD lines like game.c's, the text is read once as DrawText would
+static double TimeHudText(BenchWay way, int frames) {
+    Arena arena;
+    InitArena(&arena, ARENABENCH_ARENA_SIZE);
+    char *lines[ARENABENCH_HUD_LINES];
+
+    double start = GetBenchClock();
+    for (int frame = 0; frame < frames; frame++) {
+        float value = frame * 0.37f;
+        for (int line = 0; line < ARENABENCH_HUD_LINES; line++) {
+            const char *format = (line & 1) ? "Entities: %d, %d visible (E: +%d)" : "Sim %.2f ms, draw %.2f ms, %d FPS";
+            if (way == WAY_ARENA) {
+                lines[line] = (line & 1) ? FormatArenaText(&arena, format, frame, line, 100) : FormatArenaText(&arena, format, value, value, frame);
+            } else {
+                int length = (line & 1) ? snprintf(NULL, 0, format, frame, line, 100) : snprintf(NULL, 0, format, value, value, frame);
+                lines[line] = (char *)malloc(length + 1);
+                if ((line & 1)) snprintf(lines[line], length + 1, format, frame, line, 100);
+                else snprintf(lines[line], length + 1, format, value, value, frame);
+            }
+            sink += lines[line][0];
+        }
+
+        if (way == WAY_ARENA) ResetArena(&arena);
+        else for (int line = 0; line < ARENABENCH_HUD_LINES; line++) free(lines[line]);
+    }
+    double seconds = (GetBenchClock() - start) / frames;
+
+    UnloadArena(&arena);
+    return seconds;
+}
+
+// Seconds per frame of clearing and filling a 1k-item render list
+static double TimeRenderList(BenchWay way, int frames) {
+    RenderPacket packet;
+    InitRenderPacket(&packet);
+    ModelInstance instance = { 0 };
+
+    double start = GetBenchClock();
+    for (int frame = 0; frame < frames; frame++) {
+        if (way == WAY_ARENA) {
+            ClearRenderPacket(&packet);
+            for (int i = 0; i < ARENABENCH_ITEMS; i++) {
+                instance.position.x = (float)i;
+                PushRenderItem(&packet, &instance);
+            }
+            sink += packet.itemCount;
+            continue;
+        }
+
+        // The same pushes into a heap list that starts small every frame
+        int capacity = RENDER_PACKET_INITIAL_ITEMS, count = 0;
+        RenderItem *items = (RenderItem *)malloc(capacity * sizeof(RenderItem));
+        for (int i = 0; i < ARENABENCH_ITEMS; i++) {
+            if (count == capacity) {
+                capacity *= 2;
+                items = (RenderItem *)realloc(items, capacity * sizeof(RenderItem));
+            }
+            instance.position.x = (float)i;
+            RenderItem *item = &items[count++];
+            item->model = instance.model;
+            item->position = instance.position;
+            item->scale = instance.scale;
+            item->color = instance.color;
+        }
+        sink += count;
+        free(items);
+    }
+    double seconds = (GetBenchClock() - start) / frames;
+
+    UnloadRenderPacket(&packet);
+    return seconds;
+}
+
+// Seconds per frame of the cull's scratch lists, every aircraft and no bullet visible
+static double TimeCullScratch(BenchWay way, int frames) {
+    Arena arena;
+    InitArena(&arena, ARENABENCH_ARENA_SIZE);
+
+    double start = GetBenchClock();
+    for (int frame = 0; frame < frames; frame++) {
+        CullRange *ranges = NULL;
+        for (int begin = 0; begin < ARENABENCH_AIRCRAFT; begin += AI_CULL_GRAIN) {
+            int end = begin + AI_CULL_GRAIN < ARENABENCH_AIRCRAFT ? begin + AI_CULL_GRAIN : ARENABENCH_AIRCRAFT;
+            size_t size = sizeof(CullRange) + 2 * (end - begin) * sizeof(int);
+            CullRange *range = (CullRange *)(way == WAY_ARENA ? AllocArena(&arena, size) : malloc(size));
+            range->planeCount = 0;
+            range->bulletCount = 0;
+            for (int i = begin; i < end; i++) range->indices[range->planeCount++] = i;
+            range->next = ranges;
+            ranges = range;
+        }
+
+        for (CullRange *range = ranges; range;) {
+            CullRange *next = range->next;
+            sink += range->planeCount;
+            if (way == WAY_MALLOC) free(range);
+            range = next;
+        }
+        if (way == WAY_ARENA) ResetArena(&arena);
+    }
+    double seconds = (GetBenchClock() - start) / frames;
+
+    UnloadArena(&arena);
+    return seconds;
+}
@@ -0,0 +1,235 @@
+// arenatest.c
+// Checks of the frame arena, exits non-zero if any fails.
+// Usage: arenatest
+//
+// Alignment: odd sizes, across a spill into a chained block, every pointer ARENA_ALIGNMENT aligned.
+// Marks: rewinding hands back exactly what came after the mark, within a block and across blocks,
+// and the next allocation reuses the memory without chaining a new block.
+// Fold: a frame that spilled into several blocks resets into one block that holds the whole frame,
+// so the same frame again adds no block.
+// High water: lastUsed is the frame before the reset, highWater the largest frame so far.
+// Text: FormatArenaText output matches snprintf for short texts, texts longer than the free tail
+// and texts longer than a whole block.
+// Builds with ARENA_POISON also check the fill of fresh and handed back memory.
+#include "Arena.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENATEST_BLOCK         1024        // Block size of every test arena, small so tests spill
+#define ARENATEST_ALLOCATIONS   200         // Allocations of the alignment test
+#define ARENATEST_LONG_TEXT     5000        // Characters of the longest formatted text, several blocks
+
+static int TestAlignment(void);
+static int TestMarks(void);
+static int TestFold(void);
+static int TestHighWater(void);
+static int TestText(void);
+static int CheckText(Arena *arena, const char *what, const char *text, const char *expected);
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        printf("Usage: arenatest\n");
+        return 1;
+    }
+
+    int failures = 0;
+    failures += TestAlignment();
+    failures += TestMarks();
+    failures += TestFold();
+    failures += TestHighWater();
+    failures += TestText();
+
+    if (failures) {
+        printf("arenatest: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("arenatest: all checks passed\n");
+    return 0;
+}
+
+// Returns the number of failed checks
+static int TestAlignment(void) {
+    Arena arena;
+    InitArena(&arena, ARENATEST_BLOCK);
+
+    int misaligned = 0, overlapping = 0;
+    unsigned char *previous = NULL;
+    size_t previousSize = 0;
+    for (int i = 0; i < ARENATEST_ALLOCATIONS; i++) {
+        size_t size = 1 + (i * 37) % 61;
+        unsigned char *memory = (unsigned char *)AllocArena(&arena, size);
+        if ((uintptr_t)memory % ARENA_ALIGNMENT != 0) misaligned++;
+
+        // Within a block allocations only move forward, a new block starts anywhere
+        if (previous && memory > previous && memory < previous + previousSize) overlapping++;
+        memset(memory, i, size);
+        previous = memory;
+        previousSize = size;
+    }
+
+    printf("Alignment: %d allocations in %d blocks, %d misaligned, %d overlapping\n",
+           ARENATEST_ALLOCATIONS, arena.blocksAdded + 1, misaligned, overlapping);
+    int failures = (misaligned > 0) + (overlapping > 0) + (arena.blocksAdded == 0);
+    if (misaligned) printf("  FAILED: allocations not aligned to %d bytes\n", ARENA_ALIGNMENT);
+    if (overlapping) printf("  FAILED: allocations overlap\n");
+    if (arena.blocksAdded == 0) printf("  FAILED: the test never spilled into a second block\n");
+
+    UnloadArena(&arena);
+    return failures;
+}
+
+// Returns the number of failed checks
+static int TestMarks(void) {
+    Arena arena;
+    InitArena(&arena, ARENATEST_BLOCK);
+    int failures = 0;
+
+    AllocArena(&arena, 100);
+    ArenaMark mark = GetArenaMark(&arena);
+    size_t usedAtMark = arena.used;
+
+    // Within the block: the next allocation after the rewind lands where the scratch did
+    unsigned char *scratch = (unsigned char *)AllocArena(&arena, 200);
+    memset(scratch, 0x11, 200);
+    ResetArenaToMark(&arena, mark);
+    size_t usedAfterRewind = arena.used;
+    bool samePointer = AllocArena(&arena, 200) == scratch;
+#if ARENA_POISON
+    bool poisoned = scratch[0] == ARENA_POISON_ALLOCATED && scratch[199] == ARENA_POISON_ALLOCATED;
+#else
+    bool poisoned = true;
+#endif
+    printf("Mark in one block: used %zu after rewind (expected %zu), scratch reused %s\n", usedAfterRewind, usedAtMark, samePointer ? "yes" : "no");
+    if (usedAfterRewind != usedAtMark || !samePointer) {
+        printf("  FAILED: rewind did not hand back exactly the scratch\n");
+        failures++;
+    }
+    if (!poisoned) {
+        printf("  FAILED: reused scratch is not filled with 0x%02X\n", ARENA_POISON_ALLOCATED);
+        failures++;
+    }
+
+    // Across blocks: scratch spills into new blocks, the rewind keeps them for the next spill
+    ResetArenaToMark(&arena, mark);
+    for (int i = 0; i < 3; i++) AllocArena(&arena, ARENATEST_BLOCK / 2 + 100);
+    int blocksAdded = arena.blocksAdded;
+#if ARENA_POISON
+    unsigned char *spilled = (unsigned char *)arena.current + sizeof(ArenaBlock);
+#endif
+    ResetArenaToMark(&arena, mark);
+#if ARENA_POISON
+    poisoned = spilled[0] == ARENA_POISON_FREED;
+#endif
+    bool sameUsed = arena.used == usedAtMark;
+    for (int i = 0; i < 3; i++) AllocArena(&arena, ARENATEST_BLOCK / 2 + 100);
+    printf("Mark across blocks: %d blocks chained, %d more for the same scratch after rewind, used %s\n",
+           blocksAdded, arena.blocksAdded - blocksAdded, sameUsed ? "restored" : "not restored");
+    if (!sameUsed || arena.blocksAdded != blocksAdded || blocksAdded == 0) {
+        printf("  FAILED: rewinding across blocks lost or leaked blocks\n");
+        failures++;
+    }
+    if (!poisoned) {
+        printf("  FAILED: handed back block is not filled with 0x%02X\n", ARENA_POISON_FREED);
+        failures++;
+    }
+
+    UnloadArena(&arena);
+    return failures;
+}
+
+// Returns the number of failed checks
+static int TestFold(void) {
+    Arena arena;
+    InitArena(&arena, ARENATEST_BLOCK);
+
+    for (int i = 0; i < 10; i++) AllocArena(&arena, 300);
+    int spilled = arena.blocksAdded;
+    size_t frame = arena.used;
+    ResetArena(&arena);
+
+    bool single = arena.first && !arena.first->next;
+    size_t capacity = arena.first ? arena.first->capacity : 0;
+    for (int i = 0; i < 10; i++) AllocArena(&arena, 300);
+    int added = arena.blocksAdded - spilled;
+
+    printf("Fold: frame of %zu bytes spilled into %d blocks, reset to %s of %zu bytes, %d blocks added repeating the frame\n",
+           frame, spilled + 1, single ? "one block" : "several blocks", capacity, added);
+    int failures = !single + (capacity < frame) + (added != 0) + (spilled == 0);
+    if (spilled == 0) printf("  FAILED: the frame never spilled\n");
+    if (!single || capacity < frame) printf("  FAILED: reset did not fold the blocks into one that holds the frame\n");
+    if (added) printf("  FAILED: the same frame chained blocks again\n");
+
+    UnloadArena(&arena);
+    return failures;
+}
+
+// Returns the number of failed checks
+static int TestHighWater(void) {
+    Arena arena;
+    InitArena(&arena, ARENATEST_BLOCK);
+
+    const size_t frames[] = { 500, 3000, 1200 };
+    size_t largest = 0;
+    for (int i = 0; i < 3; i++) {
+        AllocArena(&arena, frames[i]);
+        largest = arena.used > largest ? arena.used : largest;
+        ResetArena(&arena);
+    }
+
+    bool lastUsed = arena.lastUsed >= frames[2] && arena.lastUsed < frames[2] + ARENA_ALIGNMENT;
+    printf("High water: frames of 500, 3000 and 1200 bytes, high water %zu (expected %zu), last frame %zu\n",
+           arena.highWater, largest, arena.lastUsed);
+    int failures = (arena.highWater != largest || largest < frames[1]) + !lastUsed;
+    if (arena.highWater != largest || largest < frames[1]) printf("  FAILED: high water is not the largest frame\n");
+    if (!lastUsed) printf("  FAILED: lastUsed is not the frame before the reset\n");
+
+    UnloadArena(&arena);
+    return failures;
+}
+
+// Returns the number of failed checks
+static int TestText(void) {
+    Arena arena;
+    InitArena(&arena, ARENATEST_BLOCK);
+    int failures = 0;
+
+    char expected[ARENATEST_LONG_TEXT + 1];
+    snprintf(expected, sizeof(expected), "Speed: %.2f units/s", 123.456);
+    AllocArena(&arena, 1);
+    const char *text = FormatArenaText(&arena, "Speed: %.2f units/s", 123.456);
+    failures += CheckText(&arena, "short", text, expected);
+
+    // Fitting texts are formatted in place and claim only their characters and terminator
+    size_t claimed = arena.current->used - (size_t)((const unsigned char *)text - (const unsigned char *)(arena.current + 1));
+    if (claimed != strlen(expected) + 1) {
+        printf("  FAILED: short text claimed %zu bytes, expected %zu\n", claimed, strlen(expected) + 1);
+        failures++;
+    }
+
+    // Longer than what is left of the block, formatted again into a new one
+    AllocArena(&arena, ARENATEST_BLOCK - 100);
+    memset(expected, 'a', 300);
+    expected[300] = '\0';
+    failures += CheckText(&arena, "past the free tail", FormatArenaText(&arena, "%s", expected), expected);
+
+    // Longer than any block
+    for (int i = 0; i < ARENATEST_LONG_TEXT; i++) expected[i] = (char)('a' + i % 26);
+    expected[ARENATEST_LONG_TEXT] = '\0';
+    failures += CheckText(&arena, "longer than a block", FormatArenaText(&arena, "%.*s", ARENATEST_LONG_TEXT, expected), expected);
+
+    UnloadArena(&arena);
+    return failures;
+}
+
+// Returns 1 if the text is missing, misaligned or differs
+static int CheckText(Arena *arena, const char *what, const char *text, const char *expected) {
+    bool same = text && strcmp(text, expected) == 0;
+    bool aligned = text && (uintptr_t)text % ARENA_ALIGNMENT == 0;
+
+    printf("Text %-20s %5zu characters, %s, %s, %d blocks chained\n", what, strlen(expected), same ? "matches" : "differs",
+           aligned ? "aligned" : "misaligned", arena->blocksAdded);
+    if (!same || !aligned) printf("  FAILED: FormatArenaText %s\n", !text ? "returned NULL" : (!same ? "text differs from snprintf" : "text is misaligned"));
+    return !same || !aligned;
+}
@@ -0,0 +1,134 @@
+// fleetbench.c
+// AI fleet benchmark: simulation and matrix work per tick, against rebuilding every matrix from
+// Euler angles. Exits non-zero if the steering stops converging or an orientation drifts.
+// Usage: fleetbench [-ticks N] [-threads N]
+//
+// The Euler baseline is what the game did per plane before orientations became quaternions:
+// trig for pitch, yaw and roll, a look-at, MatrixRotateXYZ and two full 4x4 multiplies, for every aircraft
+// every tick. The fleet instead turns a half-angle yaw incrementally and rebuilds the matrix of
+// an aircraft only when its attitude changed.
+//
+// Flat ground, so the numbers are the fleet's own and not the terrain's.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "AIFleet.h"
+#include "JobSystem.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FLEETBENCH_TICKS        600         // Default ticks timed, ten seconds of flight
+#define FLEETBENCH_WARMUP       120         // Ticks flown before timing, so every aircraft is mid-patrol
+#define FLEETBENCH_THREADS      4           // Default job system threads, including the main thread
+#define FLEETBENCH_TICK         (1.0f / 60.0f)
+#define FLEETBENCH_ON_COURSE    0.05f       // Radians, aircraft this close to their waypoint bearing count as on course
+#define FLEETBENCH_MIN_ON_COURSE 0.6f       // Fraction on course after the run, below means steering broke
+#define FLEETBENCH_ROTOR_ERROR  1e-4f       // Largest accepted deviation of a half-angle yaw from unit length
+
+static JobSystem jobs;
+static volatile float sink;
+
+static int RunFleet(int count, int ticks);
+static double TimeEulerMatrices(const AIFleet *fleet, int ticks, Matrix *transforms);
+
+int main(int argc, char **argv) {
+    int ticks = FLEETBENCH_TICKS;
+    int threads = FLEETBENCH_THREADS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-ticks") == 0 && i + 1 < argc) ticks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else {
+            printf("Usage: fleetbench [-ticks N] [-threads N]\n");
+            return 1;
+        }
+    }
+    if (ticks < 1) ticks = 1;
+
+    InitJobSystem(&jobs, threads);
+    printf("Fleet, %d ticks of %.4f s on %d threads, per tick:\n", ticks, FLEETBENCH_TICK, threads);
+
+    int failures = 0;
+    const int counts[] = { 1000, 5000, 10000 };
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) failures += RunFleet(counts[i], ticks);
+
+    UnloadJobSystem(&jobs);
+    return failures ? 1 : 0;
+}
+
+// Returns 1 if the fleet failed its checks
+static int RunFleet(int count, int ticks) {
+    AIFleet fleet;
+    InitAIFleet(&fleet, &jobs, NULL, NULL);
+    Vector3 center = { 0.0f, 0.0f, 0.0f };
+    Vector3 target = { 0.0f, -10000.0f, 0.0f };    // Out of range, no bullets in the timing
+    SetAIFleetCount(&fleet, count, center);
+    for (int tick = 0; tick < FLEETBENCH_WARMUP; tick++) UpdateAIFleet(&fleet, center, target, FLEETBENCH_TICK);
+
+    double updateTime = 0.0, matrixTime = 0.0;
+    long long rebuilt = 0;
+    for (int tick = 0; tick < ticks; tick++) {
+        UpdateAIFleet(&fleet, center, target, FLEETBENCH_TICK);
+        updateTime += fleet.updateTime;
+        matrixTime += fleet.matrixTime;
+        rebuilt += fleet.matricesRebuilt;
+    }
+
+    Matrix *transforms = (Matrix *)malloc(count * sizeof(Matrix));
+    double eulerTime = TimeEulerMatrices(&fleet, ticks, transforms);
+    free(transforms);
+
+    // The half-angle yaw is the only heading: it must stay unit length and keep aircraft on course
+    int onCourse = 0;
+    float worstRotor = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float yawSin = fleet.yawSin[i], yawCos = fleet.yawCos[i];
+        float rotorError = fabsf(yawSin * yawSin + yawCos * yawCos - 1.0f);
+        if (rotorError > worstRotor) worstRotor = rotorError;
+
+        float forwardX = 2.0f * yawSin * yawCos;
+        float forwardZ = yawCos * yawCos - yawSin * yawSin;
+        float toWaypointX = fleet.waypointX[i] - fleet.positionX[i];
+        float toWaypointZ = fleet.waypointZ[i] - fleet.positionZ[i];
+        float bearing = atan2f(toWaypointX * forwardZ - toWaypointZ * forwardX, toWaypointX * forwardX + toWaypointZ * forwardZ);
+        onCourse += fabsf(bearing) < FLEETBENCH_ON_COURSE;
+    }
+    float onCourseFraction = (float)onCourse / (float)count;
+
+    printf("  %5d aircraft: update %.3f ms (matrices %.3f ms, %lld of %d rebuilt), Euler rebuild of all %.3f ms, %.1fx the matrix work\n",
+           count, updateTime / ticks * 1000.0, matrixTime / ticks * 1000.0, rebuilt / ticks, count, eulerTime / ticks * 1000.0,
+           matrixTime > 0.0 ? eulerTime / matrixTime : 0.0);
+    printf("                  %.0f%% on course, worst rotor length error %.2g\n", onCourseFraction * 100.0f, worstRotor);
+
+    UnloadAIFleet(&fleet);
+
+    if (onCourseFraction < FLEETBENCH_MIN_ON_COURSE || worstRotor > FLEETBENCH_ROTOR_ERROR) {
+        printf("  FAILED: steering or orientation drifted\n");
+        return 1;
+    }
+    return 0;
+}
+
+// Per aircraft per tick: the angles back from the state, a look-at, MatrixRotateXYZ and two multiplies
+static double TimeEulerMatrices(const AIFleet *fleet, int ticks, Matrix *transforms) {
+    double start = GetBenchClock();
+
+    for (int tick = 0; tick < ticks; tick++) {
+        for (int i = 0; i < fleet->count; i++) {
+            float yaw = 2.0f * atan2f(fleet->yawSin[i], fleet->yawCos[i]);
+            float pitch = -atan2f(fleet->climbRate[i], fleet->speed[i]);
+            float roll = 0.0f;
+            Matrix rotation = MatrixRotateXYZ((Vector3){ pitch, yaw, roll });
+            Vector3 position = { fleet->positionX[i], fleet->positionY[i], fleet->positionZ[i] };
+            Vector3 waypoint = { fleet->waypointX[i], fleet->positionY[i], fleet->waypointZ[i] };
+            Matrix aim = MatrixLookAt(position, waypoint, (Vector3){ 0.0f, 1.0f, 0.0f });
+            Matrix translation = MatrixTranslate(fleet->positionX[i], fleet->positionY[i], fleet->positionZ[i]);
+            transforms[i] = MatrixMultiply(MatrixMultiply(rotation, aim), translation);
+        }
+        sink += transforms[tick % fleet->count].m0;
+    }
+
+    return GetBenchClock() - start;
+}
@@ -0,0 +1,85 @@
+// flightbench.c
+// Flight model throughput: StepFlightBodies over 1k, 10k and 100k bodies, serially and on the job
+// system, printed as bodies integrated per millisecond.
+// Usage: flightbench [-steps N] [-threads N]
+//
+// Bodies start level on a grid at cruise speed with controls spread over their whole range, so
+// the batches see every branch of the stall and rate limits the game meets. Each set is flown
+// FLIGHTBENCH_WARMUP steps before timing so the bodies are banked and climbing, not level.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "FlightModel.h"
+#include "JobSystem.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FLIGHTBENCH_STEPS       240         // Default steps timed per run, two seconds of flight
+#define FLIGHTBENCH_WARMUP      60          // Steps flown before timing
+#define FLIGHTBENCH_REPEATS     3           // Runs per set and way, alternating, the fastest is reported
+#define FLIGHTBENCH_THREADS     4           // Default job system threads, including the main thread
+#define FLIGHTBENCH_SPACING     50.0f       // Units between bodies on the start grid
+#define FLIGHTBENCH_ALTITUDE    1000.0f
+#define FLIGHTBENCH_SPEED       60.0f
+
+static JobSystem jobs;
+
+static double TimeFlightSteps(int count, JobSystem *system, int steps);
+
+int main(int argc, char **argv) {
+    int steps = FLIGHTBENCH_STEPS;
+    int threads = FLIGHTBENCH_THREADS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-steps") == 0 && i + 1 < argc) steps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else {
+            printf("Usage: flightbench [-steps N] [-threads N]\n");
+            return 1;
+        }
+    }
+    if (steps < 1) steps = 1;
+
+    InitJobSystem(&jobs, threads);
+    printf("Flight bodies, %d steps of %.4f s, serial against %d threads, best of %d:\n", steps, FLIGHT_FIXED_STEP, threads, FLIGHTBENCH_REPEATS);
+
+    const int counts[] = { 1000, 10000, 100000 };
+    for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); i++) {
+        double serial = INFINITY, parallel = INFINITY;
+        for (int repeat = 0; repeat < FLIGHTBENCH_REPEATS; repeat++) {
+            serial = fmin(serial, TimeFlightSteps(counts[i], NULL, steps));
+            parallel = fmin(parallel, TimeFlightSteps(counts[i], &jobs, steps));
+        }
+        printf("  %6d bodies: serial %8.3f ms per step, %8.0f bodies/ms; jobs %8.3f ms per step, %8.0f bodies/ms, speedup %.2fx\n",
+               counts[i], serial * 1000.0, counts[i] / (serial * 1000.0), parallel * 1000.0, counts[i] / (parallel * 1000.0), serial / parallel);
+    }
+
+    UnloadJobSystem(&jobs);
+    return 0;
+}
+
+// Seconds per StepFlightBodies of count bodies
+static double TimeFlightSteps(int count, JobSystem *system, int steps) {
+    FlightBodies bodies;
+    InitFlightBodies(&bodies, GetDefaultFlightParams(), system);
+
+    int side = (int)ceilf(sqrtf((float)count));
+    for (int i = 0; i < count; i++) {
+        Vector3 position = { (i % side) * FLIGHTBENCH_SPACING, FLIGHTBENCH_ALTITUDE, (i / side) * FLIGHTBENCH_SPACING };
+        int body = AddFlightBody(&bodies, position, (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f }, FLIGHTBENCH_SPEED);
+
+        // Low-discrepancy controls, the same on every run
+        float u = fmodf(i * 0.6180340f, 1.0f), v = fmodf(i * 0.7548777f, 1.0f), w = fmodf(i * 0.5698403f, 1.0f);
+        SetFlightControls(&bodies, body, 2.0f * u - 1.0f, 0.5f * (2.0f * w - 1.0f), 2.0f * v - 1.0f, 0.2f + 0.8f * w);
+    }
+
+    for (int step = 0; step < FLIGHTBENCH_WARMUP; step++) StepFlightBodies(&bodies, FLIGHT_FIXED_STEP);
+
+    double start = GetBenchClock();
+    for (int step = 0; step < steps; step++) StepFlightBodies(&bodies, FLIGHT_FIXED_STEP);
+    double seconds = (GetBenchClock() - start) / steps;
+
+    UnloadFlightBodies(&bodies);
+    return seconds;
+}
@@ -0,0 +1,137 @@
+// flighttest.c
+// Energy checks of the flight model, exits non-zero if any fails.
+// Usage: flighttest
+//
+// Ballistic: with every aerodynamic coefficient zeroed only gravity acts, and semi-implicit Euler
+// changes the energy by exactly -g^2 dt^2 / 2 per step. The run must match that to within the
+// rounding of the float height, half a unit in the last place per step.
+//
+// Glide: the default airframe at zero throttle and neutral controls. Energy may never rise from
+// one step to the next, and what it loses must match the work the aerodynamic forces do on the
+// velocity, summed per step from the body state with the same integrator bias.
+#include "raylib.h"
+#include "FlightModel.h"
+#include <math.h>
+#include <stdio.h>
+
+#define FLIGHTTEST_SECONDS          60.0f       // Length of each run
+#define FLIGHTTEST_ALTITUDE         3000.0f     // Start height, high enough to glide the whole run
+#define FLIGHTTEST_SPEED            60.0f       // Start speed, level
+#define FLIGHTTEST_ROUNDING         1e-6f       // Rise accepted in one step, relative to the energy
+#define FLIGHTTEST_WORK_ERROR       0.02f       // Largest accepted difference of energy lost and aerodynamic work
+
+static int TestBallistic(void);
+static int TestGlide(void);
+static float GetAerodynamicPower(const FlightBodies *bodies, int index);
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        printf("Usage: flighttest\n");
+        return 1;
+    }
+
+    int failures = 0;
+    failures += TestBallistic();
+    failures += TestGlide();
+
+    if (failures) {
+        printf("flighttest: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("flighttest: all checks passed\n");
+    return 0;
+}
+
+// Returns the number of failed checks
+static int TestBallistic(void) {
+    FlightParams params = GetDefaultFlightParams();
+    params.liftZero = params.liftSlope = params.maxLift = 0.0f;
+    params.dragZero = params.inducedDrag = params.sideForce = 0.0f;
+
+    FlightBodies bodies;
+    InitFlightBodies(&bodies, params, NULL);
+    int body = AddFlightBody(&bodies, (Vector3){ 0.0f, FLIGHTTEST_ALTITUDE, 0.0f }, (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f }, FLIGHTTEST_SPEED);
+    SetFlightControls(&bodies, body, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    int steps = (int)lrintf(FLIGHTTEST_SECONDS / FLIGHT_FIXED_STEP);
+    float startEnergy = GetFlightEnergy(&bodies, body);
+    for (int step = 0; step < steps; step++) StepFlightBodies(&bodies, FLIGHT_FIXED_STEP);
+
+    float change = GetFlightEnergy(&bodies, body) - startEnergy;
+    float expected = -0.5f * FLIGHT_GRAVITY * FLIGHT_GRAVITY * FLIGHT_FIXED_STEP * FLIGHT_FIXED_STEP * steps;
+    float heightUlp = nextafterf(FLIGHTTEST_ALTITUDE, INFINITY) - FLIGHTTEST_ALTITUDE;
+    float tolerance = 0.5f * heightUlp * FLIGHT_GRAVITY * steps;
+    bool failed = fabsf(change - expected) > tolerance;
+
+    printf("Ballistic, %d steps: energy changed %.4f J/kg of %.1f, integrator bias %.4f, tolerance %.4f\n",
+           steps, change, startEnergy, expected, tolerance);
+    if (failed) printf("  FAILED: energy drifted beyond the integrator bias\n");
+
+    UnloadFlightBodies(&bodies);
+    return failed;
+}
+
+// Returns the number of failed checks
+static int TestGlide(void) {
+    FlightBodies bodies;
+    InitFlightBodies(&bodies, GetDefaultFlightParams(), NULL);
+    int body = AddFlightBody(&bodies, (Vector3){ 0.0f, FLIGHTTEST_ALTITUDE, 0.0f }, (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f }, FLIGHTTEST_SPEED);
+    SetFlightControls(&bodies, body, 0.0f, 0.0f, 0.0f, 0.0f);
+
+    int steps = (int)lrintf(FLIGHTTEST_SECONDS / FLIGHT_FIXED_STEP);
+    float startEnergy = GetFlightEnergy(&bodies, body);
+    float energy = startEnergy;
+    float worstRise = 0.0f;
+    double work = 0.0;
+
+    for (int step = 0; step < steps; step++) {
+        // Trapezoid of the aerodynamic power over the step
+        float power = GetAerodynamicPower(&bodies, body);
+        StepFlightBodies(&bodies, FLIGHT_FIXED_STEP);
+        power = 0.5f * (power + GetAerodynamicPower(&bodies, body));
+        work += power * FLIGHT_FIXED_STEP - 0.5 * FLIGHT_GRAVITY * FLIGHT_GRAVITY * FLIGHT_FIXED_STEP * FLIGHT_FIXED_STEP;
+
+        float next = GetFlightEnergy(&bodies, body);
+        if (next - energy > worstRise) worstRise = next - energy;
+        energy = next;
+    }
+
+    Vector3 position = GetFlightPosition(&bodies, body);
+    Vector3 velocity = GetFlightVelocity(&bodies, body);
+    float lost = startEnergy - energy;
+    float workError = fabsf(lost + (float)work) / lost;
+    bool rose = worstRise > FLIGHTTEST_ROUNDING * startEnergy;
+
+    printf("Glide, %d steps: down %.0f units to %.1f units/s sinking %.2f units/s\n",
+           steps, FLIGHTTEST_ALTITUDE - position.y, sqrtf(velocity.x * velocity.x + velocity.z * velocity.z), -velocity.y);
+    printf("  energy lost %.1f J/kg, aerodynamic work %.1f J/kg (%.2f%% off), largest rise in a step %.2g J/kg\n",
+           lost, -work, workError * 100.0f, worstRise);
+    if (rose) printf("  FAILED: energy rose without thrust\n");
+    if (workError > FLIGHTTEST_WORK_ERROR) printf("  FAILED: energy lost does not match the aerodynamic work\n");
+
+    UnloadFlightBodies(&bodies);
+    return rose + (workError > FLIGHTTEST_WORK_ERROR);
+}
+
+// Lift, side force and drag dotted with the velocity, per unit mass, from the same
+// coefficients the model uses
+static float GetAerodynamicPower(const FlightBodies *bodies, int index) {
+    const FlightParams *params = &bodies->params;
+    Vector3 v = GetFlightVelocity(bodies, index);
+    Quaternion q = GetFlightOrientation(bodies, index);
+
+    Vector3 up = { 2.0f * (q.x * q.y - q.w * q.z), 1.0f - 2.0f * (q.x * q.x + q.z * q.z), 2.0f * (q.y * q.z + q.w * q.x) };
+    Vector3 right = { 2.0f * (q.y * q.y + q.z * q.z) - 1.0f, -2.0f * (q.x * q.y + q.w * q.z), -2.0f * (q.x * q.z - q.w * q.y) };
+    float speedSquared = v.x * v.x + v.y * v.y + v.z * v.z;
+    float speed = sqrtf(speedSquared);
+
+    float alpha = -(v.x * up.x + v.y * up.y + v.z * up.z) / speed;
+    float beta = (v.x * right.x + v.y * right.y + v.z * right.z) / speed;
+    float lift = fmaxf(fminf(params->liftZero + params->liftSlope * alpha, params->maxLift), -params->maxLift);
+    float drag = params->dragZero + params->inducedDrag * lift * lift;
+    float dynamic = 0.5f * FLIGHT_AIR_DENSITY * params->wingArea * speedSquared;
+
+    // Lift along the body up axis does work at any angle of attack, side force at any sideslip
+    float power = dynamic * (lift * -alpha * speed - params->sideForce * beta * beta * speed - drag * speed);
+    return power / params->mass;
+}
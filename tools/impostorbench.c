@@ -0,0 +1,178 @@
+// impostorbench.c
+// Draws the same IMPOSTORBENCH_OBJECTS props as meshes, as impostors and split by distance, and
+// compares triangles, draw calls and frame time.
+// Usage: impostorbench [-frames N]
+//
+// Impostors are baked and drawn on the GPU, so this opens a hidden window with vsync off. The props
+// stand on a flat grid cut into tiles like terrain chunks. The mixed pass decides per tile from its
+// closest point, the way DrawTerrain does per chunk. Triangles come from the loaded meshes, draw
+// calls from the instanced batches and the impostor quads per raylib render batch.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "Terrain/Scatter.h"
+#include "Terrain/Terrain.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IMPOSTORBENCH_SIDE          100         // Props per side of the grid
+#define IMPOSTORBENCH_OBJECTS       (IMPOSTORBENCH_SIDE * IMPOSTORBENCH_SIDE)
+#define IMPOSTORBENCH_TILE          10          // Props per side of a tile
+#define IMPOSTORBENCH_TILES         (IMPOSTORBENCH_SIDE / IMPOSTORBENCH_TILE)
+#define IMPOSTORBENCH_SPACING       12.0f       // World units between props, the default scatter cell
+#define IMPOSTORBENCH_FRAMES        300         // Default frames timed per pass
+#define IMPOSTORBENCH_WARMUP        30          // Frames drawn before timing
+#define IMPOSTORBENCH_BATCH_QUADS   8192        // raylib's RL_DEFAULT_BATCH_BUFFER_ELEMENTS, quads per impostor draw call
+
+typedef enum BenchPass { PASS_MESHES = 0, PASS_IMPOSTORS, PASS_MIXED, PASS_COUNT } BenchPass;
+
+static PropScatter scatter;
+static PropInstance tiles[IMPOSTORBENCH_TILES * IMPOSTORBENCH_TILES][IMPOSTORBENCH_TILE * IMPOSTORBENCH_TILE];
+
+static void BuildScene(void);
+static bool IsTileNear(int tile, Vector3 cameraPosition);
+static void DrawPass(BenchPass pass, Camera camera, int *meshProps, int *impostorProps);
+static long GetPropTriangles(PropType type);
+
+int main(int argc, char **argv) {
+    int frames = IMPOSTORBENCH_FRAMES;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-frames") == 0 && i + 1 < argc) frames = atoi(argv[++i]);
+        else {
+            printf("Usage: impostorbench [-frames N]\n");
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_ASPECT_WIDTH, SCREEN_ASPECT_HEIGHT, "impostorbench");
+    InitPropScatter(&scatter, NOISE_SEED, IMPOSTORBENCH_SPACING, TERRAIN_PROP_DENSITY);
+    BuildScene();
+
+    // Low over one corner, looking across the whole grid
+    float extent = IMPOSTORBENCH_SIDE * IMPOSTORBENCH_SPACING;
+    Camera camera = { 0 };
+    camera.position = (Vector3){ -50.0f, 60.0f, -50.0f };
+    camera.target = (Vector3){ 0.5f * extent, 0.0f, 0.5f * extent };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 60.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    const char *names[PASS_COUNT] = { "meshes", "impostors", "mixed" };
+    printf("Impostors, %d props, impostor distance %.0f, %d frames per pass:\n", IMPOSTORBENCH_OBJECTS, TERRAIN_IMPOSTOR_DISTANCE, frames);
+    for (int pass = 0; pass < PASS_COUNT; pass++) {
+        int meshProps = 0, impostorProps = 0;
+        for (int frame = 0; frame < IMPOSTORBENCH_WARMUP; frame++) DrawPass(pass, camera, &meshProps, &impostorProps);
+
+        double start = GetBenchClock();
+        for (int frame = 0; frame < frames; frame++) DrawPass(pass, camera, &meshProps, &impostorProps);
+        double seconds = (GetBenchClock() - start) / frames;
+
+        // One instanced draw per mesh of every prop type with instances, impostors flush per full batch
+        long triangles = 2L * impostorProps;
+        int drawCalls = (impostorProps + IMPOSTORBENCH_BATCH_QUADS - 1) / IMPOSTORBENCH_BATCH_QUADS;
+        for (int type = 0; type < PROP_TYPE_COUNT; type++) {
+            int instances = scatter.transformCounts[type];
+            triangles += instances * GetPropTriangles(type);
+            if (instances > 0) drawCalls += scatter.models[type].meshCount;
+        }
+
+        printf("  %-9s %5d meshes, %5d impostors: %9ld triangles, %3d draw calls, %6.2f ms per frame\n",
+               names[pass], meshProps, impostorProps, triangles, drawCalls, seconds * 1000.0);
+    }
+
+    // What the scene costs with one DrawModel per prop
+    long triangles = 0;
+    int drawCalls = 0;
+    for (int tile = 0; tile < IMPOSTORBENCH_TILES * IMPOSTORBENCH_TILES; tile++) {
+        for (int i = 0; i < IMPOSTORBENCH_TILE * IMPOSTORBENCH_TILE; i++) {
+            triangles += GetPropTriangles(tiles[tile][i].type);
+            drawCalls += scatter.models[tiles[tile][i].type].meshCount;
+        }
+    }
+    printf("  one DrawModel per prop would be %ld triangles in %d draw calls\n", triangles, drawCalls);
+
+    UnloadPropScatter(&scatter);
+    CloseWindow();
+    return 0;
+}
+
+// Mostly trees with some rocks and a few buildings, about the mix the scatter places
+static void BuildScene(void) {
+    unsigned int state = 12345u;
+
+    for (int z = 0; z < IMPOSTORBENCH_SIDE; z++) {
+        for (int x = 0; x < IMPOSTORBENCH_SIDE; x++) {
+            int tile = (z / IMPOSTORBENCH_TILE) * IMPOSTORBENCH_TILES + x / IMPOSTORBENCH_TILE;
+            PropInstance *prop = &tiles[tile][(z % IMPOSTORBENCH_TILE) * IMPOSTORBENCH_TILE + x % IMPOSTORBENCH_TILE];
+
+            state = state * 1664525u + 1013904223u;
+            unsigned int pick = (state >> 8) % 100;
+            prop->type = pick < 70 ? PROP_TREE : (pick < 98 ? PROP_ROCK : (pick == 98 ? PROP_HOUSE : PROP_COTTAGE));
+            prop->x = (x % IMPOSTORBENCH_TILE) * IMPOSTORBENCH_SPACING;
+            prop->y = 0.0f;
+            prop->z = (z % IMPOSTORBENCH_TILE) * IMPOSTORBENCH_SPACING;
+            prop->yaw = (unsigned char)(state >> 24);
+            prop->scale = 64;
+            prop->reserved = 0;
+        }
+    }
+}
+
+// Closest point of the tile to the camera, like the per-chunk switch in DrawTerrain
+static bool IsTileNear(int tile, Vector3 cameraPosition) {
+    float tileSize = IMPOSTORBENCH_TILE * IMPOSTORBENCH_SPACING;
+    float minX = (tile % IMPOSTORBENCH_TILES) * tileSize;
+    float minZ = (tile / IMPOSTORBENCH_TILES) * tileSize;
+    float dx = fmaxf(fmaxf(minX - cameraPosition.x, 0.0f), cameraPosition.x - (minX + tileSize));
+    float dz = fmaxf(fmaxf(minZ - cameraPosition.z, 0.0f), cameraPosition.z - (minZ + tileSize));
+    return dx * dx + dz * dz < TERRAIN_IMPOSTOR_DISTANCE * TERRAIN_IMPOSTOR_DISTANCE;
+}
+
+// Gathers and draws one frame, the gather is cheap next to the draw and keeps the passes alike
+static void DrawPass(BenchPass pass, Camera camera, int *meshProps, int *impostorProps) {
+    float tileSize = IMPOSTORBENCH_TILE * IMPOSTORBENCH_SPACING;
+    int tileProps = IMPOSTORBENCH_TILE * IMPOSTORBENCH_TILE;
+    *meshProps = *impostorProps = 0;
+
+    ClearPropBatches(&scatter);
+    for (int tile = 0; tile < IMPOSTORBENCH_TILES * IMPOSTORBENCH_TILES; tile++) {
+        bool near = pass == PASS_MESHES || (pass == PASS_MIXED && IsTileNear(tile, camera.position));
+        if (!near) continue;
+
+        Vector3 origin = { (tile % IMPOSTORBENCH_TILES) * tileSize, 0.0f, (tile / IMPOSTORBENCH_TILES) * tileSize };
+        AppendPropBatch(&scatter, tiles[tile], tileProps, origin);
+        *meshProps += tileProps;
+    }
+
+    BeginDrawing();
+    ClearBackground(SKYBLUE);
+    BeginMode3D(camera);
+
+    DrawPropBatches(&scatter);
+
+    BeginImpostors(&scatter.impostors, camera.position, WHITE);
+    for (int tile = 0; tile < IMPOSTORBENCH_TILES * IMPOSTORBENCH_TILES; tile++) {
+        bool near = pass == PASS_MESHES || (pass == PASS_MIXED && IsTileNear(tile, camera.position));
+        if (near) continue;
+
+        Vector3 origin = { (tile % IMPOSTORBENCH_TILES) * tileSize, 0.0f, (tile / IMPOSTORBENCH_TILES) * tileSize };
+        DrawPropImpostors(&scatter, tiles[tile], tileProps, origin);
+        *impostorProps += tileProps;
+    }
+    EndImpostors(&scatter.impostors);
+
+    EndMode3D();
+    EndDrawing();
+}
+
+static long GetPropTriangles(PropType type) {
+    const Model *model = &scatter.models[type];
+    long triangles = 0;
+
+    for (int m = 0; m < model->meshCount; m++) triangles += model->meshes[m].triangleCount;
+
+    return triangles;
+}
@@ -0,0 +1,210 @@
+// jobstress.c
+// Stress test and scaling benchmark of the job system, exits non-zero if any job was lost.
+// Usage: jobstress [-rounds N] [-threads N]
+//
+// Each round runs JOBSTRESS_CHAINS chains at once. A chain is JOBSTRESS_STAGES stages of
+// JOBSTRESS_FANOUT jobs, and each stage is submitted by the continuation of the one before it,
+// so the only thing ordering the stages is the counters. Every job checks the whole previous
+// stage ran before it, and the round checks every job ran exactly once. Nested ParallelFor calls
+// from inside jobs are checked the same way, every index visited once.
+//
+// The benchmark then times a ParallelFor over fixed per-item work with 1 to JOB_MAX_WORKERS threads.
+#include "BenchClock.h"
+#include "JobSystem.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define JOBSTRESS_ROUNDS    50      // Default rounds of the stress test
+#define JOBSTRESS_THREADS   8       // Default threads of the stress test, more than cores on purpose
+#define JOBSTRESS_CHAINS    16      // Chains running at once
+#define JOBSTRESS_STAGES    32      // Stages per chain, each started by a continuation
+#define JOBSTRESS_FANOUT    64      // Jobs per stage
+#define JOBSTRESS_NESTED    4096    // Indices of each nested ParallelFor
+#define BENCH_ITEMS         (1 << 16)
+#define BENCH_WORK          400     // Inner iterations per item
+#define BENCH_REPEATS       5       // Best of
+
+typedef struct StressChain {
+    JobSystem *system;
+    JobCounter *done;                       // Held open by the chain until its last stage finished
+    JobCounter counters[JOBSTRESS_STAGES];
+    int ran[JOBSTRESS_STAGES];              // Jobs of each stage that ran, only touched atomically
+    int stage;                              // Next stage to submit, only touched by continuations
+    int outOfOrder;                         // Jobs that started before their previous stage finished
+} StressChain;
+
+typedef struct StressJob {
+    StressChain *chain;
+    int stage;
+} StressJob;
+
+typedef struct NestedTask {
+    JobSystem *system;
+    unsigned char visits[JOBSTRESS_NESTED];
+} NestedTask;
+
+// Jobs are static, the data of every job of every chain stays valid for the whole round
+static JobSystem jobs;
+static StressChain chains[JOBSTRESS_CHAINS];
+static StressJob stressJobs[JOBSTRESS_CHAINS][JOBSTRESS_STAGES][JOBSTRESS_FANOUT];
+static NestedTask nested[JOBSTRESS_CHAINS];
+static float benchOutput[BENCH_ITEMS];
+
+static void SubmitStage(void *data);
+static void RunStressJob(void *data);
+static void VisitNested(void *data, int begin, int end);
+static void RunNested(void *data);
+static int RunStressRound(int threadCount);
+static void WorkRange(void *data, int begin, int end);
+static double TimeParallelFor(int threadCount);
+
+int main(int argc, char **argv) {
+    int rounds = JOBSTRESS_ROUNDS;
+    int threads = JOBSTRESS_THREADS;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-rounds") == 0 && i + 1 < argc) rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else {
+            printf("Usage: jobstress [-rounds N] [-threads N]\n");
+            return 1;
+        }
+    }
+
+    int failures = 0;
+    double start = GetBenchClock();
+    InitJobSystem(&jobs, threads);
+    for (int round = 0; round < rounds; round++) failures += RunStressRound(threads);
+    UnloadJobSystem(&jobs);
+
+    // One thread runs continuations inline from the submitting job, so check it separately
+    InitJobSystem(&jobs, 1);
+    failures += RunStressRound(1);
+    UnloadJobSystem(&jobs);
+
+    printf("Stress: %d rounds of %d chains x %d stages x %d jobs on %d threads, %.2f s, %s\n",
+           rounds, JOBSTRESS_CHAINS, JOBSTRESS_STAGES, JOBSTRESS_FANOUT, threads, GetBenchClock() - start,
+           failures ? "FAILED" : "every job ran once, in stage order");
+
+    printf("Scaling: ParallelFor over %d items of %d iterations, best of %d\n", BENCH_ITEMS, BENCH_WORK, BENCH_REPEATS);
+    double single = 0.0;
+    for (int threadCount = 1; threadCount <= JOB_MAX_WORKERS; threadCount *= 2) {
+        double seconds = TimeParallelFor(threadCount);
+        if (threadCount == 1) single = seconds;
+        printf("  %2d threads: %8.2f ms, speedup %.2fx\n", threadCount, seconds * 1000.0, single / seconds);
+    }
+
+    return failures ? 1 : 0;
+}
+
+// Continuation of a stage: submits the next one, or ends the chain
+static void SubmitStage(void *data) {
+    StressChain *chain = (StressChain *)data;
+    int stage = chain->stage++;
+    if (stage == JOBSTRESS_STAGES) return;
+
+    Job group[JOBSTRESS_FANOUT];
+    for (int i = 0; i < JOBSTRESS_FANOUT; i++) {
+        stressJobs[chain - chains][stage][i] = (StressJob){ chain, stage };
+        group[i] = (Job){ RunStressJob, &stressJobs[chain - chains][stage][i], NULL, JOB_ANY_THREAD };
+    }
+
+    // The continuation is set before the stage is submitted, as SetJobContinuation requires
+    SetJobContinuation(&chain->counters[stage], (Job){ SubmitStage, chain, chain->done, JOB_ANY_THREAD });
+    RunJobs(chain->system, group, JOBSTRESS_FANOUT, &chain->counters[stage]);
+}
+
+static void RunStressJob(void *data) {
+    StressJob *job = (StressJob *)data;
+    StressChain *chain = job->chain;
+
+    if (job->stage > 0 && __atomic_load_n(&chain->ran[job->stage - 1], __ATOMIC_ACQUIRE) != JOBSTRESS_FANOUT) {
+        __atomic_add_fetch(&chain->outOfOrder, 1, __ATOMIC_SEQ_CST);
+    }
+    __atomic_add_fetch(&chain->ran[job->stage], 1, __ATOMIC_ACQ_REL);
+}
+
+static void VisitNested(void *data, int begin, int end) {
+    NestedTask *task = (NestedTask *)data;
+    for (int i = begin; i < end; i++) task->visits[i]++;
+}
+
+// A ParallelFor from inside a job, so waiting runs other jobs on a worker thread
+static void RunNested(void *data) {
+    NestedTask *task = (NestedTask *)data;
+    ParallelFor(task->system, JOBSTRESS_NESTED, 64, VisitNested, task);
+}
+
+// Returns the number of failed checks
+static int RunStressRound(int threadCount) {
+    JobCounter done = { 0 };
+    memset(chains, 0, sizeof(chains));
+    memset(nested, 0, sizeof(nested));
+
+    Job starts[JOBSTRESS_CHAINS * 2];
+    for (int i = 0; i < JOBSTRESS_CHAINS; i++) {
+        chains[i].system = &jobs;
+        chains[i].done = &done;
+        nested[i].system = &jobs;
+        starts[2 * i] = (Job){ SubmitStage, &chains[i], NULL, JOB_ANY_THREAD };
+        starts[2 * i + 1] = (Job){ RunNested, &nested[i], NULL, JOB_ANY_THREAD };
+    }
+    RunJobs(&jobs, starts, JOBSTRESS_CHAINS * 2, &done);
+    WaitForCounter(&jobs, &done);
+
+    int failures = 0;
+    for (int i = 0; i < JOBSTRESS_CHAINS; i++) {
+        for (int stage = 0; stage < JOBSTRESS_STAGES; stage++) {
+            if (chains[i].ran[stage] != JOBSTRESS_FANOUT) {
+                printf("Chain %d stage %d: %d of %d jobs ran (%d threads)\n", i, stage, chains[i].ran[stage], JOBSTRESS_FANOUT, threadCount);
+                failures++;
+            }
+            if (!IsCounterDone(&chains[i].counters[stage])) {
+                printf("Chain %d stage %d: counter left at %d\n", i, stage, chains[i].counters[stage].value);
+                failures++;
+            }
+        }
+        if (chains[i].stage != JOBSTRESS_STAGES + 1) {
+            printf("Chain %d: %d of %d continuations ran\n", i, chains[i].stage, JOBSTRESS_STAGES + 1);
+            failures++;
+        }
+        if (chains[i].outOfOrder) {
+            printf("Chain %d: %d jobs started before their previous stage finished\n", i, chains[i].outOfOrder);
+            failures++;
+        }
+        for (int k = 0; k < JOBSTRESS_NESTED; k++) {
+            if (nested[i].visits[k] != 1) {
+                printf("Nested %d: index %d visited %d times\n", i, k, nested[i].visits[k]);
+                failures++;
+                break;
+            }
+        }
+    }
+    return failures;
+}
+
+static void WorkRange(void *data, int begin, int end) {
+    float *output = (float *)data;
+    for (int i = begin; i < end; i++) {
+        float x = (float)i * 0.001f, sum = 0.0f;
+        for (int k = 0; k < BENCH_WORK; k++) {
+            sum += sinf(x + (float)k * 0.01f);
+        }
+        output[i] = sum;
+    }
+}
+
+static double TimeParallelFor(int threadCount) {
+    double best = 1e9;
+    InitJobSystem(&jobs, threadCount);
+    for (int repeat = 0; repeat < BENCH_REPEATS; repeat++) {
+        double start = GetBenchClock();
+        ParallelFor(&jobs, BENCH_ITEMS, 256, WorkRange, benchOutput);
+        double seconds = GetBenchClock() - start;
+        if (seconds < best) best = seconds;
+    }
+    UnloadJobSystem(&jobs);
+    return best;
+}
@@ -0,0 +1,145 @@
+// loadbench.c
+// Time to first frame and time to fully loaded for the plane's model and texture, loaded before
+// the first frame as the game used to and through the background AssetLoader.
+// Usage: loadbench [-repeats N]
+//
+// Both ways start once the window and job system are up and load the same baked files with the
+// same fallbacks. The blocking way loads everything, then draws its first frame, so both times
+// are the same. The loader way draws from the first frame with placeholders and counts frames
+// until nothing is pending. Cold runs drop every file from the OS page cache first (Linux only,
+// elsewhere they are skipped), warm runs report the best of the repeats. Frames are not capped.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "AssetLoader.h"
+#include "BakedModel.h"
+#include "BakedTexture.h"
+#include "JobSystem.h"
+#include "game.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOADBENCH_REPEATS   5       // Default warm runs per way, the fastest is reported
+
+typedef struct LoadTimes {
+    double firstFrame;      // Seconds from the start of loading to the end of the first frame
+    double loaded;          // Seconds until every asset was in use
+    int frames;             // Frames drawn until then
+} LoadTimes;
+
+static JobSystem jobs;
+static AssetLoader loader;
+
+static const char *files[] = { PLANE_MODEL_BAKED, PLANE_MODEL, PLANE_TEXTURE_BAKED, PLANE_TEXTURE };
+
+static bool DropPlaneFiles(void);
+static LoadTimes LoadBlocking(void);
+static LoadTimes LoadInBackground(void);
+static void DrawPlaneFrame(Model model, Texture2D texture);
+
+int main(int argc, char **argv) {
+    int repeats = LOADBENCH_REPEATS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-repeats") == 0 && i + 1 < argc) repeats = atoi(argv[++i]);
+        else repeats = 0;
+    }
+    if (repeats < 1) {
+        printf("Usage: loadbench [-repeats N]\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "loadbench");
+    InitJobSystem(&jobs, JOB_THREADS);
+
+    const char *names[2] = { "blocking", "AssetLoader" };
+    printf("Plane model and texture, %d threads:\n", JOB_THREADS);
+    for (int way = 0; way < 2; way++) {
+        LoadTimes cold = { -1.0, -1.0, 0 };
+        if (DropPlaneFiles()) cold = way == 0 ? LoadBlocking() : LoadInBackground();
+
+        LoadTimes warm = { INFINITY, INFINITY, 0 };
+        for (int repeat = 0; repeat < repeats; repeat++) {
+            LoadTimes times = way == 0 ? LoadBlocking() : LoadInBackground();
+            if (times.loaded < warm.loaded) warm = times;
+        }
+
+        if (cold.loaded >= 0.0) {
+            printf("  %-11s cold: first frame %8.2f ms, fully loaded %8.2f ms after %3d frames\n",
+                   names[way], cold.firstFrame * 1000.0, cold.loaded * 1000.0, cold.frames);
+        }
+        printf("  %-11s warm: first frame %8.2f ms, fully loaded %8.2f ms after %3d frames\n",
+               names[way], warm.firstFrame * 1000.0, warm.loaded * 1000.0, warm.frames);
+    }
+
+    UnloadJobSystem(&jobs);
+    CloseWindow();
+    return 0;
+}
+
+// False when the platform cannot drop them, missing fallbacks do not count
+static bool DropPlaneFiles(void) {
+    bool dropped = false;
+    for (int i = 0; i < (int)(sizeof(files) / sizeof(files[0])); i++) dropped = DropBenchFileCache(files[i]) || dropped;
+    return dropped;
+}
+
+// What LoadModels did before the loader: everything on the GL thread, then the first frame
+static LoadTimes LoadBlocking(void) {
+    double start = GetBenchClock();
+
+    Model model = LoadBakedModel(PLANE_MODEL_BAKED);
+    if (model.meshCount == 0) model = LoadModel(PLANE_MODEL);
+    BakedTexture baked = LoadBakedTexture(PLANE_TEXTURE_BAKED);
+    Texture2D texture = baked.texture.id != 0 ? baked.texture : LoadTexture(PLANE_TEXTURE);
+
+    DrawPlaneFrame(model, texture);
+    LoadTimes times = { GetBenchClock() - start, 0.0, 1 };
+    times.loaded = times.firstFrame;
+
+    UnloadModel(model);
+    if (baked.texture.id != 0) UnloadBakedTexture(baked);
+    else UnloadTexture(texture);
+    return times;
+}
+
+// The game's loop: update the loader, draw with whatever is ready, until nothing is pending
+static LoadTimes LoadInBackground(void) {
+    double start = GetBenchClock();
+    LoadTimes times = { 0.0, 0.0, 0 };
+
+    memset(&loader, 0, sizeof(loader));
+    InitAssetLoader(&loader, &jobs);
+    int model = RequestModel(&loader, PLANE_MODEL_BAKED, PLANE_MODEL);
+    int texture = RequestTexture(&loader, PLANE_TEXTURE_BAKED, PLANE_TEXTURE);
+
+    do {
+        UpdateAssetLoader(&loader);
+        DrawPlaneFrame(GetAssetModel(&loader, model), GetAssetTexture(&loader, texture));
+        if (times.frames++ == 0) times.firstFrame = GetBenchClock() - start;
+    } while (!IsAssetLoaderDone(&loader));
+    times.loaded = GetBenchClock() - start;
+
+    UnloadAssetLoader(&loader);
+    return times;
+}
+
+static void DrawPlaneFrame(Model model, Texture2D texture) {
+    Camera camera = { 0 };
+    camera.position = (Vector3){ CAMERA_INITIAL_POSITION_X, CAMERA_INITIAL_POSITION_Y, CAMERA_INITIAL_POSITION_Z };
+    camera.target = (Vector3){ PLANE_INITIAL_POSITION_X, PLANE_INITIAL_POSITION_Y, PLANE_INITIAL_POSITION_Z };
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = CAMERA_FOVY;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    for (int i = 0; i < model.materialCount; i++) model.materials[i].maps[MATERIAL_MAP_DIFFUSE].texture = texture;
+
+    BeginDrawing();
+    ClearBackground(SKYBLUE);
+    BeginMode3D(camera);
+    DrawModel(model, camera.target, PLANE_INITIAL_SCALE, WHITE);
+    EndMode3D();
+    EndDrawing();
+}
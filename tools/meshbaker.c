@@ -0,0 +1,463 @@
+// meshbaker.c
+// Offline converter from Wavefront OBJ to the baked .fmesh format read by LoadBakedModel.
+// Usage: meshbaker <input.obj> <output.fmesh>
+//
+// Faces are triangulated as fans, (position, texcoord, normal) triples are deduplicated
+// into 16-bit indexed meshes, and a new mesh starts at every material change or when a
+// mesh reaches MESH_FILE_MAX_VERTICES. Texture coordinates get V flipped like raylib's
+// OBJ loader, so baked and parsed models render identically.
+#include "MeshFormat.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BAKER_MAX_MATERIALS 64
+#define BAKER_NAME_SIZE 64
+#define BAKER_HASH_SIZE (1 << 17)   // Slots in the vertex dedup table, twice the mesh vertex limit
+
+typedef struct FloatArray {
+    float *data;
+    int count;      // Floats used
+    int capacity;   // Floats allocated
+} FloatArray;
+
+typedef struct BakerMaterial {
+    char name[BAKER_NAME_SIZE];
+    MeshFileMaterial file;
+} BakerMaterial;
+
+// One output mesh being assembled
+typedef struct BakerMesh {
+    int material;
+    FloatArray positions;
+    FloatArray texcoords;
+    FloatArray normals;
+    uint16_t *indices;
+    int indexCount;
+    int indexCapacity;
+    bool *generatedNormal;          // Vertex had no vn, its normal accumulates face normals
+    int generatedCapacity;
+} BakerMesh;
+
+typedef struct Baker {
+    FloatArray positions;           // OBJ v
+    FloatArray texcoords;           // OBJ vt
+    FloatArray normals;             // OBJ vn
+    BakerMaterial materials[BAKER_MAX_MATERIALS];
+    int materialCount;
+    BakerMesh *meshes;
+    int meshCount;
+    int meshCapacity;
+    int current;                    // Mesh receiving faces, -1 before the first face
+    int currentMaterial;            // Material selected by the last usemtl
+    int hashKeys[BAKER_HASH_SIZE][3];   // OBJ index triple per slot
+    int hashValues[BAKER_HASH_SIZE];    // Vertex index in the current mesh, -1 when empty
+} Baker;
+
+static void PushFloats(FloatArray *array, const float *values, int count);
+static char *ReadWholeFile(const char *fileName);
+static void GetDirectory(const char *fileName, char *directory, int size);
+static void LoadMaterialLibrary(Baker *baker, const char *fileName);
+static int FindMaterial(Baker *baker, const char *name);
+static void BeginMesh(Baker *baker);
+static int AddVertex(Baker *baker, int v, int vt, int vn, const float *faceNormal);
+static void AddFace(Baker *baker, const int (*corners)[3], int cornerCount);
+static bool ParseCorner(const char *token, const Baker *baker, int *corner);
+static void FinishNormals(BakerMesh *mesh);
+static uint32_t AlignOffset(uint32_t offset);
+static bool WriteMeshFile(const Baker *baker, const char *fileName);
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <input.obj> <output.fmesh>\n", argv[0]);
+        return 1;
+    }
+
+    char *text = ReadWholeFile(argv[1]);
+    if (!text) {
+        fprintf(stderr, "meshbaker: cannot read %s\n", argv[1]);
+        return 1;
+    }
+
+    char directory[512];
+    GetDirectory(argv[1], directory, sizeof(directory));
+
+    Baker *baker = (Baker *)calloc(1, sizeof(Baker));
+    baker->current = -1;
+    baker->currentMaterial = -1;
+
+    for (char *line = strtok(text, "\n"); line; line = strtok(NULL, "\n")) {
+        char *end = line + strlen(line);
+        while (end > line && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) *--end = '\0';
+        while (*line == ' ' || *line == '\t') line++;
+
+        float values[3] = { 0.0f, 0.0f, 0.0f };
+        if (strncmp(line, "v ", 2) == 0) {
+            sscanf(line + 2, "%f %f %f", &values[0], &values[1], &values[2]);
+            PushFloats(&baker->positions, values, 3);
+        } else if (strncmp(line, "vt ", 3) == 0) {
+            sscanf(line + 3, "%f %f", &values[0], &values[1]);
+            values[1] = 1.0f - values[1];
+            PushFloats(&baker->texcoords, values, 2);
+        } else if (strncmp(line, "vn ", 3) == 0) {
+            sscanf(line + 3, "%f %f %f", &values[0], &values[1], &values[2]);
+            PushFloats(&baker->normals, values, 3);
+        } else if (strncmp(line, "mtllib ", 7) == 0) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s%s", directory, line + 7);
+            LoadMaterialLibrary(baker, path);
+        } else if (strncmp(line, "usemtl ", 7) == 0) {
+            baker->currentMaterial = FindMaterial(baker, line + 7);
+            baker->current = -1;
+        } else if (strncmp(line, "f ", 2) == 0) {
+            // strtok is busy splitting lines, so walk the corners by hand
+            int corners[64][3];
+            int cornerCount = 0;
+            char *token = line + 2;
+            while (*token && cornerCount < 64) {
+                while (*token == ' ') token++;
+                if (!*token) break;
+                if (!ParseCorner(token, baker, corners[cornerCount])) break;
+                cornerCount++;
+                while (*token && *token != ' ') token++;
+            }
+            if (cornerCount >= 3) AddFace(baker, (const int (*)[3])corners, cornerCount);
+        }
+    }
+
+    for (int i = 0; i < baker->meshCount; i++) FinishNormals(&baker->meshes[i]);
+
+    bool written = baker->meshCount > 0 && WriteMeshFile(baker, argv[2]);
+    if (written) {
+        int triangles = 0, vertices = 0;
+        for (int i = 0; i < baker->meshCount; i++) {
+            triangles += baker->meshes[i].indexCount / 3;
+            vertices += baker->meshes[i].positions.count / 3;
+        }
+        printf("meshbaker: %s -> %s, %d meshes, %d vertices, %d triangles, %d materials\n",
+               argv[1], argv[2], baker->meshCount, vertices, triangles, baker->materialCount);
+    } else {
+        fprintf(stderr, "meshbaker: nothing written to %s\n", argv[2]);
+    }
+
+    free(text);
+    return written ? 0 : 1;
+}
+
+static void PushFloats(FloatArray *array, const float *values, int count) {
+    if (array->count + count > array->capacity) {
+        array->capacity = array->capacity > 0 ? array->capacity * 2 : 1024;
+        while (array->capacity < array->count + count) array->capacity *= 2;
+        array->data = (float *)realloc(array->data, array->capacity * sizeof(float));
+    }
+    memcpy(&array->data[array->count], values, count * sizeof(float));
+    array->count += count;
+}
+
+static char *ReadWholeFile(const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = (char *)malloc(size + 1);
+    size_t read = fread(text, 1, size, file);
+    text[read] = '\0';
+    fclose(file);
+    return text;
+}
+
+// Directory part of a path including the trailing separator, empty for bare names
+static void GetDirectory(const char *fileName, char *directory, int size) {
+    const char *slash = strrchr(fileName, '/');
+    const char *backslash = strrchr(fileName, '\\');
+    if (backslash > slash) slash = backslash;
+
+    int length = slash ? (int)(slash - fileName) + 1 : 0;
+    if (length >= size) length = size - 1;
+    memcpy(directory, fileName, length);
+    directory[length] = '\0';
+}
+
+// Only diffuse colour and texture are carried over, that is all the game's materials use
+static void LoadMaterialLibrary(Baker *baker, const char *fileName) {
+    char *text = ReadWholeFile(fileName);
+    if (!text) {
+        fprintf(stderr, "meshbaker: cannot read material library %s\n", fileName);
+        return;
+    }
+
+    BakerMaterial *material = NULL;
+    char *cursor = text;
+    while (*cursor) {
+        char *line = cursor;
+        char *end = strchr(cursor, '\n');
+        cursor = end ? end + 1 : cursor + strlen(cursor);
+        if (end) *end = '\0';
+
+        end = line + strlen(line);
+        while (end > line && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) *--end = '\0';
+        while (*line == ' ' || *line == '\t') line++;
+
+        if (strncmp(line, "newmtl ", 7) == 0) {
+            int index = FindMaterial(baker, line + 7);
+            material = index >= 0 ? &baker->materials[index] : NULL;
+        } else if (material && strncmp(line, "Kd ", 3) == 0) {
+            float r = 1.0f, g = 1.0f, b = 1.0f;
+            sscanf(line + 3, "%f %f %f", &r, &g, &b);
+            material->file.diffuse[0] = (unsigned char)lrintf(fminf(fmaxf(r, 0.0f), 1.0f) * 255.0f);
+            material->file.diffuse[1] = (unsigned char)lrintf(fminf(fmaxf(g, 0.0f), 1.0f) * 255.0f);
+            material->file.diffuse[2] = (unsigned char)lrintf(fminf(fmaxf(b, 0.0f), 1.0f) * 255.0f);
+        } else if (material && strncmp(line, "map_Kd ", 7) == 0) {
+            // The texture is expected next to the baked file, as it was next to the OBJ
+            const char *name = strrchr(line + 7, ' ');
+            name = name ? name + 1 : line + 7;
+            if (strlen(name) >= MESH_FILE_PATH_SIZE) {
+                fprintf(stderr, "meshbaker: texture path too long, skipped: %s\n", name);
+            } else {
+                strcpy(material->file.diffuseMap, name);
+            }
+        }
+    }
+
+    free(text);
+}
+
+// Returns the material with this name, adding a white one if it is new
+static int FindMaterial(Baker *baker, const char *name) {
+    for (int i = 0; i < baker->materialCount; i++) {
+        if (strcmp(baker->materials[i].name, name) == 0) return i;
+    }
+    if (baker->materialCount == BAKER_MAX_MATERIALS) {
+        fprintf(stderr, "meshbaker: more than %d materials, %s uses the first one\n", BAKER_MAX_MATERIALS, name);
+        return 0;
+    }
+
+    BakerMaterial *material = &baker->materials[baker->materialCount];
+    memset(material, 0, sizeof(*material));
+    snprintf(material->name, BAKER_NAME_SIZE, "%s", name);
+    memset(material->file.diffuse, 255, sizeof(material->file.diffuse));
+    return baker->materialCount++;
+}
+
+static void BeginMesh(Baker *baker) {
+    if (baker->meshCount == baker->meshCapacity) {
+        baker->meshCapacity = baker->meshCapacity > 0 ? baker->meshCapacity * 2 : 8;
+        baker->meshes = (BakerMesh *)realloc(baker->meshes, baker->meshCapacity * sizeof(BakerMesh));
+    }
+
+    // Faces before any usemtl get a default material
+    if (baker->currentMaterial < 0) baker->currentMaterial = FindMaterial(baker, "default");
+
+    BakerMesh *mesh = &baker->meshes[baker->meshCount];
+    memset(mesh, 0, sizeof(*mesh));
+    mesh->material = baker->currentMaterial;
+    baker->current = baker->meshCount++;
+
+    for (int i = 0; i < BAKER_HASH_SIZE; i++) baker->hashValues[i] = -1;
+}
+
+static int AddVertex(Baker *baker, int v, int vt, int vn, const float *faceNormal) {
+    BakerMesh *mesh = &baker->meshes[baker->current];
+
+    unsigned int hash = ((unsigned int)v * 73856093u) ^ ((unsigned int)vt * 19349663u) ^ ((unsigned int)vn * 83492791u);
+    unsigned int slot = hash & (BAKER_HASH_SIZE - 1);
+    while (baker->hashValues[slot] >= 0) {
+        if (baker->hashKeys[slot][0] == v && baker->hashKeys[slot][1] == vt && baker->hashKeys[slot][2] == vn) {
+            int index = baker->hashValues[slot];
+
+            // Shared vertices without an OBJ normal get a smooth average of their faces
+            if (vn < 0) {
+                for (int c = 0; c < 3; c++) mesh->normals.data[index * 3 + c] += faceNormal[c];
+            }
+            return index;
+        }
+        slot = (slot + 1) & (BAKER_HASH_SIZE - 1);
+    }
+
+    int index = mesh->positions.count / 3;
+    baker->hashKeys[slot][0] = v;
+    baker->hashKeys[slot][1] = vt;
+    baker->hashKeys[slot][2] = vn;
+    baker->hashValues[slot] = index;
+
+    float zero[2] = { 0.0f, 0.0f };
+    PushFloats(&mesh->positions, &baker->positions.data[v * 3], 3);
+    PushFloats(&mesh->texcoords, vt >= 0 ? &baker->texcoords.data[vt * 2] : zero, 2);
+    PushFloats(&mesh->normals, vn >= 0 ? &baker->normals.data[vn * 3] : faceNormal, 3);
+
+    if (index >= mesh->generatedCapacity) {
+        mesh->generatedCapacity = mesh->generatedCapacity > 0 ? mesh->generatedCapacity * 2 : 1024;
+        mesh->generatedNormal = (bool *)realloc(mesh->generatedNormal, mesh->generatedCapacity * sizeof(bool));
+    }
+    mesh->generatedNormal[index] = vn < 0;
+
+    return index;
+}
+
+static void AddFace(Baker *baker, const int (*corners)[3], int cornerCount) {
+    // Newell's method, robust for the non-planar polygons some exporters write
+    float faceNormal[3] = { 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < cornerCount; i++) {
+        const float *a = &baker->positions.data[corners[i][0] * 3];
+        const float *b = &baker->positions.data[corners[(i + 1) % cornerCount][0] * 3];
+        faceNormal[0] += (a[1] - b[1]) * (a[2] + b[2]);
+        faceNormal[1] += (a[2] - b[2]) * (a[0] + b[0]);
+        faceNormal[2] += (a[0] - b[0]) * (a[1] + b[1]);
+    }
+
+    for (int i = 1; i + 1 < cornerCount; i++) {
+        // Start a new mesh if this triangle could overflow 16-bit indices
+        if (baker->current < 0 || baker->meshes[baker->current].positions.count / 3 + 3 > MESH_FILE_MAX_VERTICES) {
+            BeginMesh(baker);
+        }
+
+        int triangle[3] = { 0, i, i + 1 };
+        BakerMesh *mesh = &baker->meshes[baker->current];
+        if (mesh->indexCount + 3 > mesh->indexCapacity) {
+            mesh->indexCapacity = mesh->indexCapacity > 0 ? mesh->indexCapacity * 2 : 3072;
+            mesh->indices = (uint16_t *)realloc(mesh->indices, mesh->indexCapacity * sizeof(uint16_t));
+        }
+        for (int c = 0; c < 3; c++) {
+            const int *corner = corners[triangle[c]];
+            int index = AddVertex(baker, corner[0], corner[1], corner[2], faceNormal);
+            baker->meshes[baker->current].indices[baker->meshes[baker->current].indexCount++] = (uint16_t)index;
+        }
+    }
+}
+
+// "v", "v/vt", "v//vn" or "v/vt/vn", 1-based or negative (relative), stored 0-based with -1 for absent
+static bool ParseCorner(const char *token, const Baker *baker, int *corner) {
+    int counts[3] = { baker->positions.count / 3, baker->texcoords.count / 2, baker->normals.count / 3 };
+
+    for (int part = 0; part < 3; part++) {
+        corner[part] = -1;
+        if (part > 0) {
+            if (*token != '/') continue;
+            token++;
+        }
+        if (*token == '/' || *token == ' ' || *token == '\0') continue;
+
+        char *end;
+        long value = strtol(token, &end, 10);
+        token = end;
+
+        long index = value < 0 ? counts[part] + value : value - 1;
+        if (index < 0 || index >= counts[part]) return false;
+        corner[part] = (int)index;
+    }
+
+    return corner[0] >= 0;
+}
+
+static void FinishNormals(BakerMesh *mesh) {
+    int vertexCount = mesh->positions.count / 3;
+    for (int i = 0; i < vertexCount; i++) {
+        float *n = &mesh->normals.data[i * 3];
+        if (!mesh->generatedNormal[i]) continue;
+
+        float length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length > 0.0f) {
+            n[0] /= length;
+            n[1] /= length;
+            n[2] /= length;
+        } else {
+            n[1] = 1.0f;
+        }
+    }
+}
+
+static uint32_t AlignOffset(uint32_t offset) {
+    return (offset + MESH_FILE_ALIGNMENT - 1) & ~(uint32_t)(MESH_FILE_ALIGNMENT - 1);
+}
+
+static bool WriteMeshFile(const Baker *baker, const char *fileName) {
+    MeshFileHeader header = { 0 };
+    header.magic = MESH_FILE_MAGIC;
+    header.version = MESH_FILE_VERSION;
+    header.meshCount = (uint32_t)baker->meshCount;
+    header.materialCount = (uint32_t)baker->materialCount;
+
+    MeshFileMesh *entries = (MeshFileMesh *)calloc(baker->meshCount, sizeof(MeshFileMesh));
+    uint32_t offset = sizeof(MeshFileHeader) + header.materialCount * sizeof(MeshFileMaterial) + header.meshCount * sizeof(MeshFileMesh);
+
+    for (int c = 0; c < 3; c++) {
+        header.boundsMin[c] = INFINITY;
+        header.boundsMax[c] = -INFINITY;
+    }
+
+    for (int i = 0; i < baker->meshCount; i++) {
+        const BakerMesh *mesh = &baker->meshes[i];
+        MeshFileMesh *entry = &entries[i];
+        entry->vertexCount = (uint32_t)(mesh->positions.count / 3);
+        entry->indexCount = (uint32_t)mesh->indexCount;
+        entry->material = (uint32_t)mesh->material;
+
+        offset = AlignOffset(offset);
+        entry->positionsOffset = offset;
+        offset += entry->vertexCount * 3 * sizeof(float);
+        offset = AlignOffset(offset);
+        entry->texcoordsOffset = offset;
+        offset += entry->vertexCount * 2 * sizeof(float);
+        offset = AlignOffset(offset);
+        entry->normalsOffset = offset;
+        offset += entry->vertexCount * 3 * sizeof(float);
+        offset = AlignOffset(offset);
+        entry->indicesOffset = offset;
+        offset += entry->indexCount * sizeof(uint16_t);
+
+        for (int c = 0; c < 3; c++) {
+            entry->boundsMin[c] = INFINITY;
+            entry->boundsMax[c] = -INFINITY;
+        }
+        for (uint32_t v = 0; v < entry->vertexCount; v++) {
+            for (int c = 0; c < 3; c++) {
+                entry->boundsMin[c] = fminf(entry->boundsMin[c], mesh->positions.data[v * 3 + c]);
+                entry->boundsMax[c] = fmaxf(entry->boundsMax[c], mesh->positions.data[v * 3 + c]);
+            }
+        }
+        for (int c = 0; c < 3; c++) {
+            header.boundsMin[c] = fminf(header.boundsMin[c], entry->boundsMin[c]);
+            header.boundsMax[c] = fmaxf(header.boundsMax[c], entry->boundsMax[c]);
+        }
+    }
+
+    FILE *file = fopen(fileName, "wb");
+    if (!file) {
+        free(entries);
+        return false;
+    }
+
+    fwrite(&header, sizeof(header), 1, file);
+    for (int i = 0; i < baker->materialCount; i++) {
+        fwrite(&baker->materials[i].file, sizeof(MeshFileMaterial), 1, file);
+    }
+    fwrite(entries, sizeof(MeshFileMesh), baker->meshCount, file);
+
+    // Streams in the same order as the offsets above, padding up to each one
+    static const unsigned char padding[MESH_FILE_ALIGNMENT] = { 0 };
+    long position = ftell(file);
+    for (int i = 0; i < baker->meshCount; i++) {
+        const BakerMesh *mesh = &baker->meshes[i];
+        const MeshFileMesh *entry = &entries[i];
+        const void *streams[4] = { mesh->positions.data, mesh->texcoords.data, mesh->normals.data, mesh->indices };
+        uint32_t offsets[4] = { entry->positionsOffset, entry->texcoordsOffset, entry->normalsOffset, entry->indicesOffset };
+        size_t sizes[4] = { entry->vertexCount * 3 * sizeof(float), entry->vertexCount * 2 * sizeof(float),
+                            entry->vertexCount * 3 * sizeof(float), entry->indexCount * sizeof(uint16_t) };
+
+        for (int s = 0; s < 4; s++) {
+            fwrite(padding, 1, offsets[s] - position, file);
+            fwrite(streams[s], 1, sizes[s], file);
+            position = offsets[s] + sizes[s];
+        }
+    }
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    free(entries);
+    return ok;
+}
@@ -0,0 +1,102 @@
+// meshbench.c
+// Load time of OBJ models against their baked .fmesh files, cold and warm.
+// Usage: meshbench [-repeats N] [model.obj model.fmesh]...
+//
+// Defaults to the plane, PLANE_MODEL against PLANE_MODEL_BAKED. Every pair is loaded three ways:
+// LoadModel on the OBJ, which parses the text and uploads; MapBakedModel with every page touched,
+// the part of a baked load that needs no GL; and LoadBakedModel, map and upload. Cold runs drop
+// the file from the OS page cache first (Linux only, elsewhere they are skipped). Warm runs
+// report the best of the repeats. Uploads need GL, so this opens a hidden window.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "BakedModel.h"
+#include "game.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MESHBENCH_REPEATS   5       // Default warm loads per way, the fastest is reported
+
+typedef enum LoadWay { LOAD_OBJ = 0, LOAD_MAP, LOAD_BAKED, LOAD_WAY_COUNT } LoadWay;
+
+static double TimeLoad(LoadWay way, const char *fileName, int *triangles);
+
+int main(int argc, char **argv) {
+    int repeats = MESHBENCH_REPEATS;
+    const char *defaults[2] = { PLANE_MODEL, PLANE_MODEL_BAKED };
+    const char **files = defaults;
+    int fileCount = 2;
+
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-repeats") == 0) {
+        repeats = atoi(argv[2]);
+        first = 3;
+    }
+    if (argc > first) {
+        files = (const char **)(argv + first);
+        fileCount = argc - first;
+    }
+    if (repeats < 1 || fileCount % 2 != 0) {
+        printf("Usage: meshbench [-repeats N] [model.obj model.fmesh]...\n");
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "meshbench");
+
+    const char *names[LOAD_WAY_COUNT] = { "LoadModel", "MapBakedModel", "LoadBakedModel" };
+    for (int pair = 0; pair < fileCount; pair += 2) {
+        printf("%s against %s:\n", files[pair], files[pair + 1]);
+
+        for (int way = 0; way < LOAD_WAY_COUNT; way++) {
+            const char *fileName = way == LOAD_OBJ ? files[pair] : files[pair + 1];
+            int triangles = 0;
+
+            double cold = -1.0;
+            if (DropBenchFileCache(fileName)) cold = TimeLoad(way, fileName, &triangles);
+
+            double warm = INFINITY;
+            for (int repeat = 0; repeat < repeats; repeat++) warm = fmin(warm, TimeLoad(way, fileName, &triangles));
+
+            if (warm < 0.0) {
+                printf("  %-15s could not load %s\n", names[way], fileName);
+                continue;
+            }
+            if (cold >= 0.0) printf("  %-15s cold %8.2f ms, warm %8.2f ms", names[way], cold * 1000.0, warm * 1000.0);
+            else printf("  %-15s cold      n/a, warm %8.2f ms", names[way], warm * 1000.0);
+            if (way != LOAD_MAP) printf(", %d triangles", triangles);
+            printf("\n");
+        }
+    }
+
+    CloseWindow();
+    return 0;
+}
+
+// Seconds for one load and release, negative when the file does not load
+static double TimeLoad(LoadWay way, const char *fileName, int *triangles) {
+    double start = GetBenchClock();
+    double seconds = -1.0;
+
+    if (way == LOAD_MAP) {
+        BakedModelFile file;
+        if (MapBakedModel(fileName, &file)) {
+            // Upload reads every stream, so a fair mapping cost reads every page
+            PrefetchFileMap(&file.map);
+            seconds = GetBenchClock() - start;
+            UnmapBakedModel(&file);
+        }
+        return seconds;
+    }
+
+    Model model = way == LOAD_OBJ ? LoadModel(fileName) : LoadBakedModel(fileName);
+    seconds = GetBenchClock() - start;
+    if (model.meshCount == 0) return -1.0;
+
+    *triangles = 0;
+    for (int m = 0; m < model.meshCount; m++) *triangles += model.meshes[m].triangleCount;
+    UnloadModel(model);
+    return seconds;
+}
@@ -0,0 +1,169 @@
+// packer.c
+// Offline packer for the .fpak asset pack mounted by MountAssetPack.
+// Usage: packer [-z] <output.fpak> <file> [more files]
+//
+// Paths are stored exactly as given, so run it from the directory the game runs in
+// (e.g. packer resources/assets.fpak resources/models/bin/plane.fmesh ...). With -z,
+// entries that DEFLATE to less than 90% of their size are stored compressed; baked
+// .fmesh/.ftex files never are, they are meant to be mapped in place.
+#include "raylib.h"
+#include "PackFormat.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct PackerFile {
+    const char *path;
+    unsigned char *data;        // Stored bytes, compressed or not
+    PackFileEntry entry;
+} PackerFile;
+
+static unsigned char *ReadWholeFile(const char *fileName, uint32_t *size);
+static bool IsMappedFormat(const char *fileName);
+static int CompareEntries(const void *a, const void *b);
+
+int main(int argc, char **argv) {
+    bool compress = false;
+    int arg = 1;
+
+    if (arg < argc && strcmp(argv[arg], "-z") == 0) {
+        compress = true;
+        arg++;
+    }
+    if (argc - arg < 2) {
+        fprintf(stderr, "Usage: %s [-z] <output.fpak> <file> [more files]\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    const char *output = argv[arg++];
+    int count = argc - arg;
+    PackerFile *files = (PackerFile *)calloc(count, sizeof(PackerFile));
+    long looseBytes = 0;
+
+    // This is what the game does without a pack: one open and read per asset
+    clock_t looseStart = clock();
+    for (int i = 0; i < count; i++) {
+        PackerFile *file = &files[i];
+        file->path = argv[arg + i];
+        file->data = ReadWholeFile(file->path, &file->entry.size);
+        if (!file->data) {
+            fprintf(stderr, "packer: cannot read %s\n", file->path);
+            return 1;
+        }
+        file->entry.hash = HashPackPath(file->path);
+        file->entry.rawSize = file->entry.size;
+        file->entry.compression = PACK_COMPRESSION_NONE;
+        looseBytes += file->entry.size;
+    }
+    double looseSeconds = (double)(clock() - looseStart) / CLOCKS_PER_SEC;
+
+    for (int i = 0; compress && i < count; i++) {
+        PackerFile *file = &files[i];
+        if (IsMappedFormat(file->path)) continue;
+
+        int compressedSize = 0;
+        unsigned char *compressed = CompressData(file->data, (int)file->entry.size, &compressedSize);
+        if (compressed && compressedSize < (int)(file->entry.size / 10 * 9)) {
+            free(file->data);
+            file->data = compressed;
+            file->entry.size = (uint32_t)compressedSize;
+            file->entry.compression = PACK_COMPRESSION_DEFLATE;
+        } else {
+            MemFree(compressed);
+        }
+    }
+
+    // Lookups binary search the table by hash, a collision would make one path unreachable
+    qsort(files, count, sizeof(PackerFile), CompareEntries);
+    for (int i = 1; i < count; i++) {
+        if (files[i].entry.hash == files[i - 1].entry.hash) {
+            fprintf(stderr, "packer: %s and %s hash alike, rename one\n", files[i - 1].path, files[i].path);
+            return 1;
+        }
+    }
+
+    uint64_t offset = sizeof(PackFileHeader) + (uint64_t)count * sizeof(PackFileEntry);
+    for (int i = 0; i < count; i++) {
+        offset = (offset + PACK_FILE_ALIGNMENT - 1) / PACK_FILE_ALIGNMENT * PACK_FILE_ALIGNMENT;
+        files[i].entry.offset = offset;
+        offset += files[i].entry.size;
+    }
+
+    PackFileHeader header = { 0 };
+    header.magic = PACK_FILE_MAGIC;
+    header.version = PACK_FILE_VERSION;
+    header.entryCount = (uint32_t)count;
+
+    FILE *file = fopen(output, "wb");
+    if (!file) {
+        fprintf(stderr, "packer: cannot write %s\n", output);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, file);
+    for (int i = 0; i < count; i++) fwrite(&files[i].entry, sizeof(PackFileEntry), 1, file);
+
+    static const unsigned char padding[PACK_FILE_ALIGNMENT] = { 0 };
+    long position = (long)(sizeof(PackFileHeader) + count * sizeof(PackFileEntry));
+    for (int i = 0; i < count; i++) {
+        fwrite(padding, 1, (size_t)((long)files[i].entry.offset - position), file);
+        fwrite(files[i].data, 1, files[i].entry.size, file);
+        position = (long)(files[i].entry.offset + files[i].entry.size);
+    }
+    bool ok = ferror(file) == 0;
+    fclose(file);
+
+    // Same data again through the pack, one open for everything
+    clock_t packStart = clock();
+    uint32_t packSize = 0;
+    unsigned char *packData = ReadWholeFile(output, &packSize);
+    double packSeconds = (double)(clock() - packStart) / CLOCKS_PER_SEC;
+    free(packData);
+
+    int compressedCount = 0;
+    for (int i = 0; i < count; i++) compressedCount += files[i].entry.compression != PACK_COMPRESSION_NONE;
+
+    printf("packer: %d file(s) -> %s, %u bytes (%d compressed)\n", count, output, packSize, compressedCount);
+    printf("  loose: %d opens, %ld bytes, %.2f ms to read\n", count, looseBytes, looseSeconds * 1000.0);
+    printf("  pack:  1 open, %u bytes, %.2f ms to read\n", packSize, packSeconds * 1000.0);
+
+    for (int i = 0; i < count; i++) {
+        if (files[i].entry.compression == PACK_COMPRESSION_NONE) free(files[i].data);
+        else MemFree(files[i].data);
+    }
+    free(files);
+
+    return ok ? 0 : 1;
+}
+
+static unsigned char *ReadWholeFile(const char *fileName, uint32_t *size) {
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    unsigned char *data = (unsigned char *)malloc(length > 0 ? (size_t)length : 1);
+    if (length > 0 && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+
+    *size = (uint32_t)(length > 0 ? length : 0);
+    return data;
+}
+
+static bool IsMappedFormat(const char *fileName) {
+    const char *extension = strrchr(fileName, '.');
+    return extension && (strcmp(extension, ".fmesh") == 0 || strcmp(extension, ".ftex") == 0);
+}
+
+static int CompareEntries(const void *a, const void *b) {
+    uint64_t hashA = ((const PackerFile *)a)->entry.hash;
+    uint64_t hashB = ((const PackerFile *)b)->entry.hash;
+    return (hashA > hashB) - (hashA < hashB);
+}
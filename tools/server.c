@@ -0,0 +1,247 @@
+// server.c
+// Headless authoritative server: flies AI fleets and streams them to clients over UDP on localhost.
+// Usage: server [-port N] [-aircraft N] [-zones N] [-seconds S] [-bots N] [-broadcast] [-seed N]
+//
+// Terrain is never sent: clients get the world descriptor with their accept and generate the
+// chunks themselves, checking the descriptor's checksum against their own build first.
+//
+// The aircraft are split over a square of patrol zones, so -zones spreads them across the world.
+// Each client gets only the terrain chunks within TERRAIN_VIEW_DISTANCE of it, nearer entities
+// more often; -broadcast sends every client everything instead, for comparison.
+//
+// The terrain demo connects with C. With -bots, N clients run inside this process over real
+// loopback sockets, spread over the zones, and at exit the server reports the bytes per second
+// each one received and whether every bot decoded exactly the state the server encoded for it.
+#include "raylib.h"
+#include "AIFleet.h"
+#include "JobSystem.h"
+#include "NetClient.h"
+#include "NetServer.h"
+#include "raymath.h"
+#include "Terrain/Terrain.h"
+#include "Terrain/WorldDescriptor.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SERVER_THREADS      4       // Job system threads for the fleets, including the main thread
+#define SERVER_AIRCRAFT     1000    // Default aircraft over all zones
+#define SERVER_ZONE_SPACING (2.0f * AI_PATROL_RADIUS)  // Distance between patrol zone centres
+#define SERVER_BOT_ALTITUDE 150.0f
+#define SERVER_RAW_ENTITY   32      // Bytes of one entity sent as plain floats, id and quaternion, for comparison
+
+static Vector3 GetZoneCenter(int zone, int zoneCount);
+static void CaptureAIFleets(const AIFleet *fleets, int zoneCount, NetSnapshot *world);
+static bool IsSameNetSnapshot(const NetSnapshot *a, const NetSnapshot *b);
+
+int main(int argc, char **argv) {
+    int port = NET_DEFAULT_PORT;
+    int aircraft = SERVER_AIRCRAFT;
+    int zoneCount = 1;
+    double seconds = 0.0;       // 0 runs until killed
+    int botCount = 0;
+    bool broadcast = false;
+    HeightPipelineDesc height = GetDefaultHeightPipelineDesc();
+
+    for (int arg = 1; arg < argc; arg++) {
+        if (arg + 1 < argc && strcmp(argv[arg], "-port") == 0) port = atoi(argv[++arg]);
+        else if (arg + 1 < argc && strcmp(argv[arg], "-aircraft") == 0) aircraft = atoi(argv[++arg]);
+        else if (arg + 1 < argc && strcmp(argv[arg], "-zones") == 0) zoneCount = atoi(argv[++arg]);
+        else if (arg + 1 < argc && strcmp(argv[arg], "-seconds") == 0) seconds = atof(argv[++arg]);
+        else if (arg + 1 < argc && strcmp(argv[arg], "-bots") == 0) botCount = atoi(argv[++arg]);
+        else if (arg + 1 < argc && strcmp(argv[arg], "-seed") == 0) height.seed = atoi(argv[++arg]);
+        else if (strcmp(argv[arg], "-broadcast") == 0) broadcast = true;
+        else {
+            fprintf(stderr, "Usage: %s [-port N] [-aircraft N] [-zones N] [-seconds S] [-bots N] [-broadcast] [-seed N]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (botCount > NET_MAX_CLIENTS) botCount = NET_MAX_CLIENTS;
+    if (zoneCount < 1) zoneCount = 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    NetServer server;
+    if (!InitNetServer(&server, (uint16_t)port)) {
+        fprintf(stderr, "server: port %d is in use\n", port);
+        return 1;
+    }
+
+    // Clients build their terrain from this, so it is the only terrain that crosses the network
+    WorldDescriptor worldDescriptor = MakeWorldDescriptor(height, CHUNK_SIZE, TILE_SCALE);
+    unsigned char worldBytes[WORLD_DESCRIPTOR_BYTES];
+    SetNetServerWorld(&server, worldBytes, WriteWorldDescriptor(&worldDescriptor, worldBytes));
+
+    // Entities are bucketed by the same chunks the clients' terrain streams
+    float chunkWorldSize = (worldDescriptor.chunkSize - 1) * worldDescriptor.tileScale;
+    if (!broadcast) SetNetServerInterest(&server, chunkWorldSize, TERRAIN_VIEW_DISTANCE);
+
+    static JobSystem jobs;         // About 2 MB of worker deques, too big for the stack
+    InitJobSystem(&jobs, SERVER_THREADS);
+    AIFleet *fleets = (AIFleet *)calloc(zoneCount, sizeof(AIFleet));
+    for (int zone = 0; zone < zoneCount; zone++) {
+        InitAIFleet(&fleets[zone], &jobs, NULL, NULL);
+        SetAIFleetCount(&fleets[zone], aircraft / zoneCount + (zone < aircraft % zoneCount), GetZoneCenter(zone, zoneCount));
+    }
+
+    NetSnapshot world;
+    InitNetSnapshot(&world);
+
+    double start = GetNetClock();
+    NetClient *bots = (NetClient *)calloc(botCount > 0 ? botCount : 1, sizeof(NetClient));
+    Vector3 *botPositions = (Vector3 *)calloc(botCount > 0 ? botCount : 1, sizeof(Vector3));
+    for (int i = 0; i < botCount; i++) {
+        // Around the zone centres, so every bot has traffic nearby and most zones have a watcher
+        Vector3 center = GetZoneCenter(i % zoneCount, zoneCount);
+        float angle = (float)i * 2.39996f;
+        float radius = 300.0f + 100.0f * (float)((i / zoneCount) % 5);
+        botPositions[i] = (Vector3){ center.x + cosf(angle) * radius, SERVER_BOT_ALTITUDE, center.z + sinf(angle) * radius };
+
+        InitNetClient(&bots[i]);
+        ConnectNetClient(&bots[i], server.socket.port, start);
+    }
+
+    printf("server: port %d, %d aircraft in %d zone(s), %d Hz, %d bot(s), %s\n", server.socket.port, aircraft, zoneCount,
+           NET_TICK_RATE, botCount, broadcast ? "broadcast" : "chunk interest");
+    printf("  world: seed %d, %d x %.1f chunks, checksum %08x\n", height.seed, worldDescriptor.chunkSize, worldDescriptor.tileScale,
+           worldDescriptor.checksum);
+
+    const double tick = 1.0 / NET_TICK_RATE;
+    double nextTick = start;
+    double lastReport = start;
+    double simulationTime = 0.0;
+    double sendTime = 0.0;
+    long long reportBytes = 0;
+    long long windowTotal = 0;
+    long long dueTotal = 0;
+    int ticks = 0;
+
+    while (seconds <= 0.0 || GetNetClock() - start < seconds) {
+        PollNetServer(&server, GetNetClock());
+
+        double simulationStart = GetNetClock();
+        for (int zone = 0; zone < zoneCount; zone++) {
+            // Each zone patrols its centre and attacks the nearest client, if one is close enough to matter
+            Vector3 center = GetZoneCenter(zone, zoneCount);
+            Vector3 target = center;
+            float nearest = SERVER_ZONE_SPACING;
+            for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+                const NetServerClient *client = &server.clients[i];
+                float distance = Vector3Distance(client->position, center);
+                if (client->connected && distance < nearest) {
+                    nearest = distance;
+                    target = client->position;
+                }
+            }
+            UpdateAIFleet(&fleets[zone], center, target, (float)tick);
+        }
+        CaptureAIFleets(fleets, zoneCount, &world);
+        simulationTime += GetNetClock() - simulationStart;
+
+        SendNetSnapshots(&server, &world);
+        sendTime += server.sendTime;
+        ticks++;
+        for (int i = 0; i < NET_MAX_CLIENTS; i++) {
+            if (!server.clients[i].connected) continue;
+            windowTotal += server.clients[i].interestCount;
+            dueTotal += server.clients[i].entitiesDue;
+        }
+
+        // Loopback delivers at once, so the bots see this tick's snapshot straight away
+        for (int i = 0; i < botCount; i++) PollNetClient(&bots[i], botPositions[i], GetNetClock());
+
+        double now = GetNetClock();
+        if (now - lastReport >= 1.0) {
+            int clients = server.clientCount > 0 ? server.clientCount : 1;
+            printf("  %3.0f s: %d client(s), %d entities, %.1f KB/s per client, sim %.2f ms, send %.2f ms per tick\n",
+                   now - start, server.clientCount, world.count, (server.bytesSent - reportBytes) / 1024.0 / clients / (now - lastReport),
+                   simulationTime / ticks * 1000.0, sendTime / ticks * 1000.0);
+            reportBytes = server.bytesSent;
+            lastReport = now;
+        }
+
+        nextTick += tick;
+        WaitNetClock(nextTick - GetNetClock());
+    }
+
+    double elapsed = GetNetClock() - start;
+    long long clientTicks = 0;
+    for (int i = 0; i < NET_MAX_CLIENTS; i++) clientTicks += server.clients[i].snapshotsSent;
+    printf("server: %d ticks in %.1f s, sim %.3f ms, send %.3f ms per tick (%.1f us per client)\n", ticks, elapsed,
+           simulationTime / ticks * 1000.0, sendTime / ticks * 1000.0, clientTicks > 0 ? sendTime / clientTicks * 1e6 : 0.0);
+    printf("  %.1f KB/s to all clients, %.1f entities in each window, %.1f due per tick\n", server.bytesSent / 1024.0 / elapsed,
+           clientTicks > 0 ? (double)windowTotal / clientTicks : 0.0, clientTicks > 0 ? (double)dueTotal / clientTicks : 0.0);
+    printf("  plain floats would be %.1f KB/s per client\n", (double)world.count * SERVER_RAW_ENTITY * NET_TICK_RATE / 1024.0);
+
+    // A bot is in sync when the snapshot it decoded last is exactly the one the server encoded for it,
+    // and it generates the server's terrain from the descriptor it was sent
+    int inSync = 0;
+    for (int i = 0; i < botCount; i++) {
+        NetClient *bot = &bots[i];
+        const NetSnapshot *decoded = GetNetClientSnapshot(bot);
+        const NetServerClient *client = &server.clients[bot->slot];
+        WorldDescriptor botWorld;
+        bool sameWorld = ReadWorldDescriptor(&botWorld, bot->world, bot->worldSize) && VerifyWorldDescriptor(&botWorld);
+        bool synced = bot->state == NET_CLIENT_CONNECTED && decoded && client->connected && sameWorld &&
+                      IsSameNetSnapshot(decoded, &client->history[decoded->sequence % NET_SNAPSHOT_HISTORY]);
+        inSync += synced;
+        if (botCount > 8 && synced) continue;
+
+        printf("  bot %d: %.1f KB/s, %d snapshots (%d full, %d dropped), %d entities, %s\n", i,
+               bot->bytesReceived / 1024.0 / elapsed, bot->snapshotsReceived, client->fullSnapshots, bot->snapshotsDropped,
+               decoded ? decoded->count : 0, synced ? "in sync" : (sameWorld ? "OUT OF SYNC" : "OTHER TERRAIN"));
+    }
+    if (botCount > 0) printf("server: %d of %d bot(s) in sync\n", inSync, botCount);
+
+    for (int i = 0; i < botCount; i++) DisconnectNetClient(&bots[i]);
+    free(bots);
+    free(botPositions);
+    UnloadNetSnapshot(&world);
+    UnloadNetServer(&server);
+    for (int zone = 0; zone < zoneCount; zone++) UnloadAIFleet(&fleets[zone]);
+    free(fleets);
+    UnloadJobSystem(&jobs);
+
+    return inSync == botCount ? 0 : 1;
+}
+
+// Zones fill a square around the origin
+static Vector3 GetZoneCenter(int zone, int zoneCount) {
+    int side = (int)ceilf(sqrtf((float)zoneCount));
+    float half = 0.5f * (float)(side - 1);
+    return (Vector3){ ((float)(zone % side) - half) * SERVER_ZONE_SPACING, 0.0f, ((float)(zone / side) - half) * SERVER_ZONE_SPACING };
+}
+
+// Planes of every zone first, then their live bullets, so the ids come out sorted
+static void CaptureAIFleets(const AIFleet *fleets, int zoneCount, NetSnapshot *world) {
+    ClearNetSnapshot(world);
+
+    uint32_t base = 0;
+    for (int zone = 0; zone < zoneCount; zone++) {
+        const AIFleet *fleet = &fleets[zone];
+        for (int i = 0; i < fleet->count; i++) {
+            Vector3 position = { fleet->positionX[i], fleet->positionY[i], fleet->positionZ[i] };
+            Quaternion orientation = { fleet->orientationX[i], fleet->orientationY[i], fleet->orientationZ[i], fleet->orientationW[i] };
+            PushNetEntity(world, QuantiseNetEntity(base + (uint32_t)i, position, orientation));
+        }
+        base += (uint32_t)fleet->count;
+    }
+
+    base = 0;
+    for (int zone = 0; zone < zoneCount; zone++) {
+        const AIFleet *fleet = &fleets[zone];
+        for (int i = 0; i < fleet->count; i++) {
+            if (fleet->bulletLife[i] <= 0.0f) continue;
+
+            Vector3 position = { fleet->bulletX[i], fleet->bulletY[i], fleet->bulletZ[i] };
+            PushNetEntity(world, QuantiseNetEntity(NET_BULLET_ID | (base + (uint32_t)i), position, (Quaternion){ 0.0f, 0.0f, 0.0f, 1.0f }));
+        }
+        base += (uint32_t)fleet->count;
+    }
+}
+
+static bool IsSameNetSnapshot(const NetSnapshot *a, const NetSnapshot *b) {
+    if (a->sequence != b->sequence || a->count != b->count) return false;
+    return a->count == 0 || memcmp(a->entities, b->entities, a->count * sizeof(NetEntity)) == 0;
+}
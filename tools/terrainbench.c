@@ -0,0 +1,608 @@
+// terrainbench.c
+// Terrain benchmarks that need no window, on a headless TerrainManager.
+// Usage: terrainbench [section...]
+//
+// Runs every section, or only the named ones:
+//   cache   circling flight, chunk cache hits, misses, memory and update time per cache budget, and
+//           chunks generated per second streaming the frustum footprint against the old square radius
+//   height  samples per second and output range of the height pipeline, against the per-octave
+//           GetOctaveNoise it replaced and against FastNoiseLite's own fractal call
+//   threads GenerateTerrainHeightmap on 256 and 1024 sided chunks with 1 to JOB_MAX_WORKERS threads
+//   chunks  chunk sizes 32 to 512 on a straight flight, draw calls against regeneration cost
+//   crater  DeformTerrain latency and re-encoded bytes against regenerating the whole chunk
+//   scatter prop placement and instance gathering for TERRAINBENCH_PROPS props, with the draw calls
+//   colour  per-chunk vertex colours through the gradient table against the five-colour ColorLerp
+//           branches it replaced, on 64 and 256 sided chunks
+//
+// Timings include the vertex encoding UploadTerrainChunk does before the upload, not the
+// upload itself, which needs a GL context.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "raymath.h"
+#include "Terrain/Terrain.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TERRAINBENCH_CIRCLE_RADIUS  1500.0f     // Circling flight, chunks leave the view and come back every lap
+#define TERRAINBENCH_CIRCLE_LAPS    3
+#define TERRAINBENCH_SPEED          300.0f      // Plane speed in units per second
+#define TERRAINBENCH_ALTITUDE       150.0f
+#define TERRAINBENCH_TICK           (1.0f / 60.0f)
+#define TERRAINBENCH_HEIGHT_GRID    1024        // Height samples per side, TILE_SCALE apart
+#define TERRAINBENCH_REPEATS        5           // Timed passes, the fastest is reported
+#define TERRAINBENCH_LARGE_CHUNK    1024        // Largest heightmap side of the thread scaling run
+#define TERRAINBENCH_FLIGHT_SECONDS 60.0f       // Length of the straight flight of the chunk size sweep
+#define TERRAINBENCH_CAMERA_FAR     1000.0      // Far plane BeginMode3D uses, for counting what DrawTerrain draws
+#define TERRAINBENCH_CRATERS        200         // Craters timed per radius
+#define TERRAINBENCH_CRATER_SPREAD  400.0f      // Craters land within this distance of the plane on X and Z
+#define TERRAINBENCH_PROPS          100000      // Props scattered before the gather is timed
+#define TERRAINBENCH_PROP_CHUNKS    64          // Side of the largest chunk square scattered to reach them
+#define TERRAINBENCH_RADIUS_VIEW    40.0f       // View distance of the square streaming the footprint replaced
+
+typedef struct BenchSection {
+    const char *name;
+    void (*run)(void);
+} BenchSection;
+
+typedef float (*HeightSampler)(void *state, double x, double z);
+
+static TerrainManager terrain;  // Chunk arrays make it too big for the stack
+static JobSystem jobs;
+static PropInstance *chunkProps[TERRAINBENCH_PROP_CHUNKS * TERRAINBENCH_PROP_CHUNKS];
+static int chunkPropCounts[TERRAINBENCH_PROP_CHUNKS * TERRAINBENCH_PROP_CHUNKS];
+
+static void BenchChunkCache(void);
+static double FlyCircles(int laps);
+static void BenchStreamingArea(void);
+static void StreamChunkRadius(Vector3 planePosition);
+static Camera GetChaseCamera(Vector3 plane, Vector3 forward);
+static void BenchHeightPipeline(void);
+static float SampleLegacyHeight(void *state, double x, double z);
+static float SampleFractalHeight(void *state, double x, double z);
+static float SamplePipelineHeight(void *state, double x, double z);
+static void TimeHeightSamples(const char *name, HeightSampler sample, void *state, float bound);
+static void BenchThreadScaling(void);
+static void BenchChunkSizes(void);
+static int CountVisibleChunks(const TerrainManager *terrain, Camera camera);
+static void BenchCraters(void);
+static void BenchScatter(void);
+static void BenchColors(void);
+static Color GetBaselineTerrainColor(float normalizedHeight);
+
+static const BenchSection sections[] = {
+    { "cache", BenchChunkCache },
+    { "height", BenchHeightPipeline },
+    { "threads", BenchThreadScaling },
+    { "chunks", BenchChunkSizes },
+    { "crater", BenchCraters },
+    { "scatter", BenchScatter },
+    { "colour", BenchColors },
+};
+
+#define BENCH_SECTION_COUNT ((int)(sizeof(sections) / sizeof(sections[0])))
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        int section = 0;
+        while (section < BENCH_SECTION_COUNT && strcmp(argv[i], sections[section].name) != 0) section++;
+        if (section == BENCH_SECTION_COUNT) {
+            printf("Usage: terrainbench [section...], sections:");
+            for (int s = 0; s < BENCH_SECTION_COUNT; s++) printf(" %s", sections[s].name);
+            printf("\n");
+            return 1;
+        }
+    }
+
+    for (int s = 0; s < BENCH_SECTION_COUNT; s++) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++) selected = selected || strcmp(argv[i], sections[s].name) == 0;
+        if (selected) sections[s].run();
+    }
+    return 0;
+}
+
+// Laps around a circle wider than the view, with and without the cache and at several budgets
+static void BenchChunkCache(void) {
+    const size_t budgets[] = { 0, 1024 * 1024, 4 * 1024 * 1024, 16 * 1024 * 1024 };
+
+    printf("Chunk cache, %d laps of radius %.0f at %.0f units/s:\n", TERRAINBENCH_CIRCLE_LAPS, TERRAINBENCH_CIRCLE_RADIUS, TERRAINBENCH_SPEED);
+    for (int quantize = 0; quantize <= 1; quantize++) {
+        for (int b = 0; b < (int)(sizeof(budgets) / sizeof(budgets[0])); b++) {
+            if (quantize && budgets[b] == 0) continue;
+
+            TerrainConfig config = GetDefaultTerrainConfig();
+            config.headless = true;
+            InitTerrainEx(&terrain, config);
+            UnloadChunkCache(&terrain.cache);
+            InitChunkCache(&terrain.cache, budgets[b], quantize);
+
+            double seconds = FlyCircles(TERRAINBENCH_CIRCLE_LAPS);
+            printf("  %5zu KiB %-9s: %4u generated, %4u hits, %4u misses, hit ratio %5.1f%%, holding %4zu KiB in %3d entries, updates %.1f ms per lap\n",
+                   budgets[b] / 1024, quantize ? "16-bit" : "float", terrain.chunksGenerated, terrain.cache.hits, terrain.cache.misses,
+                   GetChunkCacheHitRatio(&terrain.cache) * 100.0f, terrain.cache.bytesUsed / 1024, terrain.cache.count,
+                   seconds / TERRAINBENCH_CIRCLE_LAPS * 1000.0);
+
+            UnloadTerrain(&terrain);
+        }
+    }
+
+    BenchStreamingArea();
+}
+
+// Returns the seconds spent in UpdateTerrain
+static double FlyCircles(int laps) {
+    float lapTime = 2.0f * PI * TERRAINBENCH_CIRCLE_RADIUS / TERRAINBENCH_SPEED;
+    int frames = (int)(laps * lapTime / TERRAINBENCH_TICK);
+    double seconds = 0.0;
+
+    for (int frame = 0; frame < frames; frame++) {
+        float angle = frame * TERRAINBENCH_TICK * TERRAINBENCH_SPEED / TERRAINBENCH_CIRCLE_RADIUS;
+        Vector3 plane = { TERRAINBENCH_CIRCLE_RADIUS * cosf(angle), TERRAINBENCH_ALTITUDE, TERRAINBENCH_CIRCLE_RADIUS * sinf(angle) };
+        Vector3 forward = { -sinf(angle), 0.0f, cosf(angle) };
+
+        double start = GetBenchClock();
+        UpdateTerrain(&terrain, plane, forward, GetChaseCamera(plane, forward));
+        seconds += GetBenchClock() - start;
+    }
+
+    return seconds;
+}
+
+// The same circles at the default cache budget, streaming what UpdateTerrain picks from the
+// camera footprint against the square of chunks around the plane it picked before
+static void BenchStreamingArea(void) {
+    float lapTime = 2.0f * PI * TERRAINBENCH_CIRCLE_RADIUS / TERRAINBENCH_SPEED;
+    int frames = (int)(TERRAINBENCH_CIRCLE_LAPS * lapTime / TERRAINBENCH_TICK);
+    const char *names[2] = { "square radius", "footprint" };
+
+    printf("Streamed area on the same laps, default cache budget:\n");
+    for (int footprint = 0; footprint <= 1; footprint++) {
+        TerrainConfig config = GetDefaultTerrainConfig();
+        config.headless = true;
+        InitTerrainEx(&terrain, config);
+
+        long residentSum = 0, visibleSum = 0;
+        for (int frame = 0; frame < frames; frame++) {
+            float angle = frame * TERRAINBENCH_TICK * TERRAINBENCH_SPEED / TERRAINBENCH_CIRCLE_RADIUS;
+            Vector3 plane = { TERRAINBENCH_CIRCLE_RADIUS * cosf(angle), TERRAINBENCH_ALTITUDE, TERRAINBENCH_CIRCLE_RADIUS * sinf(angle) };
+            Vector3 forward = { -sinf(angle), 0.0f, cosf(angle) };
+            Camera camera = GetChaseCamera(plane, forward);
+
+            if (footprint) UpdateTerrain(&terrain, plane, forward, camera);
+            else StreamChunkRadius(plane);
+
+            residentSum += terrain.chunkCount;
+            visibleSum += CountVisibleChunks(&terrain, camera);
+        }
+
+        printf("  %-13s: %4u generated, %5.2f generated/s, %5.1f resident, %5.1f of them in view\n", names[footprint],
+               terrain.chunksGenerated, terrain.chunksGenerated / (frames * TERRAINBENCH_TICK),
+               (double)residentSum / frames, (double)visibleSum / frames);
+
+        UnloadTerrain(&terrain);
+    }
+}
+
+// UpdateTerrain before the footprint: every chunk within TERRAINBENCH_RADIUS_VIEW of the plane's
+// chunk plus one, dropping the oldest into the cache when MAX_CHUNKS are resident. Heights only,
+// the count of generated chunks is what is compared.
+static void StreamChunkRadius(Vector3 planePosition) {
+    int size = terrain.chunkSize;
+    float chunkWorldSize = (size - 1) * terrain.tileScale;
+    int range = (int)ceilf(TERRAINBENCH_RADIUS_VIEW / chunkWorldSize) + 1;
+    int planeChunkX = (int)floorf(planePosition.x / chunkWorldSize);
+    int planeChunkZ = (int)floorf(planePosition.z / chunkWorldSize);
+
+    for (int z = planeChunkZ - range; z <= planeChunkZ + range; z++) {
+        for (int x = planeChunkX - range; x <= planeChunkX + range; x++) {
+            bool loaded = false;
+            for (int i = 0; i < terrain.chunkCount && !loaded; i++) loaded = terrain.chunks[i].chunkX == x && terrain.chunks[i].chunkZ == z;
+            if (loaded) continue;
+
+            if (terrain.chunkCount == MAX_CHUNKS) {
+                ChunkCacheStore(&terrain.cache, terrain.chunks[0].chunkX, terrain.chunks[0].chunkZ, terrain.chunks[0].heights, size);
+                RL_FREE(terrain.chunks[0].heights);
+                memmove(&terrain.chunks[0], &terrain.chunks[1], sizeof(TerrainChunk) * --terrain.chunkCount);
+            }
+
+            TerrainChunk *chunk = &terrain.chunks[terrain.chunkCount++];
+            memset(chunk, 0, sizeof(TerrainChunk));
+            chunk->chunkX = x;
+            chunk->chunkZ = z;
+            chunk->position = (Vector3){ x * chunkWorldSize, 0.0f, z * chunkWorldSize };
+            chunk->heights = (float *)RL_MALLOC(sizeof(float) * size * size);
+            if (!ChunkCacheFetch(&terrain.cache, x, z, chunk->heights, size)) {
+                GenerateTerrainHeightmap(&terrain, chunk->heights, size, terrain.tileScale, (double)x * chunkWorldSize, (double)z * chunkWorldSize);
+                terrain.chunksGenerated++;
+            }
+        }
+    }
+}
+
+// Behind and above the plane like the demo, turned with the flight
+static Camera GetChaseCamera(Vector3 plane, Vector3 forward) {
+    Camera camera = { 0 };
+    camera.position = Vector3Add(plane, (Vector3){ -300.0f * forward.x, 100.0f, -300.0f * forward.z });
+    camera.target = plane;
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 60.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    return camera;
+}
+
+// Samples the same grid with each height function, the legacy path is the pre-pipeline GetOctaveNoise
+static void BenchHeightPipeline(void) {
+    printf("Height samples, %dx%d grid %.0f units apart, best of %d:\n", TERRAINBENCH_HEIGHT_GRID, TERRAINBENCH_HEIGHT_GRID, TILE_SCALE, TERRAINBENCH_REPEATS);
+
+    fnl_state legacy = fnlCreateState();
+    legacy.seed = NOISE_SEED;
+    legacy.noise_type = FNL_NOISE_OPENSIMPLEX2;
+    legacy.frequency = NOISE_FREQUENCY;
+    TimeHeightSamples("GetOctaveNoise", SampleLegacyHeight, &legacy, 2.0f * NOISE_AMPLITUDE + 1.0f);
+
+    // What the old loop did by hand, in one call with per-octave seeds and fractal bounding
+    fnl_state fractal = legacy;
+    fractal.fractal_type = FNL_FRACTAL_FBM;
+    fractal.octaves = NOISE_OCTAVES;
+    fractal.lacunarity = NOISE_LACUNARITY;
+    fractal.gain = NOISE_PERSISTENCE;
+    TimeHeightSamples("fnlGetNoise2D FBM", SampleFractalHeight, &fractal, NOISE_AMPLITUDE);
+
+    const char *names[] = { "pipeline", "pipeline, warp", "pipeline, terrace" };
+    for (int variant = 0; variant < 3; variant++) {
+        HeightPipelineDesc desc = GetDefaultHeightPipelineDesc();
+        if (variant == 1) {
+            desc.warpAmplitude = 30.0f;
+            desc.warpFrequency = 0.005f;
+        }
+        if (variant == 2) {
+            desc.remap = HEIGHT_REMAP_TERRACE;
+            desc.remapParam = 6.0f;
+        }
+        HeightPipeline pipeline = CompileHeightPipeline(desc);
+        TimeHeightSamples(names[variant], SamplePipelineHeight, &pipeline, pipeline.amplitude);
+    }
+}
+
+// The height function before the pipeline: one seed for every octave, NOISE_AMPLITUDE inside each
+// octave and a *2-1 rescale, which put heights in [-21, 19]
+static float SampleLegacyHeight(void *state, double x, double z) {
+    float amplitude = 1.0f;
+    float frequency = 1.0f;
+    float noiseHeight = 0.0f;
+    float maxPossibleHeight = 0.0f;
+
+    for (int i = 0; i < NOISE_OCTAVES; i++) {
+        float noiseValue = fnlGetNoise2D(state, (float)x * frequency, (float)z * frequency) * NOISE_AMPLITUDE * 2.0f - 1.0f;
+        noiseHeight += noiseValue * amplitude;
+        maxPossibleHeight += amplitude;
+        amplitude *= NOISE_PERSISTENCE;
+        frequency *= NOISE_LACUNARITY;
+    }
+
+    return noiseHeight / maxPossibleHeight;
+}
+
+static float SampleFractalHeight(void *state, double x, double z) {
+    return fnlGetNoise2D(state, x, z) * NOISE_AMPLITUDE;
+}
+
+static float SamplePipelineHeight(void *state, double x, double z) {
+    return EvaluateHeight(state, x, z);
+}
+
+// Prints the best rate of TERRAINBENCH_REPEATS passes and the range of the heights against their bound
+static void TimeHeightSamples(const char *name, HeightSampler sample, void *state, float bound) {
+    const int grid = TERRAINBENCH_HEIGHT_GRID;
+    float low = INFINITY, high = -INFINITY;
+    double best = INFINITY;
+
+    for (int repeat = 0; repeat < TERRAINBENCH_REPEATS; repeat++) {
+        double start = GetBenchClock();
+        for (int z = 0; z < grid; z++) {
+            for (int x = 0; x < grid; x++) {
+                float height = sample(state, (double)x * TILE_SCALE, (double)z * TILE_SCALE);
+                low = fminf(low, height);
+                high = fmaxf(high, height);
+            }
+        }
+        best = fmin(best, GetBenchClock() - start);
+    }
+
+    printf("  %-18s %6.2f M samples/s, range [%7.3f, %7.3f], bound %.0f%s\n", name, (double)grid * grid / best / 1e6, low, high, bound,
+           low < -bound || high > bound ? ", OUT OF RANGE" : "");
+}
+
+// Heights of one large chunk split across rows, every thread count must produce the same heights
+static void BenchThreadScaling(void) {
+    float *heights = (float *)malloc(sizeof(float) * TERRAINBENCH_LARGE_CHUNK * TERRAINBENCH_LARGE_CHUNK);
+    float *reference = (float *)malloc(sizeof(float) * TERRAINBENCH_LARGE_CHUNK * TERRAINBENCH_LARGE_CHUNK);
+
+    printf("Chunk heights across threads, best of %d:\n", TERRAINBENCH_REPEATS);
+    for (int size = 256; size <= TERRAINBENCH_LARGE_CHUNK; size *= 4) {
+        double single = 0.0;
+
+        for (int threadCount = 1; threadCount <= JOB_MAX_WORKERS; threadCount *= 2) {
+            InitJobSystem(&jobs, threadCount);
+            TerrainConfig config = GetDefaultTerrainConfig();
+            config.headless = true;
+            config.jobs = &jobs;
+            InitTerrainEx(&terrain, config);
+
+            double best = INFINITY;
+            for (int repeat = 0; repeat < TERRAINBENCH_REPEATS; repeat++) {
+                double start = GetBenchClock();
+                GenerateTerrainHeightmap(&terrain, heights, size, TILE_SCALE, 0.0, 0.0);
+                best = fmin(best, GetBenchClock() - start);
+            }
+
+            if (threadCount == 1) {
+                single = best;
+                memcpy(reference, heights, sizeof(float) * size * size);
+            }
+            bool same = memcmp(reference, heights, sizeof(float) * size * size) == 0;
+            printf("  %4dx%-4d %2d threads: %8.2f ms, speedup %.2fx%s\n", size, size, threadCount, best * 1000.0, single / best,
+                   same ? "" : ", HEIGHTS DIFFER");
+
+            UnloadTerrain(&terrain);
+            UnloadJobSystem(&jobs);
+        }
+    }
+
+    free(reference);
+    free(heights);
+}
+
+// Small chunks mean more draw calls, large ones mean longer hitches when one is generated
+static void BenchChunkSizes(void) {
+    int frames = (int)(TERRAINBENCH_FLIGHT_SECONDS / TERRAINBENCH_TICK);
+    Vector3 forward = Vector3Normalize((Vector3){ 3.0f, 0.0f, 1.0f });
+
+    printf("Chunk sizes, %.0f s straight at %.0f units/s, view distance %.0f:\n", TERRAINBENCH_FLIGHT_SECONDS, TERRAINBENCH_SPEED, TERRAIN_VIEW_DISTANCE);
+    for (int size = 32; size <= 512; size *= 2) {
+        TerrainConfig config = GetDefaultTerrainConfig();
+        config.headless = true;
+        config.chunkSize = size;
+        InitTerrainEx(&terrain, config);
+
+        double worldX = 0.0, worldZ = 0.0;
+        double total = 0.0, first = 0.0, worst = 0.0;
+        long visibleSum = 0, residentSum = 0;
+        int fullFrames = 0;
+
+        for (int frame = 0; frame < frames; frame++) {
+            worldX += forward.x * TERRAINBENCH_SPEED * TERRAINBENCH_TICK;
+            worldZ += forward.z * TERRAINBENCH_SPEED * TERRAINBENCH_TICK;
+
+            // Render space as the demo keeps it, rebased whenever the plane strays from the origin
+            float chunkWorldSize = (size - 1) * TILE_SCALE;
+            Vector3 plane = { (float)(worldX - (double)terrain.originChunkX * chunkWorldSize), TERRAINBENCH_ALTITUDE,
+                              (float)(worldZ - (double)terrain.originChunkZ * chunkWorldSize) };
+            plane = Vector3Subtract(plane, RebaseTerrainOrigin(&terrain, plane));
+            Camera camera = GetChaseCamera(plane, forward);
+
+            double start = GetBenchClock();
+            UpdateTerrain(&terrain, plane, forward, camera);
+            double seconds = GetBenchClock() - start;
+            total += seconds;
+            if (frame == 0) first = seconds;
+            else worst = fmax(worst, seconds);
+
+            visibleSum += CountVisibleChunks(&terrain, camera);
+            residentSum += terrain.chunkCount;
+            if (terrain.chunkCount == MAX_CHUNKS) fullFrames++;
+        }
+
+        double visible = (double)visibleSum / frames;
+        printf("  %3d: %5.1f resident (full %4d frames), %5.1f visible x %d bands = %5.1f draw calls, %4u generated, "
+               "first frame %6.1f ms, then %5.2f ms per frame, worst %5.1f ms, %4zu KiB vertices per chunk\n",
+               size, (double)residentSum / frames, fullFrames, visible, terrain.bandCount, visible * terrain.bandCount,
+               terrain.chunksGenerated, first * 1000.0, (total - first) / (frames - 1) * 1000.0, worst * 1000.0, sizeof(TerrainVertex) * size * size / 1024);
+
+        UnloadTerrain(&terrain);
+    }
+}
+
+// The chunks DrawTerrain would draw from this camera, with the same box test as its culling
+static int CountVisibleChunks(const TerrainManager *terrain, Camera camera) {
+    Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix projection = MatrixPerspective(camera.fovy * DEG2RAD, (double)SCREEN_ASPECT_WIDTH / SCREEN_ASPECT_HEIGHT, 0.01, TERRAINBENCH_CAMERA_FAR);
+    Matrix m = MatrixMultiply(view, projection);
+    float rows[4][4] = {
+        { m.m0, m.m4, m.m8, m.m12 },
+        { m.m1, m.m5, m.m9, m.m13 },
+        { m.m2, m.m6, m.m10, m.m14 },
+        { m.m3, m.m7, m.m11, m.m15 }
+    };
+
+    float chunkWorldSize = (terrain->chunkSize - 1) * terrain->tileScale;
+    float amplitude = terrain->heightPipeline.amplitude;
+    int visibleChunks = 0;
+
+    for (int i = 0; i < terrain->chunkCount; i++) {
+        Vector3 min = { terrain->chunks[i].position.x, -amplitude, terrain->chunks[i].position.z };
+        Vector3 max = { min.x + chunkWorldSize, amplitude, min.z + chunkWorldSize };
+
+        bool visible = true;
+        for (int p = 0; p < 6 && visible; p++) {
+            float sign = (p & 1) ? -1.0f : 1.0f;
+            const float *row = rows[p / 2];
+            Vector4 plane = { rows[3][0] + sign * row[0], rows[3][1] + sign * row[1], rows[3][2] + sign * row[2], rows[3][3] + sign * row[3] };
+            visible = plane.x * (plane.x >= 0.0f ? max.x : min.x) + plane.y * (plane.y >= 0.0f ? max.y : min.y) +
+                      plane.z * (plane.z >= 0.0f ? max.z : min.z) + plane.w >= 0.0f;
+        }
+        visibleChunks += visible;
+    }
+
+    return visibleChunks;
+}
+
+// A crater re-encodes only the rows it touched, a full regeneration samples and encodes every vertex
+static void BenchCraters(void) {
+    const float radii[] = { 10.0f, 30.0f, 100.0f };
+    Vector3 plane = { 0.0f, TERRAINBENCH_ALTITUDE, 0.0f };
+    Vector3 forward = { 0.0f, 0.0f, 1.0f };
+
+    // Without a cache every chunk of the first fill is generated, heights and vertex encoding both
+    TerrainConfig config = GetDefaultTerrainConfig();
+    config.headless = true;
+    InitTerrainEx(&terrain, config);
+    UnloadChunkCache(&terrain.cache);
+    InitChunkCache(&terrain.cache, 0, false);
+
+    double start = GetBenchClock();
+    UpdateTerrain(&terrain, plane, forward, GetChaseCamera(plane, forward));
+    double regenerate = (GetBenchClock() - start) / terrain.chunksGenerated;
+    int size = terrain.chunkSize;
+    size_t chunkBytes = sizeof(TerrainVertex) * size * size;
+
+    printf("Craters, %d per radius on %dx%d chunks:\n", TERRAINBENCH_CRATERS, size, size);
+    printf("  full regeneration   %8.1f us per chunk, %6zu bytes to upload\n", regenerate * 1e6, chunkBytes);
+
+    for (int r = 0; r < (int)(sizeof(radii) / sizeof(radii[0])); r++) {
+        float radius = radii[r];
+        double total = 0.0, worst = 0.0;
+
+        for (int i = 0; i < TERRAINBENCH_CRATERS; i++) {
+            // Low-discrepancy spread, the same craters on every run
+            float u = fmodf(i * 0.6180340f, 1.0f), v = fmodf(i * 0.7548777f, 1.0f);
+            Vector3 center = { (2.0f * u - 1.0f) * TERRAINBENCH_CRATER_SPREAD, 0.0f, (2.0f * v - 1.0f) * TERRAINBENCH_CRATER_SPREAD };
+
+            start = GetBenchClock();
+            DeformTerrain(&terrain, center, radius, 0.1f * radius);
+            double seconds = GetBenchClock() - start;
+            total += seconds;
+            worst = fmax(worst, seconds);
+        }
+
+        // Rows DeformTerrain rebuilds in a chunk the crater lies inside: the bowl plus one either side
+        int rows = (int)ceilf(2.0f * radius / terrain.tileScale) + 3;
+        if (rows > size) rows = size;
+        size_t craterBytes = sizeof(TerrainVertex) * rows * size;
+        printf("  crater radius %5.0f %8.1f us mean, %8.1f us worst, %6zu bytes to upload per chunk touched (%4.1f%%), %5.0fx faster\n",
+               radius, total / TERRAINBENCH_CRATERS * 1e6, worst * 1e6, craterBytes, 100.0 * craterBytes / chunkBytes,
+               regenerate / (total / TERRAINBENCH_CRATERS));
+    }
+
+    UnloadTerrain(&terrain);
+}
+
+// Placement runs once per chunk load, the gather whenever the chunk set or origin changes
+static void BenchScatter(void) {
+    TerrainConfig config = GetDefaultTerrainConfig();
+    config.headless = true;
+    InitTerrainEx(&terrain, config);
+
+    // The placement state InitPropScatter sets up, without its GL assets
+    PropScatter scatter = { 0 };
+    scatter.seed = config.height.seed;
+    scatter.spacing = config.propSpacing;
+    scatter.maxDensity = config.propDensity;
+    scatter.density = fnlCreateState();
+    scatter.density.seed = config.height.seed;
+    scatter.density.noise_type = FNL_NOISE_OPENSIMPLEX2;
+    scatter.density.frequency = 0.004f;
+    scatter.density.fractal_type = FNL_FRACTAL_FBM;
+    scatter.density.octaves = 2;
+
+    int size = terrain.chunkSize;
+    float chunkWorldSize = (size - 1) * terrain.tileScale;
+    float *heights = (float *)malloc(sizeof(float) * size * size);
+    int chunks = 0, props = 0, typeCounts[PROP_TYPE_COUNT] = { 0 };
+    double placement = 0.0;
+
+    while (props < TERRAINBENCH_PROPS && chunks < TERRAINBENCH_PROP_CHUNKS * TERRAINBENCH_PROP_CHUNKS) {
+        int chunkX = chunks % TERRAINBENCH_PROP_CHUNKS, chunkZ = chunks / TERRAINBENCH_PROP_CHUNKS;
+        GenerateTerrainHeightmap(&terrain, heights, size, terrain.tileScale, (double)chunkX * chunkWorldSize, (double)chunkZ * chunkWorldSize);
+
+        double start = GetBenchClock();
+        int count = ScatterChunkProps(&scatter, chunkX, chunkZ, heights, size, terrain.tileScale, terrain.heightPipeline.amplitude, &chunkProps[chunks]);
+        placement += GetBenchClock() - start;
+
+        chunkPropCounts[chunks++] = count;
+        props += count;
+        for (int i = 0; i < count; i++) typeCounts[chunkProps[chunks - 1][i].type]++;
+    }
+
+    double gather = INFINITY;
+    for (int repeat = 0; repeat < TERRAINBENCH_REPEATS; repeat++) {
+        double start = GetBenchClock();
+        ClearPropBatches(&scatter);
+        for (int i = 0; i < chunks; i++) {
+            Vector3 origin = { (i % TERRAINBENCH_PROP_CHUNKS) * chunkWorldSize, 0.0f, (i / TERRAINBENCH_PROP_CHUNKS) * chunkWorldSize };
+            AppendPropBatch(&scatter, chunkProps[i], chunkPropCounts[i], origin);
+        }
+        gather = fmin(gather, GetBenchClock() - start);
+    }
+
+    int batches = 0;
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) batches += scatter.transformCounts[type] > 0;
+
+    printf("Scatter, %d props on %d chunks (%d trees, %d rocks, %d houses, %d cottages):\n", props, chunks,
+           typeCounts[PROP_TREE], typeCounts[PROP_ROCK], typeCounts[PROP_HOUSE], typeCounts[PROP_COTTAGE]);
+    printf("  placement %7.1f us per chunk, %5.1f ns per prop, %zu bytes per prop\n",
+           placement / chunks * 1e6, placement / props * 1e9, sizeof(PropInstance));
+    printf("  gather    %7.2f ms for all props, best of %d, %zu KiB of instance transforms\n",
+           gather * 1000.0, TERRAINBENCH_REPEATS, props * sizeof(Matrix) / 1024);
+    printf("  draws     %d prop types batched, one DrawMeshInstanced per mesh of each, against %d DrawModel calls one per prop\n", batches, props);
+
+    for (int i = 0; i < chunks; i++) RL_FREE(chunkProps[i]);
+    for (int type = 0; type < PROP_TYPE_COUNT; type++) RL_FREE(scatter.transforms[type]);
+    free(heights);
+    UnloadTerrain(&terrain);
+}
+
+// The colour pass once ran on every vertex of every chunk, the table moved it to the shader
+static void BenchColors(void) {
+    TerrainConfig config = GetDefaultTerrainConfig();
+    config.headless = true;
+    InitTerrainEx(&terrain, config);
+
+    double build = INFINITY;
+    for (int repeat = 0; repeat < TERRAINBENCH_REPEATS; repeat++) {
+        double start = GetBenchClock();
+        BuildTerrainColorLUT(terrain.colorLut, TERRAIN_COLOR_LUT_SIZE, config.colorStops, config.colorStopCount);
+        build = fmin(build, GetBenchClock() - start);
+    }
+
+    printf("Vertex colours per chunk, best of %d, building the %d entry table takes %.1f us once:\n",
+           TERRAINBENCH_REPEATS, TERRAIN_COLOR_LUT_SIZE, build * 1e6);
+    for (int size = 64; size <= 256; size *= 4) {
+        float *heights = (float *)malloc(sizeof(float) * size * size);
+        Color *colors = (Color *)malloc(sizeof(Color) * size * size);
+        GenerateTerrainHeightmap(&terrain, heights, size, terrain.tileScale, 0.0, 0.0);
+
+        float amplitude = terrain.heightPipeline.amplitude;
+        double baseline = INFINITY, table = INFINITY;
+        unsigned int checksum = 0;
+        for (int repeat = 0; repeat < TERRAINBENCH_REPEATS; repeat++) {
+            double start = GetBenchClock();
+            for (int i = 0; i < size * size; i++) colors[i] = GetBaselineTerrainColor((heights[i] + amplitude) / (2.0f * amplitude));
+            baseline = fmin(baseline, GetBenchClock() - start);
+            checksum += colors[size * size / 2].g;
+
+            start = GetBenchClock();
+            for (int i = 0; i < size * size; i++) colors[i] = GetTerrainColor(&terrain, heights[i]);
+            table = fmin(table, GetBenchClock() - start);
+            checksum += colors[size * size / 2].g;
+        }
+
+        printf("  %3dx%-3d ColorLerp branches %8.1f us, GetTerrainColor %8.1f us, %.2fx (checksum %u)\n",
+               size, size, baseline * 1e6, table * 1e6, baseline / table, checksum);
+
+        free(colors);
+        free(heights);
+    }
+
+    UnloadTerrain(&terrain);
+}
+
+// The gradient before the table, as terraintest keeps it
+static Color GetBaselineTerrainColor(float normalizedHeight) {
+    if (normalizedHeight < 0.2f) return ColorLerp(BLUE, BEIGE, normalizedHeight / 0.2f);
+    else if (normalizedHeight < 0.5f) return ColorLerp(BEIGE, GREEN, (normalizedHeight - 0.2f) / 0.3f);
+    else if (normalizedHeight < 0.8f) return ColorLerp(GREEN, DARKGRAY, (normalizedHeight - 0.5f) / 0.3f);
+    return ColorLerp(DARKGRAY, WHITE, (normalizedHeight - 0.8f) / 0.2f);
+}
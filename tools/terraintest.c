@@ -0,0 +1,325 @@
+// terraintest.c
+// Checks of the terrain module that need no window, exits non-zero if any fails.
+// Usage: terraintest
+//
+// Colour LUT: GetTerrainColor, which filters the gradient table the way the GPU samples its
+// texture, must stay within 1 LSB of the ColorLerp gradient GenerateTerrainMesh used to compute
+// per vertex, at every table entry and at TERRAIN_TEST_COLOR_STEPS heights between entries.
+//
+// Residency: a headless terrain follows a chase camera along a winding flight, rebasing its origin
+// on the way. Every TERRAIN_TEST_CHECK_FRAMES frames, every chunk the camera frustum touches must be
+// resident and at most MAX_CHUNKS chunks and CHUNK_CACHE_BUDGET cache bytes may be held. The same
+// flight with a view distance far beyond MAX_CHUNKS must keep the nearest chunks: no chunk in the
+// frustum may be missing while a farther one is resident.
+//
+// Floating origin: the same flight starting TERRAIN_TEST_FAR_START units out, where a float has a
+// step of one unit. Render-space positions must stay within a rebase of the origin and add back to
+// the double precision world position to TERRAIN_TEST_JITTER. Every vertex of every resident chunk
+// must read back through GetTerrainHeight as the height function at its world position. Hovering
+// afterwards must neither load nor drop a chunk.
+#include "raylib.h"
+#include "raymath.h"
+#include "Terrain/Terrain.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TERRAIN_TEST_COLOR_STEPS    16      // Heights tested per gradient table entry
+#define TERRAIN_TEST_COLOR_LSB      1       // Largest accepted difference per channel
+#define TERRAIN_TEST_FRAMES         3000    // Frames of the residency flight, fifty seconds at 60 Hz
+#define TERRAIN_TEST_CHECK_FRAMES   10      // Frames between residency checks
+#define TERRAIN_TEST_SPEED          300.0f  // Plane speed in units per second
+#define TERRAIN_TEST_ALTITUDE       150.0f  // Plane height above the origin
+#define TERRAIN_TEST_FAR_VIEW       3000.0f // View distance that needs far more than MAX_CHUNKS chunks
+#define TERRAIN_TEST_LATTICE        8       // Samples per chunk side when testing it against the frustum
+#define TERRAIN_TEST_FAR_START      1e7     // World distance of the floating origin flight
+#define TERRAIN_TEST_JITTER         1e-3    // Largest accepted render-space position error
+#define TERRAIN_TEST_HEIGHT_ERROR   1e-3f   // Largest accepted height read back error, float render positions round the bilinear weights
+#define TERRAIN_TEST_HOVER_FRAMES   120     // Frames hovered after the floating origin flight
+
+static TerrainManager terrain;  // Chunk arrays make it too big for the stack
+
+static int TestColorLUT(void);
+static int TestChunkResidency(float viewDistance, bool overBudget);
+static int TestFloatingOrigin(void);
+static void GetFlightCamera(int frame, double *worldX, double *worldZ, Vector3 *forward);
+static Camera GetChaseCamera(Vector3 plane, Vector3 forward);
+static bool IsChunkInFrustum(Matrix viewProjection, float chunkSize, float amplitude, float minX, float minZ);
+static Color GetBaselineTerrainColor(float normalizedHeight);
+static int GetColorDifference(Color a, Color b);
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        printf("Usage: terraintest\n");
+        return 1;
+    }
+
+    int failures = 0;
+    failures += TestColorLUT();
+    failures += TestChunkResidency(TERRAIN_VIEW_DISTANCE, false);
+    failures += TestChunkResidency(TERRAIN_TEST_FAR_VIEW, true);
+    failures += TestFloatingOrigin();
+
+    if (failures) {
+        printf("terraintest: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("terraintest: all checks passed\n");
+    return 0;
+}
+
+// Returns the number of failed checks
+static int TestColorLUT(void) {
+    TerrainConfig config = GetDefaultTerrainConfig();
+    terrain.heightPipeline = CompileHeightPipeline(config.height);
+    BuildTerrainColorLUT(terrain.colorLut, TERRAIN_COLOR_LUT_SIZE, config.colorStops, config.colorStopCount);
+
+    // The entries themselves
+    int worstEntry = 0;
+    for (int i = 0; i < TERRAIN_COLOR_LUT_SIZE; i++) {
+        int difference = GetColorDifference(terrain.colorLut[i], GetBaselineTerrainColor((float)i / (TERRAIN_COLOR_LUT_SIZE - 1)));
+        if (difference > worstEntry) worstEntry = difference;
+    }
+
+    // Heights between them, through the filtered lookup
+    float amplitude = terrain.heightPipeline.amplitude;
+    int steps = (TERRAIN_COLOR_LUT_SIZE - 1) * TERRAIN_TEST_COLOR_STEPS;
+    int worstHeight = 0;
+    float worstAt = 0.0f;
+    for (int step = 0; step <= steps; step++) {
+        float height = -amplitude + 2.0f * amplitude * (float)step / (float)steps;
+        float normalizedHeight = (height + amplitude) / (2.0f * amplitude);
+        int difference = GetColorDifference(GetTerrainColor(&terrain, height), GetBaselineTerrainColor(normalizedHeight));
+        if (difference > worstHeight) {
+            worstHeight = difference;
+            worstAt = normalizedHeight;
+        }
+    }
+
+    printf("Colour LUT: %d entries, worst entry %d LSB, worst of %d heights %d LSB (at %.4f)\n",
+           TERRAIN_COLOR_LUT_SIZE, worstEntry, steps + 1, worstHeight, worstAt);
+    return (worstEntry > TERRAIN_TEST_COLOR_LSB) + (worstHeight > TERRAIN_TEST_COLOR_LSB);
+}
+
+// Returns the number of failed checks
+static int TestChunkResidency(float viewDistance, bool overBudget) {
+    TerrainConfig config = GetDefaultTerrainConfig();
+    config.viewDistance = viewDistance;
+    config.headless = true;
+    InitTerrainEx(&terrain, config);
+
+    float chunkSize = (terrain.chunkSize - 1) * terrain.tileScale;
+    float amplitude = terrain.heightPipeline.amplitude;
+    float aspect = (float)SCREEN_ASPECT_WIDTH / SCREEN_ASPECT_HEIGHT;
+    int range = (int)ceilf(viewDistance / chunkSize) + 1;
+
+    int overBudgetFrames = 0, missingFrames = 0, fartherFrames = 0, checks = 0;
+    int mostResident = 0, mostMissing = 0;
+    bool *resident = (bool *)calloc((2 * range + 1) * (2 * range + 1), sizeof(bool));
+
+    for (int frame = 0; frame < TERRAIN_TEST_FRAMES; frame++) {
+        double worldX, worldZ;
+        Vector3 forward;
+        GetFlightCamera(frame, &worldX, &worldZ, &forward);
+
+        // Render space as the demo keeps it, rebased whenever the plane strays from the origin
+        Vector3 plane = { (float)(worldX - (double)terrain.originChunkX * chunkSize), TERRAIN_TEST_ALTITUDE,
+                          (float)(worldZ - (double)terrain.originChunkZ * chunkSize) };
+        plane = Vector3Subtract(plane, RebaseTerrainOrigin(&terrain, plane));
+
+        Camera camera = GetChaseCamera(plane, forward);
+        UpdateTerrain(&terrain, plane, forward, camera);
+
+        if (frame % TERRAIN_TEST_CHECK_FRAMES != 0) continue;
+        checks++;
+
+        // The frustum the terrain streams: corner rays end at the view distance, so the far plane passes through their ends
+        float tanY = tanf(camera.fovy * 0.5f * DEG2RAD);
+        float tanX = tanY * aspect;
+        float farPlane = viewDistance / sqrtf(1.0f + tanX * tanX + tanY * tanY);
+        Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+        Matrix viewProjection = MatrixMultiply(view, MatrixPerspective(camera.fovy * DEG2RAD, aspect, 0.1, farPlane));
+
+        if (terrain.chunkCount > MAX_CHUNKS || terrain.cache.bytesUsed > terrain.cache.byteBudget) overBudgetFrames++;
+        if (terrain.chunkCount > mostResident) mostResident = terrain.chunkCount;
+
+        // Chunk grid around the camera, relative to the origin chunk
+        int cameraX = (int)floorf(camera.position.x / chunkSize);
+        int cameraZ = (int)floorf(camera.position.z / chunkSize);
+        int side = 2 * range + 1;
+        for (int i = 0; i < side * side; i++) resident[i] = false;
+
+        float farthestResident = 0.0f;
+        for (int i = 0; i < terrain.chunkCount; i++) {
+            int x = terrain.chunks[i].chunkX - terrain.originChunkX - cameraX + range;
+            int z = terrain.chunks[i].chunkZ - terrain.originChunkZ - cameraZ + range;
+            if (x >= 0 && x < side && z >= 0 && z < side) resident[z * side + x] = true;
+
+            float dx = terrain.chunks[i].position.x + 0.5f * chunkSize - camera.position.x;
+            float dz = terrain.chunks[i].position.z + 0.5f * chunkSize - camera.position.z;
+            farthestResident = fmaxf(farthestResident, sqrtf(dx * dx + dz * dz));
+        }
+
+        int missing = 0;
+        float nearestMissing = INFINITY;
+        for (int z = 0; z < side; z++) {
+            for (int x = 0; x < side; x++) {
+                float minX = (cameraX + x - range) * chunkSize;
+                float minZ = (cameraZ + z - range) * chunkSize;
+                if (resident[z * side + x] || !IsChunkInFrustum(viewProjection, chunkSize, amplitude, minX, minZ)) continue;
+
+                float dx = minX + 0.5f * chunkSize - camera.position.x;
+                float dz = minZ + 0.5f * chunkSize - camera.position.z;
+                nearestMissing = fminf(nearestMissing, sqrtf(dx * dx + dz * dz));
+                missing++;
+            }
+        }
+        if (missing > mostMissing) mostMissing = missing;
+
+        // Within budget every visible chunk must be there, beyond it the farthest ones make way
+        if (!overBudget && missing > 0) missingFrames++;
+        if (overBudget && missing > 0 && nearestMissing < farthestResident - 1.0f) fartherFrames++;
+    }
+
+    printf("Residency, view distance %.0f: %d checks over %d frames, at most %d of %d chunks resident, at most %d in the frustum missing, %u evicted, cache %zu of %zu bytes\n",
+           viewDistance, checks, TERRAIN_TEST_FRAMES, mostResident, MAX_CHUNKS, mostMissing, terrain.chunksEvicted,
+           terrain.cache.bytesUsed, terrain.cache.byteBudget);
+    if (overBudgetFrames) printf("  FAILED: over budget at %d checks\n", overBudgetFrames);
+    if (missingFrames) printf("  FAILED: chunks in the frustum missing at %d checks\n", missingFrames);
+    if (fartherFrames) printf("  FAILED: a nearer chunk in the frustum missing while a farther one was resident at %d checks\n", fartherFrames);
+
+    free(resident);
+    UnloadTerrain(&terrain);
+    return (overBudgetFrames > 0) + (missingFrames > 0) + (fartherFrames > 0);
+}
+
+// Returns the number of failed checks
+static int TestFloatingOrigin(void) {
+    TerrainConfig config = GetDefaultTerrainConfig();
+    config.headless = true;
+    InitTerrainEx(&terrain, config);
+
+    int size = terrain.chunkSize;
+    float chunkSize = (size - 1) * terrain.tileScale;
+    double worstPosition = 0.0;
+    float farthestRender = 0.0f;
+    Vector3 plane = { 0 }, forward = { 0 };
+
+    for (int frame = 0; frame < TERRAIN_TEST_FRAMES; frame++) {
+        double worldX, worldZ;
+        GetFlightCamera(frame, &worldX, &worldZ, &forward);
+        worldX += TERRAIN_TEST_FAR_START;
+        worldZ += TERRAIN_TEST_FAR_START;
+
+        plane = (Vector3){ (float)(worldX - (double)terrain.originChunkX * chunkSize), TERRAIN_TEST_ALTITUDE,
+                           (float)(worldZ - (double)terrain.originChunkZ * chunkSize) };
+        plane = Vector3Subtract(plane, RebaseTerrainOrigin(&terrain, plane));
+        UpdateTerrain(&terrain, plane, forward, GetChaseCamera(plane, forward));
+
+        // The first frame rebases from ten million units out, the test starts after it
+        if (frame == 0) continue;
+        farthestRender = fmaxf(farthestRender, fmaxf(fabsf(plane.x), fabsf(plane.z)));
+        double errorX = fabs((double)terrain.originChunkX * chunkSize + plane.x - worldX);
+        double errorZ = fabs((double)terrain.originChunkZ * chunkSize + plane.z - worldZ);
+        worstPosition = fmax(worstPosition, fmax(errorX, errorZ));
+    }
+
+    // Resident vertices read back as the height function at their absolute position
+    float worstHeight = 0.0f;
+    for (int i = 0; i < terrain.chunkCount; i++) {
+        const TerrainChunk *chunk = &terrain.chunks[i];
+        for (int z = 0; z < size; z++) {
+            for (int x = 0; x < size; x++) {
+                double worldX = (double)chunk->chunkX * chunkSize + x * terrain.tileScale;
+                double worldZ = (double)chunk->chunkZ * chunkSize + z * terrain.tileScale;
+                float height = GetTerrainHeight(&terrain, chunk->position.x + x * terrain.tileScale, chunk->position.z + z * terrain.tileScale);
+                worstHeight = fmaxf(worstHeight, fabsf(height - EvaluateHeight(&terrain.heightPipeline, worldX, worldZ)));
+            }
+        }
+    }
+
+    // Hovering in place keeps exactly the same chunks
+    int residentBefore = terrain.chunkCount;
+    unsigned int generatedBefore = terrain.chunksGenerated;
+    unsigned int hitsBefore = terrain.cache.hits;
+    int changedFrames = 0;
+    for (int frame = 0; frame < TERRAIN_TEST_HOVER_FRAMES; frame++) {
+        UpdateTerrain(&terrain, plane, forward, GetChaseCamera(plane, forward));
+        if (terrain.chunkCount != residentBefore || terrain.chunksGenerated != generatedBefore || terrain.cache.hits != hitsBefore) changedFrames++;
+    }
+
+    bool drifted = farthestRender > TERRAIN_REBASE_DISTANCE + chunkSize || worstPosition > TERRAIN_TEST_JITTER;
+    printf("Floating origin at %.0e units: render positions within %.0f, worst position error %.2g, worst of %d heights %.2g off, %d of %d hover frames changed chunks\n",
+           TERRAIN_TEST_FAR_START, farthestRender, worstPosition, terrain.chunkCount * size * size, worstHeight, changedFrames, TERRAIN_TEST_HOVER_FRAMES);
+    if (drifted) printf("  FAILED: render-space positions drifted\n");
+    if (worstHeight > TERRAIN_TEST_HEIGHT_ERROR) printf("  FAILED: resident heights do not match their world position\n");
+    if (changedFrames) printf("  FAILED: chunks changed while hovering\n");
+
+    UnloadTerrain(&terrain);
+    return drifted + (worstHeight > TERRAIN_TEST_HEIGHT_ERROR) + (changedFrames > 0);
+}
+
+// A winding flight in absolute world coordinates, far enough to rebase the origin a few times
+static void GetFlightCamera(int frame, double *worldX, double *worldZ, Vector3 *forward) {
+    static double x = 0.0, z = 0.0;
+    if (frame == 0) x = z = 0.0;
+
+    float time = frame / 60.0f;
+    float heading = 0.6f * sinf(time * 0.15f) + 0.04f * time;
+    *forward = (Vector3){ sinf(heading), 0.0f, cosf(heading) };
+    x += forward->x * TERRAIN_TEST_SPEED / 60.0f;
+    z += forward->z * TERRAIN_TEST_SPEED / 60.0f;
+    *worldX = x;
+    *worldZ = z;
+}
+
+// Behind and above the plane like the demo, turned with the flight
+static Camera GetChaseCamera(Vector3 plane, Vector3 forward) {
+    Camera camera = { 0 };
+    camera.position = Vector3Add(plane, (Vector3){ -300.0f * forward.x, 100.0f, -300.0f * forward.z });
+    camera.target = plane;
+    camera.up = (Vector3){ 0.0f, 1.0f, 0.0f };
+    camera.fovy = 60.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    return camera;
+}
+
+// Points on a lattice through the chunk bounds, so bounds that only graze a frustum corner do not count
+static bool IsChunkInFrustum(Matrix viewProjection, float chunkSize, float amplitude, float minX, float minZ) {
+    Matrix m = viewProjection;
+
+    for (int i = 0; i <= TERRAIN_TEST_LATTICE; i++) {
+        for (int j = 0; j <= TERRAIN_TEST_LATTICE; j++) {
+            for (int k = 0; k <= 2; k++) {
+                float x = minX + chunkSize * i / TERRAIN_TEST_LATTICE;
+                float y = amplitude * (k - 1);
+                float z = minZ + chunkSize * j / TERRAIN_TEST_LATTICE;
+
+                float clipX = m.m0 * x + m.m4 * y + m.m8 * z + m.m12;
+                float clipY = m.m1 * x + m.m5 * y + m.m9 * z + m.m13;
+                float clipZ = m.m2 * x + m.m6 * y + m.m10 * z + m.m14;
+                float clipW = m.m3 * x + m.m7 * y + m.m11 * z + m.m15;
+                if (fabsf(clipX) <= clipW && fabsf(clipY) <= clipW && fabsf(clipZ) <= clipW) return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// The gradient GenerateTerrainMesh computed per vertex before the LUT
+static Color GetBaselineTerrainColor(float normalizedHeight) {
+    if (normalizedHeight < 0.2f) return ColorLerp(BLUE, BEIGE, normalizedHeight / 0.2f);
+    else if (normalizedHeight < 0.5f) return ColorLerp(BEIGE, GREEN, (normalizedHeight - 0.2f) / 0.3f);
+    else if (normalizedHeight < 0.8f) return ColorLerp(GREEN, DARKGRAY, (normalizedHeight - 0.5f) / 0.3f);
+    return ColorLerp(DARKGRAY, WHITE, (normalizedHeight - 0.8f) / 0.2f);
+}
+
+// Largest difference of any channel
+static int GetColorDifference(Color a, Color b) {
+    int difference = abs(a.r - b.r);
+    if (abs(a.g - b.g) > difference) difference = abs(a.g - b.g);
+    if (abs(a.b - b.b) > difference) difference = abs(a.b - b.b);
+    if (abs(a.a - b.a) > difference) difference = abs(a.a - b.a);
+    return difference;
+}
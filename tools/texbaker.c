@@ -0,0 +1,384 @@
+// texbaker.c
+// Offline converter from images to the baked .ftex format read by LoadBakedTexture.
+// Usage: texbaker [-f rgba|bc1|bc3] <output.ftex> <input> [more inputs]
+//
+// One input gives a plain texture, several are packed into an atlas with named regions
+// (the input file names without extension). Mip levels are box-filtered down to 1x1,
+// or down to the last level whose sides are multiples of 4 for the block formats.
+// Images are decoded with raylib's LoadImage, which needs no window.
+#include "raylib.h"
+#include "TextureFormat.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ATLAS_GUTTER 4      // Pixels of edge replication around each atlas region, keeps mips from bleeding
+
+typedef struct RgbaImage {
+    unsigned char *pixels;  // width * height RGBA
+    int width;
+    int height;
+} RgbaImage;
+
+static RgbaImage PackAtlas(Image *images, char (*names)[TEXTURE_FILE_NAME_SIZE], int count, TextureFileRegion *regions);
+static void CopyWithGutter(RgbaImage *atlas, const Image *image, int x, int y);
+static RgbaImage Downsample(const RgbaImage *source);
+static unsigned int EncodeLevel(const RgbaImage *level, unsigned int format, unsigned char *out);
+static void EncodeColorBlock(const unsigned char *block, unsigned char *out);
+static void EncodeAlphaBlock(const unsigned char *block, unsigned char *out);
+static unsigned short PackRgb565(int r, int g, int b);
+static void UnpackRgb565(unsigned short color, int *rgb);
+static int NextPowerOfTwo(int value);
+
+int main(int argc, char **argv) {
+    unsigned int format = TEXTURE_FILE_RGBA8;
+    int arg = 1;
+
+    if (arg + 1 < argc && strcmp(argv[arg], "-f") == 0) {
+        if (strcmp(argv[arg + 1], "bc1") == 0) format = TEXTURE_FILE_BC1;
+        else if (strcmp(argv[arg + 1], "bc3") == 0) format = TEXTURE_FILE_BC3;
+        else if (strcmp(argv[arg + 1], "rgba") != 0) arg = argc;
+        arg += 2;
+    }
+    if (argc - arg < 2) {
+        fprintf(stderr, "Usage: %s [-f rgba|bc1|bc3] <output.ftex> <input> [more inputs]\n", argv[0]);
+        return 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    const char *output = argv[arg++];
+    int count = argc - arg;
+
+    Image *images = (Image *)calloc(count, sizeof(Image));
+    char (*names)[TEXTURE_FILE_NAME_SIZE] = calloc(count, TEXTURE_FILE_NAME_SIZE);
+    long sourceBytes = 0;
+    long runtimeBytes = 0;
+
+    // This is the work LoadTexture repeats at every start, time it for the report
+    clock_t decodeStart = clock();
+    for (int i = 0; i < count; i++) {
+        images[i] = LoadImage(argv[arg + i]);
+        if (images[i].data == NULL) {
+            fprintf(stderr, "texbaker: cannot load %s\n", argv[arg + i]);
+            return 1;
+        }
+        ImageFormat(&images[i], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        snprintf(names[i], TEXTURE_FILE_NAME_SIZE, "%s", GetFileNameWithoutExt(argv[arg + i]));
+        sourceBytes += GetFileLength(argv[arg + i]);
+        runtimeBytes += (long)images[i].width * images[i].height * 4;
+    }
+    double decodeSeconds = (double)(clock() - decodeStart) / CLOCKS_PER_SEC;
+
+    RgbaImage base;
+    TextureFileRegion *regions = NULL;
+    int regionCount = 0;
+    if (count == 1) {
+        // Block formats need whole blocks, stretch to the next multiple of 4 (UVs are unaffected)
+        if (format != TEXTURE_FILE_RGBA8 && (images[0].width % 4 != 0 || images[0].height % 4 != 0)) {
+            ImageResize(&images[0], (images[0].width + 3) / 4 * 4, (images[0].height + 3) / 4 * 4);
+        }
+        base.width = images[0].width;
+        base.height = images[0].height;
+        base.pixels = (unsigned char *)malloc((size_t)base.width * base.height * 4);
+        memcpy(base.pixels, images[0].data, (size_t)base.width * base.height * 4);
+    } else {
+        regions = (TextureFileRegion *)calloc(count, sizeof(TextureFileRegion));
+        regionCount = count;
+        base = PackAtlas(images, names, count, regions);
+    }
+
+    // Mip chain, every level encoded straight after the previous one
+    size_t capacity = (size_t)base.width * base.height * 4 * 2;
+    unsigned char *data = (unsigned char *)malloc(capacity);
+    unsigned int dataSize = 0;
+    unsigned int mipmaps = 0;
+    RgbaImage level = base;
+    for (;;) {
+        dataSize += EncodeLevel(&level, format, data + dataSize);
+        mipmaps++;
+
+        if (level.width == 1 && level.height == 1) break;
+        int nextWidth = level.width > 1 ? level.width / 2 : 1;
+        int nextHeight = level.height > 1 ? level.height / 2 : 1;
+        if (format != TEXTURE_FILE_RGBA8 && (nextWidth % 4 != 0 || nextHeight % 4 != 0)) break;
+
+        RgbaImage next = Downsample(&level);
+        if (level.pixels != base.pixels) free(level.pixels);
+        level = next;
+    }
+    if (level.pixels != base.pixels) free(level.pixels);
+
+    TextureFileHeader header = { 0 };
+    header.magic = TEXTURE_FILE_MAGIC;
+    header.version = TEXTURE_FILE_VERSION;
+    header.width = (uint32_t)base.width;
+    header.height = (uint32_t)base.height;
+    header.mipmaps = mipmaps;
+    header.format = format;
+    header.regionCount = (uint32_t)regionCount;
+    header.dataOffset = (uint32_t)(sizeof(TextureFileHeader) + regionCount * sizeof(TextureFileRegion));
+    header.dataSize = dataSize;
+
+    FILE *file = fopen(output, "wb");
+    if (!file) {
+        fprintf(stderr, "texbaker: cannot write %s\n", output);
+        return 1;
+    }
+    fwrite(&header, sizeof(header), 1, file);
+    if (regionCount > 0) fwrite(regions, sizeof(TextureFileRegion), regionCount, file);
+    fwrite(data, 1, dataSize, file);
+    bool ok = ferror(file) == 0;
+    fclose(file);
+
+    static const char *formatNames[] = { "rgba", "bc1", "bc3" };
+    printf("texbaker: %d image(s) -> %s, %dx%d %s, %u mip levels\n", count, output, base.width, base.height, formatNames[format], mipmaps);
+    printf("  decode skipped at load: %.1f ms for %ld bytes of source images\n", decodeSeconds * 1000.0, sourceBytes);
+    printf("  VRAM: %ld bytes as LoadTexture (no mips), %u bytes baked with mips\n", runtimeBytes, dataSize);
+
+    for (int i = 0; i < count; i++) UnloadImage(images[i]);
+    free(images);
+    free(names);
+    free(regions);
+    free(base.pixels);
+    free(data);
+    return ok ? 0 : 1;
+}
+
+// Shelf packing by descending height into a power-of-two square-ish atlas
+static RgbaImage PackAtlas(Image *images, char (*names)[TEXTURE_FILE_NAME_SIZE], int count, TextureFileRegion *regions) {
+    int *order = (int *)malloc(count * sizeof(int));
+    long area = 0;
+    int widest = 0;
+    for (int i = 0; i < count; i++) {
+        order[i] = i;
+        area += (long)(images[i].width + 2 * ATLAS_GUTTER) * (images[i].height + 2 * ATLAS_GUTTER);
+        if (images[i].width + 2 * ATLAS_GUTTER > widest) widest = images[i].width + 2 * ATLAS_GUTTER;
+    }
+    for (int i = 1; i < count; i++) {
+        int key = order[i];
+        int j = i - 1;
+        while (j >= 0 && images[order[j]].height < images[key].height) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    int width = 4;
+    while ((long)width * width < area) width *= 2;
+    width = width > NextPowerOfTwo(widest) ? width : NextPowerOfTwo(widest);
+
+    int height;
+    for (;;) {
+        int x = 0, y = 0, shelf = 0;
+        for (int k = 0; k < count; k++) {
+            int i = order[k];
+            int w = images[i].width + 2 * ATLAS_GUTTER;
+            int h = images[i].height + 2 * ATLAS_GUTTER;
+            if (x + w > width) {
+                x = 0;
+                y += shelf;
+                shelf = 0;
+            }
+            regions[i].x = (uint32_t)(x + ATLAS_GUTTER);
+            regions[i].y = (uint32_t)(y + ATLAS_GUTTER);
+            x += w;
+            if (h > shelf) shelf = h;
+        }
+        height = NextPowerOfTwo(y + shelf);
+
+        // Prefer a wider atlas over a very tall one
+        if (height <= 2 * width) break;
+        width *= 2;
+    }
+
+    RgbaImage atlas = { (unsigned char *)calloc((size_t)width * height, 4), width, height };
+    for (int i = 0; i < count; i++) {
+        memcpy(regions[i].name, names[i], TEXTURE_FILE_NAME_SIZE);
+        regions[i].width = (uint32_t)images[i].width;
+        regions[i].height = (uint32_t)images[i].height;
+        CopyWithGutter(&atlas, &images[i], (int)regions[i].x, (int)regions[i].y);
+    }
+
+    free(order);
+    return atlas;
+}
+
+// Copy an image and repeat its border pixels into the gutter around it
+static void CopyWithGutter(RgbaImage *atlas, const Image *image, int x, int y) {
+    const unsigned char *source = (const unsigned char *)image->data;
+
+    for (int dy = -ATLAS_GUTTER; dy < image->height + ATLAS_GUTTER; dy++) {
+        int sy = dy < 0 ? 0 : (dy >= image->height ? image->height - 1 : dy);
+        for (int dx = -ATLAS_GUTTER; dx < image->width + ATLAS_GUTTER; dx++) {
+            int sx = dx < 0 ? 0 : (dx >= image->width ? image->width - 1 : dx);
+            memcpy(&atlas->pixels[((size_t)(y + dy) * atlas->width + x + dx) * 4], &source[((size_t)sy * image->width + sx) * 4], 4);
+        }
+    }
+}
+
+// 2x2 box filter, odd sizes reuse the last row or column
+static RgbaImage Downsample(const RgbaImage *source) {
+    RgbaImage result;
+    result.width = source->width > 1 ? source->width / 2 : 1;
+    result.height = source->height > 1 ? source->height / 2 : 1;
+    result.pixels = (unsigned char *)malloc((size_t)result.width * result.height * 4);
+
+    for (int y = 0; y < result.height; y++) {
+        int y0 = y * 2 < source->height ? y * 2 : source->height - 1;
+        int y1 = y * 2 + 1 < source->height ? y * 2 + 1 : y0;
+        for (int x = 0; x < result.width; x++) {
+            int x0 = x * 2 < source->width ? x * 2 : source->width - 1;
+            int x1 = x * 2 + 1 < source->width ? x * 2 + 1 : x0;
+            for (int c = 0; c < 4; c++) {
+                int sum = source->pixels[((size_t)y0 * source->width + x0) * 4 + c] + source->pixels[((size_t)y0 * source->width + x1) * 4 + c]
+                        + source->pixels[((size_t)y1 * source->width + x0) * 4 + c] + source->pixels[((size_t)y1 * source->width + x1) * 4 + c];
+                result.pixels[((size_t)y * result.width + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+
+    return result;
+}
+
+static unsigned int EncodeLevel(const RgbaImage *level, unsigned int format, unsigned char *out) {
+    unsigned int size = GetTextureFileLevelSize((uint32_t)level->width, (uint32_t)level->height, format);
+
+    if (format == TEXTURE_FILE_RGBA8) {
+        memcpy(out, level->pixels, size);
+        return size;
+    }
+
+    // Blocks in row order, pixels past the edge repeat the last row or column
+    unsigned char *cursor = out;
+    for (int by = 0; by < level->height; by += 4) {
+        for (int bx = 0; bx < level->width; bx += 4) {
+            unsigned char block[16 * 4];
+            for (int py = 0; py < 4; py++) {
+                int y = by + py < level->height ? by + py : level->height - 1;
+                for (int px = 0; px < 4; px++) {
+                    int x = bx + px < level->width ? bx + px : level->width - 1;
+                    memcpy(&block[(py * 4 + px) * 4], &level->pixels[((size_t)y * level->width + x) * 4], 4);
+                }
+            }
+
+            if (format == TEXTURE_FILE_BC3) {
+                EncodeAlphaBlock(block, cursor);
+                cursor += 8;
+            }
+            EncodeColorBlock(block, cursor);
+            cursor += 8;
+        }
+    }
+
+    return size;
+}
+
+static unsigned short PackRgb565(int r, int g, int b) {
+    return (unsigned short)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+static void UnpackRgb565(unsigned short color, int *rgb) {
+    int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// BC1 colour block: bounding box endpoints inset by 1/16, each pixel takes the nearest of four colours
+static void EncodeColorBlock(const unsigned char *block, unsigned char *out) {
+    int minColor[3] = { 255, 255, 255 }, maxColor[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++) {
+            if (block[i * 4 + c] < minColor[c]) minColor[c] = block[i * 4 + c];
+            if (block[i * 4 + c] > maxColor[c]) maxColor[c] = block[i * 4 + c];
+        }
+    }
+    for (int c = 0; c < 3; c++) {
+        int inset = (maxColor[c] - minColor[c]) >> 4;
+        minColor[c] += inset;
+        maxColor[c] -= inset;
+    }
+
+    unsigned short color0 = PackRgb565(maxColor[0], maxColor[1], maxColor[2]);
+    unsigned short color1 = PackRgb565(minColor[0], minColor[1], minColor[2]);
+    if (color0 < color1) {
+        unsigned short swap = color0;
+        color0 = color1;
+        color1 = swap;
+    }
+
+    // color0 > color1 selects the four-colour mode, equal endpoints leave every index at 0
+    unsigned int indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        UnpackRgb565(color0, palette[0]);
+        UnpackRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDistance = 1 << 30;
+            for (int p = 0; p < 4; p++) {
+                int distance = 0;
+                for (int c = 0; c < 3; c++) {
+                    int d = block[i * 4 + c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (unsigned int)best << (i * 2);
+        }
+    }
+
+    out[0] = (unsigned char)(color0 & 0xFF);
+    out[1] = (unsigned char)(color0 >> 8);
+    out[2] = (unsigned char)(color1 & 0xFF);
+    out[3] = (unsigned char)(color1 >> 8);
+    for (int b = 0; b < 4; b++) out[4 + b] = (unsigned char)(indices >> (b * 8));
+}
+
+// BC3 alpha block: min/max endpoints in the eight-value mode, 3-bit indices
+static void EncodeAlphaBlock(const unsigned char *block, unsigned char *out) {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; i++) {
+        if (block[i * 4 + 3] < minAlpha) minAlpha = block[i * 4 + 3];
+        if (block[i * 4 + 3] > maxAlpha) maxAlpha = block[i * 4 + 3];
+    }
+
+    unsigned long long indices = 0;
+    if (maxAlpha != minAlpha) {
+        int palette[8];
+        palette[0] = maxAlpha;
+        palette[1] = minAlpha;
+        for (int p = 1; p < 7; p++) palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+
+        for (int i = 0; i < 16; i++) {
+            int best = 0, bestDistance = 256;
+            for (int p = 0; p < 8; p++) {
+                int distance = abs(block[i * 4 + 3] - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= (unsigned long long)best << (i * 3);
+        }
+    }
+
+    out[0] = (unsigned char)maxAlpha;
+    out[1] = (unsigned char)minAlpha;
+    for (int b = 0; b < 6; b++) out[2 + b] = (unsigned char)(indices >> (b * 8));
+}
+
+static int NextPowerOfTwo(int value) {
+    int result = 1;
+    while (result < value) result *= 2;
+    return result;
+}
@@ -0,0 +1,87 @@
+// transformbench.c
+// UpdateTransforms on TRANSFORMBENCH_NODES nodes shaped as one deep chain and as one wide fan, with
+// the root moved, a leaf moved and nothing moved.
+// Usage: transformbench [-updates N]
+//
+// The chain is as deep as a hierarchy gets and the fan as wide. A root move rebuilds every node of
+// either, which is what every update cost before dirty propagation. A leaf move rebuilds one and
+// an idle update none, what is left is the pass over the flags. Each moving update shifts the node
+// between two positions so every timed update is a real change.
+#include "BenchClock.h"
+#include "raylib.h"
+#include "TransformHierarchy.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRANSFORMBENCH_NODES    10000       // Nodes per hierarchy
+#define TRANSFORMBENCH_UPDATES  200         // Default updates timed per case
+
+typedef enum BenchShape { SHAPE_CHAIN = 0, SHAPE_FAN, SHAPE_COUNT } BenchShape;
+typedef enum BenchMove { MOVE_ROOT = 0, MOVE_LEAF, MOVE_NONE, MOVE_COUNT } BenchMove;
+
+static void BuildHierarchy(TransformHierarchy *hierarchy, BenchShape shape);
+static double TimeUpdates(TransformHierarchy *hierarchy, BenchMove move, int updates, int *rebuilt);
+
+int main(int argc, char **argv) {
+    int updates = TRANSFORMBENCH_UPDATES;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-updates") == 0 && i + 1 < argc) updates = atoi(argv[++i]);
+        else {
+            printf("Usage: transformbench [-updates N]\n");
+            return 1;
+        }
+    }
+    if (updates < 1) updates = 1;
+
+    const char *shapes[SHAPE_COUNT] = { "chain", "fan" };
+    const char *moves[MOVE_COUNT] = { "root moved", "leaf moved", "idle" };
+    printf("Transform hierarchies of %d nodes, mean of %d updates:\n", TRANSFORMBENCH_NODES, updates);
+    for (int shape = 0; shape < SHAPE_COUNT; shape++) {
+        TransformHierarchy hierarchy;
+        BuildHierarchy(&hierarchy, shape);
+
+        for (int move = 0; move < MOVE_COUNT; move++) {
+            int rebuilt = 0;
+            double seconds = TimeUpdates(&hierarchy, move, updates, &rebuilt);
+            printf("  %-5s %-10s: %5d rebuilt, %9.2f us per update, %6.1f ns per node\n", shapes[shape], moves[move],
+                   rebuilt, seconds * 1e6, seconds * 1e9 / TRANSFORMBENCH_NODES);
+        }
+
+        UnloadTransformHierarchy(&hierarchy);
+    }
+
+    return 0;
+}
+
+// Every node under the previous one, or every node under the root
+static void BuildHierarchy(TransformHierarchy *hierarchy, BenchShape shape) {
+    Quaternion tilt = QuaternionFromAxisAngle((Vector3){ 0.0f, 1.0f, 0.0f }, 0.01f);
+
+    InitTransformHierarchy(hierarchy);
+    AddTransform(hierarchy, TRANSFORM_NO_PARENT, (Vector3){ 0.0f, 0.0f, 0.0f }, tilt, 1.0f);
+    for (int i = 1; i < TRANSFORMBENCH_NODES; i++) {
+        int parent = shape == SHAPE_CHAIN ? i - 1 : 0;
+        AddTransform(hierarchy, parent, (Vector3){ 0.0f, 0.0f, 1.0f }, tilt, 1.0f);
+    }
+    UpdateTransforms(hierarchy);
+}
+
+// Seconds per move and UpdateTransforms, the moves are inside the timing as the game makes them
+static double TimeUpdates(TransformHierarchy *hierarchy, BenchMove move, int updates, int *rebuilt) {
+    int node = move == MOVE_ROOT ? 0 : hierarchy->count - 1;
+    Quaternion rotation = hierarchy->localRotation[node];
+    Vector3 position = hierarchy->localPosition[node];
+
+    double start = GetBenchClock();
+    for (int update = 0; update < updates; update++) {
+        if (move != MOVE_NONE) {
+            Vector3 moved = { position.x + (float)(update & 1), position.y, position.z };
+            SetTransformLocal(hierarchy, node, moved, rotation);
+        }
+        *rebuilt = UpdateTransforms(hierarchy);
+    }
+    return (GetBenchClock() - start) / updates;
+}
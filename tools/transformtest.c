@@ -0,0 +1,124 @@
+// transformtest.c
+// Checks dirty propagation of the transform hierarchy, exits non-zero if any fails.
+// Usage: transformtest
+//
+// A root with a child and grandchild, a sibling of the child and an unrelated root with a child.
+// Each step changes one node, or sets one to the values it already has, then checks two things.
+// UpdateTransforms must rebuild exactly the changed node and everything under it. Every world
+// matrix must equal scale, rotation and translation composed up the parent chain from scratch.
+// A TRANSFORMTEST_DEPTH deep chain then checks that a root move reaches the last node.
+#include "raylib.h"
+#include "TransformHierarchy.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdio.h>
+
+#define TRANSFORMTEST_DEPTH     64          // Nodes in the deep chain
+#define TRANSFORMTEST_EPSILON   1e-4f       // Largest accepted difference of a matrix element
+
+enum { ROOT, CHILD, GRANDCHILD, SIBLING, OTHER_ROOT, OTHER_CHILD, NODE_COUNT };
+
+static int CheckUpdate(TransformHierarchy *hierarchy, const char *step, int expectedRebuilt);
+static Matrix GetReferenceWorld(const TransformHierarchy *hierarchy, int node);
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        printf("Usage: transformtest\n");
+        return 1;
+    }
+
+    TransformHierarchy hierarchy;
+    InitTransformHierarchy(&hierarchy);
+    Quaternion identity = { 0.0f, 0.0f, 0.0f, 1.0f };
+    Quaternion quarterTurn = QuaternionFromAxisAngle((Vector3){ 0.0f, 1.0f, 0.0f }, 0.5f * PI);
+
+    AddTransform(&hierarchy, TRANSFORM_NO_PARENT, (Vector3){ 10.0f, 0.0f, 0.0f }, identity, 1.0f);
+    AddTransform(&hierarchy, ROOT, (Vector3){ 0.0f, 0.0f, 5.0f }, identity, 1.0f);
+    AddTransform(&hierarchy, CHILD, (Vector3){ 0.0f, 2.0f, 3.0f }, identity, 1.0f);
+    AddTransform(&hierarchy, ROOT, (Vector3){ -4.0f, 0.0f, 0.0f }, identity, 1.0f);
+    AddTransform(&hierarchy, TRANSFORM_NO_PARENT, (Vector3){ 0.0f, 0.0f, -20.0f }, identity, 1.0f);
+    AddTransform(&hierarchy, OTHER_ROOT, (Vector3){ 1.0f, 1.0f, 1.0f }, identity, 1.0f);
+
+    int failures = 0;
+    failures += CheckUpdate(&hierarchy, "first update", NODE_COUNT);
+    failures += CheckUpdate(&hierarchy, "nothing changed", 0);
+
+    // Turning the root swings the child and grandchild around it
+    SetTransformLocal(&hierarchy, ROOT, (Vector3){ 10.0f, 0.0f, 0.0f }, quarterTurn);
+    failures += CheckUpdate(&hierarchy, "root turned", 4);
+
+    Vector3 grandchild = GetTransformPosition(&hierarchy, GRANDCHILD);
+    if (fabsf(grandchild.x - 18.0f) > TRANSFORMTEST_EPSILON || fabsf(grandchild.y - 2.0f) > TRANSFORMTEST_EPSILON || fabsf(grandchild.z) > TRANSFORMTEST_EPSILON) {
+        printf("  FAILED: grandchild at (%.4f, %.4f, %.4f), expected (18, 2, 0)\n", grandchild.x, grandchild.y, grandchild.z);
+        failures++;
+    }
+
+    SetTransformLocal(&hierarchy, ROOT, (Vector3){ 10.0f, 0.0f, 0.0f }, quarterTurn);
+    failures += CheckUpdate(&hierarchy, "root set to the same values", 0);
+
+    SetTransformScale(&hierarchy, CHILD, 2.0f);
+    failures += CheckUpdate(&hierarchy, "child scaled", 2);
+
+    SetTransformLocal(&hierarchy, GRANDCHILD, (Vector3){ 1.0f, 2.0f, 3.0f }, identity);
+    failures += CheckUpdate(&hierarchy, "grandchild moved", 1);
+
+    SetTransformLocal(&hierarchy, OTHER_ROOT, (Vector3){ 0.0f, 5.0f, -20.0f }, quarterTurn);
+    failures += CheckUpdate(&hierarchy, "other root moved", 2);
+
+    // Two changes in one pass, the grandchild is rebuilt once
+    SetTransformScale(&hierarchy, ROOT, 0.5f);
+    SetTransformLocal(&hierarchy, GRANDCHILD, (Vector3){ 0.0f, 0.0f, 1.0f }, quarterTurn);
+    failures += CheckUpdate(&hierarchy, "root and grandchild changed", 4);
+
+    // A long chain, each link turned and offset from its parent
+    int previous = TRANSFORM_NO_PARENT;
+    Quaternion link = QuaternionFromAxisAngle(Vector3Normalize((Vector3){ 1.0f, 2.0f, 3.0f }), 0.1f);
+    for (int i = 0; i < TRANSFORMTEST_DEPTH; i++) previous = AddTransform(&hierarchy, previous, (Vector3){ 0.0f, 0.0f, 1.0f }, link, 1.0f);
+    failures += CheckUpdate(&hierarchy, "chain added", TRANSFORMTEST_DEPTH);
+
+    int chainRoot = NODE_COUNT;
+    SetTransformLocal(&hierarchy, chainRoot, (Vector3){ 100.0f, 0.0f, 0.0f }, link);
+    failures += CheckUpdate(&hierarchy, "chain root moved", TRANSFORMTEST_DEPTH);
+
+    UnloadTransformHierarchy(&hierarchy);
+
+    if (failures) {
+        printf("transformtest: %d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("transformtest: all checks passed\n");
+    return 0;
+}
+
+// Returns 1 if the update rebuilt the wrong number of nodes or any world matrix is off
+static int CheckUpdate(TransformHierarchy *hierarchy, const char *step, int expectedRebuilt) {
+    int rebuilt = UpdateTransforms(hierarchy);
+
+    float worst = 0.0f;
+    for (int node = 0; node < hierarchy->count; node++) {
+        Matrix world = GetTransformWorld(hierarchy, node);
+        Matrix reference = GetReferenceWorld(hierarchy, node);
+        const float *a = &world.m0, *b = &reference.m0;
+        for (int i = 0; i < 16; i++) worst = fmaxf(worst, fabsf(a[i] - b[i]));
+    }
+
+    bool failed = rebuilt != expectedRebuilt || worst > TRANSFORMTEST_EPSILON;
+    printf("%-28s rebuilt %2d of %2d (expected %2d), worst element %.2g\n", step, rebuilt, hierarchy->count, expectedRebuilt, worst);
+    if (failed) printf("  FAILED: %s\n", rebuilt != expectedRebuilt ? "wrong nodes rebuilt" : "world matrix does not match its parent chain");
+    return failed;
+}
+
+// Scale, rotation and translation of every node up to the root, without any cached world
+static Matrix GetReferenceWorld(const TransformHierarchy *hierarchy, int node) {
+    Matrix world = MatrixIdentity();
+
+    for (; node != TRANSFORM_NO_PARENT; node = hierarchy->parent[node]) {
+        float scale = hierarchy->localScale[node];
+        Vector3 position = hierarchy->localPosition[node];
+        Matrix local = MatrixMultiply(MatrixMultiply(MatrixScale(scale, scale, scale), QuaternionToMatrix(hierarchy->localRotation[node])),
+                                      MatrixTranslate(position.x, position.y, position.z));
+        world = MatrixMultiply(world, local);
+    }
+
+    return world;
+}
@@ -0,0 +1,82 @@
+// worldcheck.c
+// Checks this build generates the default world bit for bit, exits non-zero on any mismatch.
+// Usage: worldcheck
+//
+// Clients and the server each generate terrain from the world descriptor, so a compiler, flag
+// or C library that rounds one height differently splits the world. The probe chunks hashed into
+// the descriptor's checksum are compared one by one against hashes measured on the reference
+// build, so a failure names the chunks that moved. After an intended change to the height
+// function, bump WORLD_DESCRIPTOR_VERSION and measure the table again with this tool's output.
+#include "Terrain/Terrain.h"
+#include "Terrain/WorldDescriptor.h"
+#include <stdio.h>
+
+#define WORLD_GOLDEN_CHECKSUM   0xabd19ba5u    // Of the whole default world, as MakeWorldDescriptor computes it
+
+typedef struct GoldenChunk {
+    int chunkX;
+    int chunkZ;
+    unsigned int checksum;      // GetChunkHeightChecksum of the default height pipeline
+} GoldenChunk;
+
+// Default height pipeline with CHUNK_SIZE 64 and TILE_SCALE 3.0f
+static const GoldenChunk goldenChunks[] = {
+    { -1, -1, 0x8df5843bu },
+    {  0, -1, 0x3f676050u },
+    {  1, -1, 0xe0dd0078u },
+    { -1,  0, 0xed29cc7fu },
+    {  0,  0, 0x1a7a04bcu },
+    {  1,  0, 0x33d5252fu },
+    { -1,  1, 0x83b89469u },
+    {  0,  1, 0x2e439424u },
+    {  1,  1, 0xe0ccdef0u },
+};
+
+#define GOLDEN_CHUNK_COUNT ((int)(sizeof(goldenChunks) / sizeof(goldenChunks[0])))
+
+int main(int argc, char **argv) {
+    if (argc > 1) {
+        printf("Usage: worldcheck\n");
+        return 1;
+    }
+
+    if (CHUNK_SIZE != 64 || TILE_SCALE != 3.0f || WORLD_PROBE_RADIUS != 1 || WORLD_DESCRIPTOR_VERSION != 1) {
+        printf("worldcheck: golden hashes are for version 1, CHUNK_SIZE 64, TILE_SCALE 3.0 and probe radius 1, measure them again\n");
+        return 1;
+    }
+
+    HeightPipelineDesc height = GetDefaultHeightPipelineDesc();
+    HeightPipeline pipeline = CompileHeightPipeline(height);
+    int mismatches = 0;
+
+    for (int i = 0; i < GOLDEN_CHUNK_COUNT; i++) {
+        const GoldenChunk *golden = &goldenChunks[i];
+        unsigned int checksum = GetChunkHeightChecksum(&pipeline, CHUNK_SIZE, TILE_SCALE, golden->chunkX, golden->chunkZ);
+        if (checksum != golden->checksum) {
+            printf("chunk (%2d, %2d): %08x, expected %08x\n", golden->chunkX, golden->chunkZ, checksum, golden->checksum);
+            mismatches++;
+        }
+    }
+
+    // The descriptor combines the same chunks, and must survive the trip through the wire format
+    WorldDescriptor world = MakeWorldDescriptor(height, CHUNK_SIZE, TILE_SCALE);
+    if (world.checksum != WORLD_GOLDEN_CHECKSUM) {
+        printf("world checksum %08x, expected %08x\n", world.checksum, WORLD_GOLDEN_CHECKSUM);
+        mismatches++;
+    }
+
+    unsigned char bytes[WORLD_DESCRIPTOR_BYTES];
+    WorldDescriptor received;
+    int size = WriteWorldDescriptor(&world, bytes);
+    if (!ReadWorldDescriptor(&received, bytes, size) || received.checksum != world.checksum || !VerifyWorldDescriptor(&received)) {
+        printf("world descriptor does not verify after serialization\n");
+        mismatches++;
+    }
+
+    if (mismatches) {
+        printf("worldcheck: %d mismatch(es), this build generates a different world than the reference\n", mismatches);
+        return 1;
+    }
+    printf("worldcheck: %d probe chunks and world checksum %08x match\n", GOLDEN_CHUNK_COUNT, world.checksum);
+    return 0;
+}